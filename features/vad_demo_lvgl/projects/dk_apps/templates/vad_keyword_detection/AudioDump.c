@@ -0,0 +1,171 @@
+/**
+ ****************************************************************************************
+ *
+ * @file AudioDump.c
+ *
+ * @brief Asynchronous dump of the recorded frames over the console UART
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+#include "include/base_types.h"
+#include "include/Convert2TransferBuffer.h"
+#include "Util/FrameQueue.h"
+#include "AudioDump.h"
+#include "osal.h"
+#include "hw_gpio.h"
+#include "hw_sys.h"
+
+#if AUDIO_DUMP_EN
+
+#define DUMP_FRAME_SAMPLE               480                     // Same frame as the recognition, 30ms at 16KHz
+#define DUMP_FRAME_SIZE                 (DUMP_FRAME_SAMPLE * 2)
+#define DUMP_GROUP_SIZE                 5                       // Four data bytes and a checksum
+#define DUMP_HEADER_SIZE                DUMP_GROUP_SIZE         // 'V', 'D' and the 16 bit sequence number
+#define DUMP_BUFFER_SIZE                (DUMP_HEADER_SIZE + DUMP_FRAME_SIZE * DUMP_GROUP_SIZE / 4)
+
+#if (AUDIO_DUMP_BUFFERS < 2) || (AUDIO_DUMP_BUFFERS & (AUDIO_DUMP_BUFFERS - 1))
+#error "AUDIO_DUMP_BUFFERS must be a power of two, at least 2"
+#endif
+
+static const uart_config g_DumpUartConfig = {
+        .baud_rate              = AUDIO_DUMP_BAUDRATE,
+        .data                   = HW_UART_DATABITS_8,
+        .parity                 = HW_UART_PARITY_NONE,
+        .stop                   = HW_UART_STOPBITS_1,
+        .auto_flow_control      = 0,
+        .use_fifo               = 1,
+        .use_dma                = 1,                            // The frames are sent by the DMA
+        .tx_dma_channel         = HW_DMA_CHANNEL_3,             // Channel 1 records the microphone
+        .rx_dma_channel         = HW_DMA_CHANNEL_2,
+};
+
+static uint8_t g_byaDumpBuffer[AUDIO_DUMP_BUFFERS][DUMP_BUFFER_SIZE];
+
+// Buffers waiting to be sent, the oldest one is on the UART. Filled by the recognition task, emptied by the
+// UART interrupt.
+static FrameQueue g_DumpQueue;
+static uint32_t g_naDumpEntries[AUDIO_DUMP_BUFFERS];
+static int g_nNextBuffer;
+
+static volatile bool g_bSending;
+static bool g_bUartOpen;                        // Recognition task only
+static uint16_t g_nFrameSeq;                    // Dropped frames included, so that the host sees the gaps
+static uint32_t g_nDropCount;
+
+static void DumpSendDone(void *user_data, uint16_t written);
+
+/* Called with the interrupts masked, or from the UART interrupt */
+static void DumpSendNext(void)
+{
+        int nBuffer = FrameQueuePeek(&g_DumpQueue);
+
+        if (nBuffer < 0) {
+                g_bSending = false;
+                return;
+        }
+
+        g_bSending = true;
+        hw_uart_send(AUDIO_UART, g_byaDumpBuffer[nBuffer], DUMP_BUFFER_SIZE, DumpSendDone, NULL);
+}
+
+static void DumpSendDone(void *user_data, uint16_t written)
+{
+        FrameQueueRelease(&g_DumpQueue);
+        DumpSendNext();
+}
+
+static void DumpWriteHeader(uint8_t *lpbyHeader, uint16_t nSeq)
+{
+        lpbyHeader[0] = 'V';
+        lpbyHeader[1] = 'D';
+        lpbyHeader[2] = nSeq & 0xFF;
+        lpbyHeader[3] = nSeq >> 8;
+        lpbyHeader[4] = ~(lpbyHeader[0] ^ lpbyHeader[1] ^ lpbyHeader[2] ^ lpbyHeader[3]);
+}
+
+void AudioDumpInit(void)
+{
+        FrameQueueInit(&g_DumpQueue, g_naDumpEntries, AUDIO_DUMP_BUFFERS);
+        g_nNextBuffer = 0;
+        g_bSending = false;
+        g_bUartOpen = false;
+        g_nFrameSeq = 0;
+        g_nDropCount = 0;
+}
+
+bool AudioDumpPut(const int16_t *lpsSample, int nNumSample)
+{
+        uint8_t *lpbyBuffer = g_byaDumpBuffer[g_nNextBuffer];
+        uint16_t nSeq = g_nFrameSeq++;
+
+        if (nNumSample != DUMP_FRAME_SAMPLE || FrameQueueGetCount(&g_DumpQueue) == AUDIO_DUMP_BUFFERS) {
+                g_nDropCount++;
+                return false;
+        }
+
+        // The UART and its pad are released while the system may sleep, see AudioDumpFlush()
+        if (!g_bUartOpen) {
+                hw_sys_pd_com_enable();
+                hw_uart_init(AUDIO_UART, &g_DumpUartConfig);
+                hw_gpio_pad_latch_enable(AUDIO_UART_TX_PIN);
+                g_bUartOpen = true;
+        }
+
+        // Buffers are sent in order, the next one is free while the queue is not full
+        DumpWriteHeader(lpbyBuffer, nSeq);
+        Convert2TransferBuffer((const BYTE *)lpsSample, DUMP_FRAME_SIZE, lpbyBuffer + DUMP_HEADER_SIZE,
+                               DUMP_BUFFER_SIZE - DUMP_HEADER_SIZE, eFourByteDataOneChecksum);
+        FrameQueuePut(&g_DumpQueue, g_nNextBuffer);
+        g_nNextBuffer = (g_nNextBuffer + 1) & (AUDIO_DUMP_BUFFERS - 1);
+
+        OS_ENTER_CRITICAL_SECTION();
+        if (!g_bSending)
+                DumpSendNext();
+        OS_LEAVE_CRITICAL_SECTION();
+
+        return true;
+}
+
+void AudioDumpFlush(void)
+{
+        if (!g_bUartOpen)
+                return;
+
+        // At most AUDIO_DUMP_BUFFERS frames of 13ms
+        while (g_bSending)
+                OS_DELAY(1);
+
+        while (hw_uart_is_busy(AUDIO_UART))
+                __NOP();
+
+        hw_gpio_pad_latch_disable(AUDIO_UART_TX_PIN);
+        hw_sys_pd_com_disable();
+        g_bUartOpen = false;
+}
+
+uint32_t AudioDumpGetDropCount(void)
+{
+        return g_nDropCount;
+}
+
+#endif /* AUDIO_DUMP_EN */
@@ -0,0 +1,70 @@
+/**
+ ****************************************************************************************
+ *
+ * @file AudioDump.h
+ *
+ * @brief Asynchronous dump of the recorded frames over the console UART
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#ifndef AUDIO_DUMP_H_
+#define AUDIO_DUMP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "periph_setup.h"
+#include "hw_uart.h"
+
+// The frames fed to DSpotter are sent to AUDIO_UART (see periph_setup.h), apart from the console. Each frame
+// is a header with its sequence number and the samples, in the format of Convert2TransferBuffer() with a
+// checksum per four bytes. tools/dump2wav.py turns a capture of the stream back into a WAV file.
+#if defined(SUPPORT_UART_DUMP_RECORD)
+#define AUDIO_DUMP_EN                   1
+#else
+#define AUDIO_DUMP_EN                   0
+#endif
+
+// A frame takes 13ms of the 30ms frame period at 921600 baud
+#ifndef AUDIO_DUMP_BAUDRATE
+#define AUDIO_DUMP_BAUDRATE             HW_UART_BAUDRATE_921600
+#endif
+
+// Transfer buffers, a power of two. Two buffers are enough for the live audio, the pre-roll is replayed in a
+// burst on wake-up and needs one per frame.
+#ifndef AUDIO_DUMP_BUFFERS
+#define AUDIO_DUMP_BUFFERS              16
+#endif
+
+#if AUDIO_DUMP_EN
+void AudioDumpInit(void);
+
+/* Queues a copy of the frame and returns at once. The frame is dropped if all the buffers are in use */
+bool AudioDumpPut(const int16_t *lpsSample, int nNumSample);
+
+/* Waits until the queued frames are sent and releases the UART, e.g. before the system may sleep */
+void AudioDumpFlush(void);
+
+/* Frames dropped since AudioDumpInit() */
+uint32_t AudioDumpGetDropCount(void);
+#endif
+
+#endif /* AUDIO_DUMP_H_ */
@@ -0,0 +1,242 @@
+/**
+ ****************************************************************************************
+ *
+ * @file AudioFrontEnd.c
+ *
+ * @brief Fixed-point conditioning of the recorded frames ahead of the recognition
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+#include <string.h>
+#include "AudioFrontEnd.h"
+
+// tools/AudioFrontEnd_test.c defines AUDIO_FE_USE_DSP with host versions of the intrinsics
+#if !defined(AUDIO_FE_USE_DSP) && defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#include "cmsis_gcc.h"
+#define AUDIO_FE_USE_DSP
+#endif
+
+#define HPF_COEF_Q15                    32604                   // 0.995, pole of the high-pass filter
+
+typedef struct {
+        int32_t nPrevIn;
+        int32_t nPrevOut;
+        bool bStarted;
+} HpfState;
+
+typedef struct {
+        uint32_t nNoiseFloor;
+        int nHangover;
+} GateState;
+
+typedef struct {
+        int32_t nGainQ16;
+} AgcState;
+
+#if AUDIO_FE_HPF
+static HpfState g_HpfState;
+#endif
+#if AUDIO_FE_GATE
+static GateState g_GateState;
+#endif
+#if AUDIO_FE_AGC
+static AgcState g_AgcState;
+#endif
+
+static int16_t Saturate16(int32_t nValue)
+{
+#ifdef AUDIO_FE_USE_DSP
+        return __SSAT(nValue, 16);
+#else
+        return nValue > INT16_MAX ? INT16_MAX : nValue < INT16_MIN ? INT16_MIN : nValue;
+#endif
+}
+
+/* Mean square of the samples */
+static uint32_t FrameEnergy(const int16_t *lpsSample, int nNumSample)
+{
+        int64_t nSum = 0;
+        int i = 0;
+
+#ifdef AUDIO_FE_USE_DSP
+        // Two samples per multiply-accumulate
+        for (; i + 1 < nNumSample; i += 2) {
+                uint32_t nPair;
+
+                memcpy(&nPair, &lpsSample[i], sizeof(nPair));
+                nSum = __SMLALD(nPair, nPair, nSum);
+        }
+#endif
+        for (; i < nNumSample; i++)
+                nSum += (int32_t)lpsSample[i] * lpsSample[i];
+
+        return nSum / nNumSample;
+}
+
+static int32_t FramePeak(const int16_t *lpsSample, int nNumSample)
+{
+        int32_t nPeak = 0;
+
+        for (int i = 0; i < nNumSample; i++) {
+                int32_t nAbs = lpsSample[i] < 0 ? -lpsSample[i] : lpsSample[i];
+
+                if (nAbs > nPeak)
+                        nPeak = nAbs;
+        }
+        return nPeak;
+}
+
+/* Multiplies the samples by a Q16 gain, with saturation */
+static void FrameScale(int16_t *lpsSample, int nNumSample, int32_t nGainQ16)
+{
+        int i = 0;
+
+#ifdef AUDIO_FE_USE_DSP
+        // Two samples per iteration, (gain * sample) >> 16 of the bottom and the top half
+        for (; i + 1 < nNumSample; i += 2) {
+                uint32_t nPair;
+
+                memcpy(&nPair, &lpsSample[i], sizeof(nPair));
+                nPair = __PKHBT(__SSAT(__SMULWB(nGainQ16, nPair), 16), __SSAT(__SMULWT(nGainQ16, nPair), 16), 16);
+                memcpy(&lpsSample[i], &nPair, sizeof(nPair));
+        }
+#endif
+        for (; i < nNumSample; i++)
+                lpsSample[i] = Saturate16(((int64_t)nGainQ16 * lpsSample[i]) >> 16);
+}
+
+#if AUDIO_FE_HPF
+/* y[n] = x[n] - x[n-1] + a * y[n-1] */
+static void HpfProcess(AudioFrontEndFrame *pFrame, void *lpState)
+{
+        HpfState *pState = lpState;
+        int32_t nPrevIn = pState->nPrevIn;
+        int32_t nPrevOut = pState->nPrevOut;
+
+        // Start from the DC offset of the microphone, so that it does not look like a step to the gate
+        if (!pState->bStarted && pFrame->nNumSample > 0) {
+                nPrevIn = pFrame->lpsSample[0];
+                pState->bStarted = true;
+        }
+
+        for (int i = 0; i < pFrame->nNumSample; i++) {
+                int32_t nIn = pFrame->lpsSample[i];
+
+                nPrevOut = nIn - nPrevIn + ((HPF_COEF_Q15 * nPrevOut) >> 15);
+                nPrevIn = nIn;
+                pFrame->lpsSample[i] = Saturate16(nPrevOut);
+        }
+
+        pState->nPrevIn = nPrevIn;
+        pState->nPrevOut = nPrevOut;
+}
+#endif
+
+#if AUDIO_FE_GATE
+static void GateProcess(AudioFrontEndFrame *pFrame, void *lpState)
+{
+        GateState *pState = lpState;
+        uint32_t nEnergy = FrameEnergy(pFrame->lpsSample, pFrame->nNumSample);
+
+        if (nEnergy > AUDIO_FE_GATE_MIN_ENERGY && nEnergy / AUDIO_FE_GATE_RATIO > pState->nNoiseFloor) {
+                pState->nHangover = AUDIO_FE_GATE_HANGOVER;
+                pFrame->bSilent = false;
+        } else if (pState->nHangover > 0) {
+                pState->nHangover--;
+                pFrame->bSilent = false;
+        } else {
+                pFrame->bSilent = true;
+        }
+
+        // The floor follows quieter frames at once and louder ones slowly, by about 1.6% per frame
+        if (nEnergy < pState->nNoiseFloor)
+                pState->nNoiseFloor = nEnergy;
+        else
+                pState->nNoiseFloor += (pState->nNoiseFloor >> 6) + 1;
+}
+#endif
+
+#if AUDIO_FE_AGC
+static void AgcProcess(AudioFrontEndFrame *pFrame, void *lpState)
+{
+        AgcState *pState = lpState;
+
+        // The gain adapts to voice frames only, so that it does not pump up the noise
+        if (!pFrame->bSilent) {
+                int32_t nPeak = FramePeak(pFrame->lpsSample, pFrame->nNumSample);
+                int32_t nGainQ16 = AUDIO_FE_AGC_MAX_GAIN << 16;
+
+                if (nPeak > 0 && ((int64_t)AUDIO_FE_AGC_TARGET << 16) / nPeak < nGainQ16)
+                        nGainQ16 = ((int64_t)AUDIO_FE_AGC_TARGET << 16) / nPeak;
+                if (nGainQ16 < (1 << 16))
+                        nGainQ16 = 1 << 16;
+
+                // Down at once to avoid clipping, up slowly
+                if (nGainQ16 < pState->nGainQ16)
+                        pState->nGainQ16 = nGainQ16;
+                else
+                        pState->nGainQ16 += (nGainQ16 - pState->nGainQ16) >> 4;
+        }
+
+        if (pState->nGainQ16 != (1 << 16))
+                FrameScale(pFrame->lpsSample, pFrame->nNumSample, pState->nGainQ16);
+}
+#endif
+
+// The stages in processing order
+static const AudioFrontEndStage g_Stages[] = {
+#if AUDIO_FE_HPF
+        { HpfProcess, &g_HpfState },
+#endif
+#if AUDIO_FE_GATE
+        { GateProcess, &g_GateState },
+#endif
+#if AUDIO_FE_AGC
+        { AgcProcess, &g_AgcState },
+#endif
+        { NULL, NULL }
+};
+
+void AudioFrontEndInit(void)
+{
+#if AUDIO_FE_HPF
+        memset(&g_HpfState, 0, sizeof(g_HpfState));
+#endif
+#if AUDIO_FE_GATE
+        g_GateState.nNoiseFloor = AUDIO_FE_GATE_MIN_ENERGY;
+        g_GateState.nHangover = 0;
+#endif
+#if AUDIO_FE_AGC
+        g_AgcState.nGainQ16 = 1 << 16;
+#endif
+}
+
+bool AudioFrontEndProcess(int16_t *lpsSample, int nNumSample)
+{
+        AudioFrontEndFrame frame = { lpsSample, nNumSample, false };
+
+        for (const AudioFrontEndStage *pStage = g_Stages; pStage->fnProcess; pStage++)
+                pStage->fnProcess(&frame, pStage->lpState);
+
+        return !frame.bSilent;
+}
@@ -0,0 +1,76 @@
+/**
+ ****************************************************************************************
+ *
+ * @file AudioFrontEnd.h
+ *
+ * @brief Fixed-point conditioning of the recorded frames ahead of the recognition
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#ifndef AUDIO_FRONT_END_H_
+#define AUDIO_FRONT_END_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// DC removal, a first order high-pass filter at about 25Hz.
+#ifndef AUDIO_FE_HPF
+#define AUDIO_FE_HPF                    1
+#endif
+
+// Frames are amplified towards AUDIO_FE_AGC_TARGET peak, by up to AUDIO_FE_AGC_MAX_GAIN. Replaces the AGC of DSpotter.
+#ifndef AUDIO_FE_AGC
+#define AUDIO_FE_AGC                    1
+#endif
+
+#define AUDIO_FE_AGC_TARGET             16384                   // Peak sample value aimed at, -6dBFS
+#define AUDIO_FE_AGC_MAX_GAIN           8
+
+// Frames which are not louder than the tracked noise floor are reported silent, so that the recognition can skip them.
+#ifndef AUDIO_FE_GATE
+#define AUDIO_FE_GATE                   1
+#endif
+
+#define AUDIO_FE_GATE_RATIO             4                       // Energy above the noise floor of a voice frame, 6dB
+#define AUDIO_FE_GATE_MIN_ENERGY        (64 * 64)               // Mean square below which a frame is always silent
+#define AUDIO_FE_GATE_HANGOVER          10                      // Frames kept after the voice stops, the ending silence of a command
+
+typedef struct {
+        int16_t *lpsSample;
+        int nNumSample;
+        bool bSilent;                   // Set by the gate
+} AudioFrontEndFrame;
+
+// A stage conditions the frame in place.
+typedef void (*AudioFrontEndStageFunc)(AudioFrontEndFrame *pFrame, void *lpState);
+
+typedef struct {
+        AudioFrontEndStageFunc fnProcess;
+        void *lpState;
+} AudioFrontEndStage;
+
+void AudioFrontEndInit(void);
+
+/* Runs the frame through all the stages, in place. Returns false if the frame is silent */
+bool AudioFrontEndProcess(int16_t *lpsSample, int nNumSample);
+
+#endif /* AUDIO_FRONT_END_H_ */
@@ -29,7 +29,7 @@
 
 #include <stdbool.h>
 #include "include/base_types.h"
-#include "include/RingBuffer.h"
+#include "Util/FrameQueue.h"
 
 #include "periph_setup.h"
 #include "osal.h"
@@ -49,14 +49,37 @@
 // Define how may bytes must be stored in the memory buffer before the callback is called.
 #define MEMORY_BUFFER_BUF_CB_SAMPLE_LEN DSPOTTER_FRAME_SAMPLE//(AUDIO_SAMPLING_RATE / 100) // every 10msec, 100 times per second
 
+// The pre-roll (AUDIO_PREROLL_MS, see periph_setup.h) is recorded while the VAD is listening
+#if AUDIO_PREROLL_MS && !defined(VAD_PERIPH)
+#undef AUDIO_PREROLL_MS
+#define AUDIO_PREROLL_MS                0
+#endif
+
+#define AUDIO_PREROLL_FRAMES            ((AUDIO_PREROLL_MS * (AUDIO_SAMPLING_RATE / 1000) + DSPOTTER_FRAME_SAMPLE - 1) / DSPOTTER_FRAME_SAMPLE)
+
+// The DMA buffer is a pool of frame slots, which the recognizer reads in place. It may fall behind the
+// microphone by (AUDIO_FRAME_SLOTS - 2) frames before frames are lost, the pre-roll frames included.
+#define AUDIO_FRAME_SLOTS               (AUDIO_PREROLL_FRAMES + 6)
+
 // The size of the buffer in samples
-#define MEMORY_BUFFER_SAMPLE_SIZE       (MEMORY_BUFFER_BUF_CB_SAMPLE_LEN * 2)
+#define MEMORY_BUFFER_SAMPLE_SIZE       (MEMORY_BUFFER_BUF_CB_SAMPLE_LEN * AUDIO_FRAME_SLOTS)
+
+// Filled slots handed from the DMA callback to the recognizer. The queue holds one entry less than the
+// slots, the slot being filled is never queued.
+#define AUDIO_FRAME_QUEUE_SIZE          ((AUDIO_FRAME_SLOTS) <= 8 ? 8 : 16)
 
+static FrameQueue g_FrameQueue;
+static uint32_t   g_naFrameEntries[AUDIO_FRAME_QUEUE_SIZE];
 
-#define RBUF_SIZE                (DSPOTTER_FRAME_SIZE*6)  // Ring buffer size.
+#if (AUDIO_FRAME_SLOTS > 16)
+#error "g_naFrameEntries must hold all the frame slots, reduce AUDIO_PREROLL_MS"
+#endif
 
-static HANDLE g_hRingBuffer = NULL;
-static BYTE   g_byaRingBuffer[RING_BUFFER_GET_MEM_USAGE(RBUF_SIZE)];// The working memory for ring buffer.
+static bool g_bRecording;                       // The audio path is open
+#if AUDIO_PREROLL_MS
+static volatile bool g_bPreroll;                // Frames are only kept as history
+static volatile int  g_nHistoryFrames;
+#endif
 
 #if (AUDIO_SAMPLE_BIT_DEPTH == 32)
 #define AUDIO_DATA_TYPE int32_t
@@ -127,22 +150,34 @@ static sys_audio_device_t analog_mic_mem_out = {
 static OS_TASK audio_task_handle;
 static int g_nAudioDataNotif, g_nAudioDataLostNotif;
 
-static int AudioRecordPutData(void *lpData, int nSize);
-
-
 static void analog_mic_mem_cb(sys_audio_mgr_buffer_data_block_t *buff_data_block, void *app_ud)
 {
-    volatile uint32_t nDataStartPos;
+    uint32_t nDataStartPos;
+    int nSlot;
 
     if (buff_data_block->buff_len_pos > 0)
         nDataStartPos = buff_data_block->buff_len_pos - buff_data_block->buff_len_cb;
     else
         nDataStartPos = buff_data_block->buff_len_total - buff_data_block->buff_len_cb;
 
-    if (AudioRecordPutData((void *)(buff_data_block->address + nDataStartPos), buff_data_block->buff_len_cb) == 0)
+    // Only the index of the filled slot is handed over, the samples stay where the DMA put them
+    nSlot = nDataStartPos / buff_data_block->buff_len_cb;
+
+#if AUDIO_PREROLL_MS
+    if (g_bPreroll) {
+        // Nothing to hand over, the oldest frames of the history are recorded again
+        FrameQueueFilled(&g_FrameQueue, nSlot, false);
+        if (g_nHistoryFrames < AUDIO_PREROLL_FRAMES)
+            g_nHistoryFrames++;
+    }
+    else
+#endif
+    // The DMA goes on with the next slot. If the recognizer is a whole buffer behind, the oldest frame
+    // is being overwritten, and it is skipped when read. New frames are dropped while the queue is full.
+    if (FrameQueueFilled(&g_FrameQueue, nSlot, true))
         OS_TASK_NOTIFY_FROM_ISR(audio_task_handle, g_nAudioDataNotif, OS_NOTIFY_SET_BITS);
     else
-        OS_TASK_NOTIFY_FROM_ISR(audio_task_handle, g_nAudioDataLostNotif, OS_NOTIFY_SET_BITS);
+        OS_TASK_NOTIFY_FROM_ISR(audio_task_handle, g_nAudioDataNotif | g_nAudioDataLostNotif, OS_NOTIFY_SET_BITS);
 
 #ifdef USE_MARKER_PIN
         hw_gpio_pad_latch_enable(MARKER_PIN2);
@@ -155,21 +190,12 @@ static void analog_mic_mem_cb(sys_audio_mgr_buffer_data_block_t *buff_data_block
 
 extern bool DSpotterEnabled;
 
-bool AudioRecordStart(int path_idx, OS_TASK task_handle, int nAudioDataNotif, int nAudioDataLostNotif)
+static bool AudioRecordOpen(int path_idx)
 {
-//        printf("\r\nStart Audio");
         bool retval = false;
 
-        RingBufferInit(g_byaRingBuffer, RING_BUFFER_GET_MEM_USAGE(RBUF_SIZE), RBUF_SIZE, &g_hRingBuffer);
-        if (g_hRingBuffer == NULL)
-        {
-                printf("RingBufferInit() fail!\r\n");
-                return false;
-        }
-
-        audio_task_handle = task_handle;
-        g_nAudioDataNotif = nAudioDataNotif;
-        g_nAudioDataLostNotif = nAudioDataLostNotif;
+        FrameQueueInitCircular(&g_FrameQueue, g_naFrameEntries, AUDIO_FRAME_QUEUE_SIZE, AUDIO_FRAME_SLOTS);
+        g_bRecording = true;
 
 #if (!DEVICE_FPGA)
     #if dg_configUSE_SYS_AUDIO_SINGLE_PATH
@@ -194,6 +220,37 @@ bool AudioRecordStart(int path_idx, OS_TASK task_handle, int nAudioDataNotif, in
         hw_gpio_set_active(MARKER_PIN0);
         hw_gpio_pad_latch_disable(MARKER_PIN0);
 #endif
+        return retval;
+}
+
+bool AudioRecordStart(int path_idx, OS_TASK task_handle, int nAudioDataNotif, int nAudioDataLostNotif)
+{
+//        printf("\r\nStart Audio");
+        bool retval = true;
+
+        audio_task_handle = task_handle;
+        g_nAudioDataNotif = nAudioDataNotif;
+        g_nAudioDataLostNotif = nAudioDataLostNotif;
+
+#if AUDIO_PREROLL_MS
+        if (g_bRecording && g_bPreroll) {
+                int nFrames;
+
+                // The history is handed over ahead of the frames recorded from now on
+                OS_ENTER_CRITICAL_SECTION();
+                nFrames = g_nHistoryFrames;
+                FrameQueuePutHistory(&g_FrameQueue, nFrames);
+                g_bPreroll = false;
+                OS_LEAVE_CRITICAL_SECTION();
+
+                if (nFrames > 0)
+                        OS_TASK_NOTIFY(audio_task_handle, g_nAudioDataNotif, OS_NOTIFY_SET_BITS);
+        }
+        else
+#endif
+        if (!g_bRecording)
+                retval = AudioRecordOpen(path_idx);
+
 #ifdef dg_configLCD_GUI
 //        Lcd_text_api("Listening...");
 #endif
@@ -212,8 +269,12 @@ void AudioRecordStop(int path_idx)
         sys_audio_mgr_close_path(path_idx); //sys_audio_mgr_close();
     #endif
 #endif
-        RingBufferRelease(g_hRingBuffer);
-        g_hRingBuffer = NULL;
+        // Frames not read yet are dropped
+        FrameQueueInitCircular(&g_FrameQueue, g_naFrameEntries, AUDIO_FRAME_QUEUE_SIZE, AUDIO_FRAME_SLOTS);
+        g_bRecording = false;
+#if AUDIO_PREROLL_MS
+        g_bPreroll = false;
+#endif
 #ifdef USE_MARKER_PIN
         hw_gpio_pad_latch_enable(MARKER_PIN0);
         hw_gpio_set_inactive(MARKER_PIN0);
@@ -227,21 +288,47 @@ void AudioRecordStop(int path_idx)
 #endif
 }
 
-int AudioRecordGetDataSize()
+void AudioRecordPause(int path_idx)
 {
-    return (RingBufferGetDataSize(g_hRingBuffer));
+#if AUDIO_PREROLL_MS
+        // Frames not read yet are dropped, the history starts over
+        OS_ENTER_CRITICAL_SECTION();
+        g_bPreroll = true;
+        g_nHistoryFrames = 0;
+        FrameQueueInitCircular(&g_FrameQueue, g_naFrameEntries, AUDIO_FRAME_QUEUE_SIZE, AUDIO_FRAME_SLOTS);
+        OS_LEAVE_CRITICAL_SECTION();
+
+        if (!g_bRecording)
+                AudioRecordOpen(path_idx);
+#ifdef dg_configLCD_GUI
+        extern OS_TASK template_task_h;
+        if (DSpotterEnabled){
+                OS_TASK_NOTIFY(template_task_h, LCD_TIMEOUT_NOTIF, OS_NOTIFY_SET_BITS);
+        }
+#endif
+#else
+        if (g_bRecording)
+                AudioRecordStop(path_idx);
+#endif
 }
 
-int AudioRecordGetData(void *lpData, int nSize)
+short *AudioRecordGetFrame(void)
 {
-    return RingBufferGetData(g_hRingBuffer, lpData, nSize);
+        int nSlot = FrameQueuePeek(&g_FrameQueue);
+
+        if (nSlot < 0)
+                return NULL;
+
+        // 16KHz, 16 bits, mono channel PCM format.
+        return (short *)&analog_mic_buffer[nSlot * MEMORY_BUFFER_BUF_CB_SAMPLE_LEN];
 }
 
-static int AudioRecordPutData(void *lpData, int nSize)
+bool AudioRecordReleaseFrame(void)
 {
-        if (RingBufferGetFreeSize(g_hRingBuffer) < nSize)
-                return RING_BUFFER_ERR_OUT_OF_MEMORY;
+        return FrameQueueRelease(&g_FrameQueue);
+}
 
-        // Put record data to ring buffer, it must be 16KHz, 16 bits, mono channel PCM format.
-        return RingBufferPutData(g_hRingBuffer, lpData, nSize);
+int AudioRecordGetFrameCount(void)
+{
+        return FrameQueueGetCount(&g_FrameQueue);
 }
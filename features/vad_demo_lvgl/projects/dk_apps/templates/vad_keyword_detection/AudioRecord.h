@@ -31,5 +31,13 @@
 
 bool AudioRecordStart(int path_idx, OS_TASK task_handle, int nAudioDataNotif, int nAudioDataLostNotif);
 void AudioRecordStop(int path_idx);
-int AudioRecordGetDataSize();
-int AudioRecordGetData(void *lpData, int nSize);
+/* No more frames are handed over. With a pre-roll the microphone keeps recording into the history,
+ * which the next AudioRecordStart() hands over first, otherwise the recording stops */
+void AudioRecordPause(int path_idx);
+
+/* Oldest recorded frame, read in place. NULL if no frame is pending */
+short *AudioRecordGetFrame(void);
+/* The frame returned by AudioRecordGetFrame() has been read, its slot can be recorded again. Returns
+ * false if the microphone has overwritten the frame meanwhile */
+bool AudioRecordReleaseFrame(void);
+int AudioRecordGetFrameCount(void);
@@ -27,6 +27,7 @@
  ****************************************************************************************
  */
 #include "Helper_func.h"
+#include "AudioDump.h"
 
 extern OS_TASK template_task_h;
 extern OS_TASK audio_task_h;
@@ -66,6 +67,10 @@ static void vad_cb(void)
 
 void re_enable_vad(void)
 {
+#if AUDIO_DUMP_EN
+        // The dump UART is released before the system may sleep
+        AudioDumpFlush();
+#endif
         hw_vad_set_mode(HW_VAD_MODE_ALWAYS_LISTENING);
         while(hw_vad_get_mode() != HW_VAD_MODE_ALWAYS_LISTENING) {__NOP();}
 //        printf("\r\n\r\nVAD Ready");
@@ -259,8 +264,13 @@ void print_stats(void)
 {
         printf("\r\n\r\n------------------------------");
         printf("\r\nWake_up: %i", vad_stats.WakeUp);
+        printf("\r\nTrigger: %i (pre-roll %d ms)", vad_stats.Trigger, AUDIO_PREROLL_MS);
         printf("\r\nNVD: %i", vad_stats.NDV);
         printf("\r\nVDV: %i", vad_stats.VDV);
+        printf("\r\nGroup switch: %lu us", (unsigned long)vad_stats.SwitchTime);
+#if AUDIO_DUMP_EN
+        printf("\r\nDump dropped: %lu frames", (unsigned long)AudioDumpGetDropCount());
+#endif
 #ifdef MEASURE_NFI
         printf("\r\nPeriod: %lu ms", (unsigned long)vad_stats.Period);
 #endif
@@ -42,9 +42,11 @@
 
 typedef struct {
         uint16_t WakeUp;
+        uint16_t Trigger;       // Wake-up words recognized
         uint16_t VDV;
         uint16_t NDV;
         uint32_t Period;
+        uint32_t SwitchTime;    // Last switch between recognizer groups, in usec
 } vad_stats_t;
 
 void re_enable_vad(void);
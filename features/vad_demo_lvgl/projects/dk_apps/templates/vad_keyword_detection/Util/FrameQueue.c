@@ -0,0 +1,161 @@
+/**
+ ****************************************************************************************
+ *
+ * @file FrameQueue.c
+ *
+ * @brief Lock-free single producer, single consumer queue of frame slots
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#include "FrameQueue.h"
+
+// The slot contents must be complete before the index is seen on the other side
+#define FRAME_QUEUE_BARRIER()   __sync_synchronize()
+
+void FrameQueueInit(FrameQueue *pQueue, uint32_t *lpnEntries, uint32_t nSize)
+{
+        FrameQueueInitCircular(pQueue, lpnEntries, nSize, 0);
+}
+
+bool FrameQueuePut(FrameQueue *pQueue, uint32_t nSlot)
+{
+        uint32_t nHead = pQueue->nHead;
+
+        if (nHead - pQueue->nTail == pQueue->nSize)
+                return false;
+
+        pQueue->lpnEntries[nHead & (pQueue->nSize - 1)] = nSlot;
+        FRAME_QUEUE_BARRIER();
+        pQueue->nHead = nHead + 1;
+
+        return true;
+}
+
+/* Frames filled after nSeq, the one being filled included */
+static uint32_t SeqAge(const FrameQueue *pQueue, uint32_t nSeq)
+{
+        return (pQueue->nFilledSeq + pQueue->nSeqWrap - nSeq) % pQueue->nSeqWrap + 1;
+}
+
+/* The DMA has started to write the slot of nSeq again */
+static bool SeqOverwritten(const FrameQueue *pQueue, uint32_t nSeq)
+{
+        return SeqAge(pQueue, nSeq) >= pQueue->nSlots;
+}
+
+int FrameQueuePeek(FrameQueue *pQueue)
+{
+        uint32_t nTail = pQueue->nTail;
+        uint32_t nEntry;
+
+        while (pQueue->nHead != nTail) {
+                FRAME_QUEUE_BARRIER();
+                nEntry = pQueue->lpnEntries[nTail & (pQueue->nSize - 1)];
+                if (pQueue->nSlots == 0)
+                        return nEntry;
+                if (!SeqOverwritten(pQueue, nEntry))
+                        return nEntry % pQueue->nSlots;
+
+                // Lost before it could be read
+                pQueue->nOverwritten++;
+                pQueue->nTail = ++nTail;
+        }
+
+        return -1;
+}
+
+bool FrameQueueRelease(FrameQueue *pQueue)
+{
+        uint32_t nTail = pQueue->nTail;
+        bool bIntact = true;
+
+        if (pQueue->nHead == nTail)
+                return true;
+
+        // Reading the slot is over before the producer may reuse it
+        FRAME_QUEUE_BARRIER();
+        if (pQueue->nSlots && SeqOverwritten(pQueue, pQueue->lpnEntries[nTail & (pQueue->nSize - 1)])) {
+                pQueue->nOverwritten++;
+                bIntact = false;
+        }
+        pQueue->nTail = nTail + 1;
+
+        return bIntact;
+}
+
+uint32_t FrameQueueGetCount(const FrameQueue *pQueue)
+{
+        return pQueue->nHead - pQueue->nTail;
+}
+
+void FrameQueueInitCircular(FrameQueue *pQueue, uint32_t *lpnEntries, uint32_t nSize, uint32_t nSlots)
+{
+        pQueue->lpnEntries = lpnEntries;
+        pQueue->nSize = nSize;
+        pQueue->nHead = 0;
+        pQueue->nTail = 0;
+        pQueue->nSlots = nSlots;
+        pQueue->nSeqWrap = nSlots ? 0x80000000u / nSlots * nSlots : 1;
+        pQueue->nFilledSeq = pQueue->nSeqWrap - 1;     // The first slot filled is slot 0
+        pQueue->nDropped = 0;
+        pQueue->nOverwritten = 0;
+}
+
+bool FrameQueueFilled(FrameQueue *pQueue, uint32_t nSlot, bool bQueue)
+{
+        uint32_t nSeq = (pQueue->nFilledSeq + 1) % pQueue->nSeqWrap;
+        uint32_t nTail = pQueue->nTail;
+        bool bLost = false;
+
+        // Slots are filled in order, unless a callback was missed
+        nSeq = (nSeq + (nSlot + pQueue->nSlots - nSeq % pQueue->nSlots) % pQueue->nSlots) % pQueue->nSeqWrap;
+        pQueue->nFilledSeq = nSeq;
+
+        if (!bQueue)
+                return true;
+
+        // The slot the DMA goes on with still holds the oldest frame not read yet
+        if (pQueue->nHead != nTail && SeqOverwritten(pQueue, pQueue->lpnEntries[nTail & (pQueue->nSize - 1)]))
+                bLost = true;
+
+        // One slot is being filled, the queued frames keep the others
+        if (FrameQueueGetCount(pQueue) >= pQueue->nSlots - 1 || !FrameQueuePut(pQueue, nSeq)) {
+                pQueue->nDropped++;
+                bLost = true;
+        }
+
+        return !bLost;
+}
+
+void FrameQueuePutHistory(FrameQueue *pQueue, uint32_t nFrames)
+{
+        if (nFrames > pQueue->nSlots - 1)
+                nFrames = pQueue->nSlots - 1;
+
+        while (nFrames-- > 0)
+                FrameQueuePut(pQueue, (pQueue->nFilledSeq + pQueue->nSeqWrap - nFrames) % pQueue->nSeqWrap);
+}
+
+uint32_t FrameQueueGetLostCount(const FrameQueue *pQueue)
+{
+        return pQueue->nDropped + pQueue->nOverwritten;
+}
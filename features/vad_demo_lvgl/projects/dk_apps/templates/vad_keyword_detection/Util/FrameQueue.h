@@ -0,0 +1,94 @@
+/**
+ ****************************************************************************************
+ *
+ * @file FrameQueue.h
+ *
+ * @brief Lock-free single producer, single consumer queue of frame slots
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#ifndef __FRAME_QUEUE_H_
+#define __FRAME_QUEUE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The producer (e.g. an ISR) publishes the index of a filled slot with FrameQueuePut(). The consumer
+ * reads the oldest slot in place, found with FrameQueuePeek(), and gives it back with
+ * FrameQueueRelease(). A slot stays in the queue until it is released.
+ *
+ * A circular queue (FrameQueueInitCircular()) tracks the slots of a circular DMA buffer, which the
+ * DMA overwrites whether they are released or not. The producer reports each filled slot with
+ * FrameQueueFilled() and the queue holds sequence numbers, so that the frames overwritten before or
+ * while they are read are told apart from the ones recorded later into the same slots.
+ */
+typedef struct {
+        uint32_t *lpnEntries;
+        uint32_t nSize;                 // Entries of lpnEntries, a power of two
+        volatile uint32_t nHead;        // Written by the producer only
+        volatile uint32_t nTail;        // Written by the consumer only
+        // Circular queue only
+        uint32_t nSlots;                // Slots of the DMA buffer, 0 for a plain queue
+        uint32_t nSeqWrap;              // Sequence numbers wrap at a multiple of nSlots
+        volatile uint32_t nFilledSeq;   // Last slot filled, written by the producer only
+        uint32_t nDropped;              // Frames not queued, written by the producer only
+        uint32_t nOverwritten;          // Queued frames overwritten, written by the consumer only
+} FrameQueue;
+
+void FrameQueueInit(FrameQueue *pQueue, uint32_t *lpnEntries, uint32_t nSize);
+
+/* Producer side, returns false if the queue is full */
+bool FrameQueuePut(FrameQueue *pQueue, uint32_t nSlot);
+
+/* Oldest slot not released yet, -1 if the queue is empty. Overwritten frames of a circular queue are skipped */
+int FrameQueuePeek(FrameQueue *pQueue);
+
+/* Consumer side, the oldest slot has been read. Returns false if a circular queue slot was overwritten meanwhile */
+bool FrameQueueRelease(FrameQueue *pQueue);
+
+uint32_t FrameQueueGetCount(const FrameQueue *pQueue);
+
+void FrameQueueInitCircular(FrameQueue *pQueue, uint32_t *lpnEntries, uint32_t nSize, uint32_t nSlots);
+
+/*
+ * Producer side of a circular queue, the DMA has filled nSlot and goes on with the next slot. The frame
+ * is queued if bQueue is set, at most nSlots - 1 frames are queued. Returns false if a frame is lost: the
+ * new frame is dropped or the oldest queued one is being overwritten.
+ */
+bool FrameQueueFilled(FrameQueue *pQueue, uint32_t nSlot, bool bQueue);
+
+/* Queues the last nFrames filled slots, which were not queued when filled. Called with the producer stopped */
+void FrameQueuePutHistory(FrameQueue *pQueue, uint32_t nFrames);
+
+/* Frames of a circular queue lost so far, either dropped or overwritten before they were released */
+uint32_t FrameQueueGetLostCount(const FrameQueue *pQueue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
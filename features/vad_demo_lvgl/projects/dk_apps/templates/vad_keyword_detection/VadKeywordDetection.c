@@ -36,13 +36,15 @@
 #include "include/DSpotterSDKApi.h"
 #include "include/RingBuffer.h"
 #include "include/CybModelInfor.h"
-#include "include/Convert2TransferBuffer.h"
 #include "Model/CybModel1.h" // The packed model file.
 #include "Util/PortFunction.h"
 #include "AudioRecord.h"
+#include "AudioFrontEnd.h"
+#include "AudioDump.h"
 #include "hw_sys.h"
 #include "hw_uart.h"
 #include "sys_clock_mgr.h"
+#include "sys_timer.h"
 
 // AUDIO
 #include "periph_setup.h"
@@ -51,7 +53,6 @@
 // AUDIO
 
 #define NOT_SHOW_MULTI_PRONUNCIATION
-//#define SUPPORT_UART_DUMP_RECORD
 
 #define MAX_COMMAND_TIME        (5000 / 10)			// Trigger and command must be spoke within 5000ms.
 #define DSPOTTER_FRAME_SAMPLE   480				// DSpotter compute every 30ms, it is 480 samples for 16KHz sampling rate.
@@ -60,9 +61,13 @@
 #define COMMAND_STAGE_TIME_MIN  6000				// When no result at command recognition stage, the minimum recording time in ms.
 #define COMMAND_STAGE_TIME_MAX  8000				// When no result at command recognition stage, the maximum recording time in ms.
 #define WAIKUP_COMMAND_TIMEOUT  4000
+#define MAX_GROUP_COUNT         2                               // Groups of the model kept resident, each with its own working memory.
+//#define RUN_GROUPS_CONCURRENTLY                               // The command group also listens during the trigger stage, so that a command
+                                                                // spoken right after the trigger is not cut. Doubles the recognition load.
 
 HANDLE InitRecognition(HANDLE hCybModel, int nGroupIndex, BYTE *lpbyDSpotterMem, int nDSpotterMemSize);
 void ReleaseRecognition(HANDLE *phDSpotter);
+HANDLE SwitchRecognition(HANDLE *phDSpotterGroup, int nGroupCount, int nGroupIndex);
 void PrintGroupCommandList(HANDLE hCybModel, int nGroupIndex);
 
 bool DSpotterEnabled = false;
@@ -76,14 +81,18 @@ void VadKeywordDetection_task(void *pvParameters)
 {
 	HANDLE hCybModel = NULL;
 	HANDLE hDSpotter = NULL;
-	BYTE *lpbyDSpotterMem = NULL; // The memory for DSpotter engine.
-	int nDSpotterMemSize = 0;
+	HANDLE hDSpotterGroup[MAX_GROUP_COUNT] = { NULL };
+	BYTE *lpbyDSpotterMem[MAX_GROUP_COUNT] = { NULL }; // The memory for DSpotter engine, per group.
+	int nDSpotterMemSize[MAX_GROUP_COUNT] = { 0 };
+	int nDSpotterMemTotal = 0;
 	int nGroupCount;
 	int nActiveGroupIndex;
 	int nRet = DSPOTTER_ERR_NeedMoreSample;
 	int nRecordFrameCount = 0;
+	bool bVoiceFrame;
 	uint8_t path_idx = 0;
 
+	vad_stats.Trigger = 0;
 	vad_stats.VDV = 0;
 	vad_stats.NDV = 0;
 
@@ -92,6 +101,11 @@ void VadKeywordDetection_task(void *pvParameters)
 	// Initial model manager, list all commands, calculate the memory requirement.
 	hCybModel = CybModelInit((const BYTE *)&uCYModel1Begin, NULL, 0, NULL);
 	nGroupCount = CybModelGetGroupCount(hCybModel);
+	if (nGroupCount > MAX_GROUP_COUNT)
+	{
+		printf("Only the first %d of %d model groups are used.\r\n", MAX_GROUP_COUNT, nGroupCount);
+		nGroupCount = MAX_GROUP_COUNT;
+	}
 	for (int nGroup = 0; nGroup < nGroupCount; nGroup++)
 	{
 		BYTE *lppbyModel[1];
@@ -99,42 +113,58 @@ void VadKeywordDetection_task(void *pvParameters)
 		lppbyModel[0] = (BYTE *)CybModelGetGroup(hCybModel, nGroup);
 		nMemSize = DSpotter_GetMemoryUsage_Multi((BYTE *)CybModelGetBase(hCybModel), lppbyModel, 1, MAX_COMMAND_TIME);
 		printf("The DSpotter model group %d needed working memory size = %d\r\n", nGroup, nMemSize);
-		if (nDSpotterMemSize < nMemSize)
-			nDSpotterMemSize = nMemSize;
+		nDSpotterMemSize[nGroup] = nMemSize;
+		nDSpotterMemTotal += nMemSize;
 
 		printf("The DSpotter command list of group index %d: \r\n", nGroup);
 		PrintGroupCommandList(hCybModel, nGroup);
 	}
+	printf("The DSpotter working memory of all groups = %d\r\n", nDSpotterMemTotal);
 	printf("\r\n");
 
-	// Allocate
-	lpbyDSpotterMem = PortMalloc(nDSpotterMemSize);
-	if (lpbyDSpotterMem == NULL)
+	// All the groups stay initialized, a stage switch only resets the next group.
+	for (int nGroup = 0; nGroup < nGroupCount; nGroup++)
 	{
-		printf("Fail to allocate %d memory for DSpotter.\r\n", nDSpotterMemSize);
-		CybModelRelease(hCybModel);
-		return;
-	}
+		// Allocate
+		lpbyDSpotterMem[nGroup] = PortMalloc(nDSpotterMemSize[nGroup]);
+		if (lpbyDSpotterMem[nGroup] == NULL)
+		{
+			printf("Fail to allocate %d memory for DSpotter.\r\n", nDSpotterMemSize[nGroup]);
+			break;
+		}
 
-	nActiveGroupIndex = 0;
-	hDSpotter = InitRecognition(hCybModel, nActiveGroupIndex, lpbyDSpotterMem, nDSpotterMemSize);
-	if (hDSpotter == NULL)
+		hDSpotterGroup[nGroup] = InitRecognition(hCybModel, nGroup, lpbyDSpotterMem[nGroup], nDSpotterMemSize[nGroup]);
+		if (hDSpotterGroup[nGroup] == NULL)
+			break;
+	}
+	if (nGroupCount == 0 || hDSpotterGroup[nGroupCount - 1] == NULL)
 	{
+		for (int nGroup = 0; nGroup < nGroupCount; nGroup++)
+		{
+			ReleaseRecognition(&hDSpotterGroup[nGroup]);
+			PortFree(lpbyDSpotterMem[nGroup]);
+		}
 		CybModelRelease(hCybModel);
-		PortFree(lpbyDSpotterMem);
 		return;
 	}
+
+	nActiveGroupIndex = 0;
+	hDSpotter = hDSpotterGroup[nActiveGroupIndex];
+	AudioFrontEndInit();
+#if AUDIO_DUMP_EN
+	AudioDumpInit();
+#endif
 	DSpotterEnabled = true;
 	int nCommandRecordSample = 0;
 	int nCommandRecognizeLimit = COMMAND_STAGE_TIME_MIN;
-	short *lpsRecordSample = PortMalloc(DSPOTTER_FRAME_SIZE);
-#if defined(SUPPORT_UART_DUMP_RECORD) && (CONFIG_RETARGET_UART_BAUDRATE == HW_UART_BAUDRATE_921600)
-	uint8_t *lpbyTxBuffere = NULL;
-#endif
+	short *lpsRecordSample;
 	uint32_t notif;
 
 #ifndef VAD_PERIPH
 	OS_TASK_NOTIFY(audio_task_h, AUDIO_START_NOTIF,  OS_NOTIFY_SET_BITS);
+#else
+	// Record the pre-roll history until the VAD wakes up
+	AudioRecordPause(path_idx);
 #endif
 
 #ifdef dg_configLCD_GUI
@@ -153,7 +183,7 @@ Audio_start:
                         goto Audio_start;
                 }
                 if (notif & AUDIO_STOP_NOTIF){
-                       AudioRecordStop(path_idx);
+                       AudioRecordPause(path_idx);
 #ifdef VAD_PERIPH
                        re_enable_vad();
 #endif
@@ -163,6 +193,10 @@ Audio_start:
                 if (notif & AUDIO_DATA_LOST_NOTIF)
                         printf("Warning: data lost!\r\n");
 
+		// Get record data, it is read in place out of the DMA buffer.
+		lpsRecordSample = AudioRecordGetFrame();
+		if (lpsRecordSample == NULL)
+		        continue;
 
 
 		nRecordFrameCount++;
@@ -174,9 +208,6 @@ Audio_start:
 		led_operation ( nRecordFrameCount,  nActiveGroupIndex);
 #endif
 
-// Get record data.
-		AudioRecordGetData(lpsRecordSample, DSPOTTER_FRAME_SIZE); // 71us
-
 // DSpotter AddSample // 4ms RAM,  9.6 ms FLASH, CLK 160, Highest priority DSpotter task
                 __NOP();
 #ifdef USE_MARKER_PIN
@@ -184,8 +215,21 @@ Audio_start:
 		hw_gpio_set_active(MARKER_PIN1);
 #endif
 
+		// Condition the frame in place. Silent frames are not recognized, unless a keyword is in progress.
+		bVoiceFrame = AudioFrontEndProcess(lpsRecordSample, DSPOTTER_FRAME_SAMPLE);
+
 		// DSpotter AddSample
-		nRet = DSpotter_AddSample(hDSpotter, lpsRecordSample, DSPOTTER_FRAME_SAMPLE);
+		if (bVoiceFrame || DSpotter_IsKeywordAlive(hDSpotter))
+			nRet = DSpotter_AddSample(hDSpotter, lpsRecordSample, DSPOTTER_FRAME_SAMPLE);
+		else
+			nRet = DSPOTTER_ERR_NeedMoreSample;
+#ifdef RUN_GROUPS_CONCURRENTLY
+		// The command group listens ahead, its results count from the command stage on only
+		if (nActiveGroupIndex == 0 && nGroupCount > 1 &&
+		    (bVoiceFrame || DSpotter_IsKeywordAlive(hDSpotterGroup[1])) &&
+		    DSpotter_AddSample(hDSpotterGroup[1], lpsRecordSample, DSPOTTER_FRAME_SAMPLE) == DSPOTTER_SUCCESS)
+			DSpotter_Reset(hDSpotterGroup[1]);
+#endif
 #ifdef USE_MARKER_PIN
 		hw_gpio_set_inactive(MARKER_PIN1);
 		hw_gpio_pad_latch_disable(MARKER_PIN1);
@@ -197,21 +241,17 @@ Audio_start:
 //        hw_gpio_set_active(MARKER_PIN0);
 //        hw_gpio_pad_latch_disable(MARKER_PIN0);
 //#endif
-#if defined(SUPPORT_UART_DUMP_RECORD) && (CONFIG_RETARGET_UART_BAUDRATE == HW_UART_BAUDRATE_921600)     // 14.7ms RAM & FLASH
-                if (lpbyTxBuffere == NULL)
-                        lpbyTxBuffere = PortMalloc(DSPOTTER_FRAME_SIZE * 5 / 4);
-                Convert2TransferBuffer((BYTE *)lpsRecordSample, DSPOTTER_FRAME_SIZE, lpbyTxBuffere, DSPOTTER_FRAME_SIZE * 5 / 4, eFourByteDataOneChecksum);
-                hw_sys_pd_com_enable();
-                HW_GPIO_PAD_LATCH_ENABLE(SER1_TX);
-                HW_GPIO_SET_PIN_FUNCTION(SER1_TX);
-                hw_uart_send(HW_UART2, lpbyTxBuffere, DSPOTTER_FRAME_SIZE * 5 / 4, NULL, NULL);
-                while (hw_uart_is_busy(SER1_UART))
-                {
-                        __NOP();
-                }
-                HW_GPIO_PAD_LATCH_DISABLE(SER1_TX);
-//                hw_sys_pd_com_disable();
+#if AUDIO_DUMP_EN
+                // Only the conversion is done here, the DMA sends the frame meanwhile
+                AudioDumpPut(lpsRecordSample, DSPOTTER_FRAME_SAMPLE);
 #endif
+		if (!AudioRecordReleaseFrame())
+		        printf("Warning: data lost!\r\n");
+
+		// Notifications of frames recorded meanwhile may have been merged into one
+		if (AudioRecordGetFrameCount() > 0)
+		        OS_TASK_NOTIFY(OS_GET_CURRENT_TASK(), AUDIO_DATA_NOTIF, OS_NOTIFY_SET_BITS);
+
 //#ifdef USE_MARKER_PIN
 //        hw_gpio_pad_latch_enable(MARKER_PIN0);
 //        hw_gpio_set_inactive(MARKER_PIN0);
@@ -244,13 +284,13 @@ Audio_start:
 			        Lcd_text_api("Yes, I am listening...");
 #endif
 				// After trigger word recognized, switch to command recognition mode
-				ReleaseRecognition(&hDSpotter);
+				vad_stats.Trigger++;
 				nActiveGroupIndex = 1;
-				hDSpotter = InitRecognition(hCybModel, nActiveGroupIndex, lpbyDSpotterMem, nDSpotterMemSize);
+				hDSpotter = SwitchRecognition(hDSpotterGroup, nGroupCount, nActiveGroupIndex);
 			}
 			else
 			{
-			        AudioRecordStop(path_idx);
+			        AudioRecordPause(path_idx);
 
 				// After command word recognized, do something defined by user.
 				switch (nMapID)
@@ -286,9 +326,8 @@ Audio_start:
 				vad_stats.VDV++;
 				print_stats();
 
-				ReleaseRecognition(&hDSpotter);
 				nActiveGroupIndex = 0;
-				hDSpotter = InitRecognition(hCybModel, nActiveGroupIndex, lpbyDSpotterMem, nDSpotterMemSize);
+				hDSpotter = SwitchRecognition(hDSpotterGroup, nGroupCount, nActiveGroupIndex);
 				nRecordFrameCount = 0;
 #ifdef VAD_PERIPH
 				re_enable_vad();
@@ -319,15 +358,14 @@ Audio_start:
 					}
 				}
 
-				AudioRecordStop(path_idx);
+				AudioRecordPause(path_idx);
 				printf("\r\nTimeout for command stage, switch to trigger stage.\r\n");
 				vad_stats.NDV++;
 				print_stats();
 				nCommandRecognizeLimit = COMMAND_STAGE_TIME_MIN;
 
-				ReleaseRecognition(&hDSpotter);
 				nActiveGroupIndex = 0;
-				hDSpotter = InitRecognition(hCybModel, nActiveGroupIndex, lpbyDSpotterMem, nDSpotterMemSize);
+				hDSpotter = SwitchRecognition(hDSpotterGroup, nGroupCount, nActiveGroupIndex);
 				nRecordFrameCount = 0;
 #ifdef USE_LEDS
 				leds_off();
@@ -357,10 +395,9 @@ Audio_start:
 		                printf("\r\nComTimeOut");
 		                vad_stats.NDV++;
 		                print_stats();
-		                AudioRecordStop(path_idx);
-		                ReleaseRecognition(&hDSpotter);
+		                AudioRecordPause(path_idx);
                                 nActiveGroupIndex = 0;
-                                hDSpotter = InitRecognition(hCybModel, nActiveGroupIndex, lpbyDSpotterMem, nDSpotterMemSize);
+                                hDSpotter = SwitchRecognition(hDSpotterGroup, nGroupCount, nActiveGroupIndex);
                                 nRecordFrameCount = 0;
 #ifdef USE_LEDS
                                 leds_off();
@@ -382,14 +419,13 @@ Audio_start:
 
 	DSpotterEnabled = false;
 	AudioRecordStop(path_idx);
-	PortFree(lpsRecordSample);
-#if defined(SUPPORT_UART_DUMP_RECORD) && (CONFIG_RETARGET_UART_BAUDRATE == HW_UART_BAUDRATE_921600)
-	PortFree(lpbyTxBuffere);
-#endif
 
-	ReleaseRecognition(&hDSpotter);
+	for (int nGroup = 0; nGroup < nGroupCount; nGroup++)
+	{
+		ReleaseRecognition(&hDSpotterGroup[nGroup]);
+		PortFree(lpbyDSpotterMem[nGroup]);
+	}
 	CybModelRelease(hCybModel);
-	PortFree(lpbyDSpotterMem);
 #ifdef dg_configLCD_GUI
 	Lcd_text_api("Restart DSpotter");
 #endif
@@ -425,8 +461,8 @@ HANDLE InitRecognition(HANDLE hCybModel, int nGroupIndex, BYTE *lpbyDSpotterMem,
 //	printf("\r\n%s group active.\r\n", nGroupIndex == 0 ? "Wake-up" : "Command");
 //	PrintGroupCommandList(hCybModel, nGroupIndex);
 
-	// If the recording volume is too low, please use the following API to amplify it.
-	if (AGC_VOLUME_SCALE != 100)
+	// If the recording volume is too low, please use the following API to amplify it. The front end has its own AGC.
+	if (AGC_VOLUME_SCALE != 100 && !AUDIO_FE_AGC)
 	{
 		DSpotterAGC_Enable(hDSpotter);
 		DSpotterAGC_SetMaxGain(hDSpotter, AGC_VOLUME_SCALE / 100.0);
@@ -444,6 +480,27 @@ void ReleaseRecognition(HANDLE *phDSpotter)
 	}
 }
 
+HANDLE SwitchRecognition(HANDLE *phDSpotterGroup, int nGroupCount, int nGroupIndex)
+{
+	uint64_t nStartTime = sys_timer_get_uptime_usec();
+
+#ifdef RUN_GROUPS_CONCURRENTLY
+	// Back at the trigger stage all the groups start over. The command group goes on with what it heard
+	// since the trigger stage.
+	if (nGroupIndex == 0)
+	{
+		for (int i = 0; i < nGroupCount; i++)
+			DSpotter_Reset(phDSpotterGroup[i]);
+	}
+#else
+	// Models and working memory of the group stay resident, only its state is cleared.
+	DSpotter_Reset(phDSpotterGroup[nGroupIndex]);
+#endif
+
+	vad_stats.SwitchTime = sys_timer_get_uptime_usec() - nStartTime;
+	return phDSpotterGroup[nGroupIndex];
+}
+
 void PrintGroupCommandList(HANDLE hCybModel, int nGroupIndex)
 {
 	char szCommand[64];
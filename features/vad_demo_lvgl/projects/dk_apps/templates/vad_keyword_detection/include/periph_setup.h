@@ -39,6 +39,14 @@
 #define nSUPPORT_UART_DUMP_RECORD
 #define USE_MARKER_PIN
 
+// With VAD_PERIPH the microphone may keep recording the last AUDIO_PREROLL_MS msec while the VAD is
+// listening, e.g. 300. On wake-up they are replayed ahead of the live frames, so that the start of the
+// wake-up word is not lost. The audio path then stays open and the system does not sleep, which defeats
+// the low power listening of the VAD. Off by default.
+#ifndef AUDIO_PREROLL_MS
+#define AUDIO_PREROLL_MS        0
+#endif
+
 #ifdef dg_configLCD_GUI
 #undef USE_LEDS                 // If LDC used LEDs should be disabled, build OQSPI without LCD support
 #endif
@@ -0,0 +1,346 @@
+/**
+ ****************************************************************************************
+ *
+ * @file AudioFrontEnd_test.c
+ *
+ * @brief Host test of the audio front end stages and kernels
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run on the host, with the generic C kernels and with host versions of the M33 DSP intrinsics:
+ *      gcc -Wall -Wextra -O2 -o AudioFrontEnd_test AudioFrontEnd_test.c -lm && ./AudioFrontEnd_test
+ *      gcc -Wall -Wextra -O2 -DAUDIO_FE_TEST_DSP -o AudioFrontEnd_test AudioFrontEnd_test.c -lm && ./AudioFrontEnd_test
+ *
+ * The kernels must match a plain 64-bit computation on random frames, including odd lengths and full scale
+ * samples. The stages are fed synthetic 30ms frames at 16KHz: the high-pass filter must remove DC and keep
+ * 1KHz, the gate must open on the first voice frame and close AUDIO_FE_GATE_HANGOVER frames after it, and the
+ * AGC must reach its maximum gain on quiet voice and drop at once without clipping on loud voice.
+ *
+ * Recordings (16KHz, 16 bits, mono WAV) can be given as arguments, the number of frames passed to the
+ * recognition is then printed. Captures of dump2wav.py are already conditioned, they are taken after the
+ * front end.
+ */
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef AUDIO_FE_TEST_DSP
+#define AUDIO_FE_USE_DSP
+
+static inline int32_t __SSAT(int32_t nValue, int nBits)
+{
+        int32_t nMax = (1 << (nBits - 1)) - 1;
+
+        return nValue > nMax ? nMax : nValue < -nMax - 1 ? -nMax - 1 : nValue;
+}
+
+static inline uint64_t __SMLALD(uint32_t nX, uint32_t nY, uint64_t nAcc)
+{
+        return nAcc + (int64_t)((int16_t)nX * (int16_t)nY) + (int64_t)((int16_t)(nX >> 16) * (int16_t)(nY >> 16));
+}
+
+static inline int32_t __SMULWB(int32_t nA, uint32_t nB)
+{
+        return ((int64_t)nA * (int16_t)nB) >> 16;
+}
+
+static inline int32_t __SMULWT(int32_t nA, uint32_t nB)
+{
+        return ((int64_t)nA * (int16_t)(nB >> 16)) >> 16;
+}
+
+static inline uint32_t __PKHBT(uint32_t nA, uint32_t nB, int nShift)
+{
+        return (nA & 0xFFFF) | ((nB << nShift) & 0xFFFF0000);
+}
+#endif
+
+// The kernels and stages are static
+#include "../AudioFrontEnd.c"
+
+#define FRAME_SAMPLE            480
+#define SAMPLING_RATE           16000
+
+static int16_t g_saFrame[FRAME_SAMPLE + 1];
+static uint32_t g_nRandom = 1;
+static double g_fPhase;
+static int g_nFailures;
+
+#define CHECK(cond)                                                                     \
+        do {                                                                            \
+                if (!(cond)) {                                                          \
+                        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+                        g_nFailures++;                                                  \
+                }                                                                       \
+        } while (0)
+
+static uint32_t Random(uint32_t nRange)
+{
+        g_nRandom = g_nRandom * 1103515245 + 12345;
+        return (g_nRandom >> 16) % nRange;
+}
+
+/* Sine of nFrequency Hz continuing the previous frame, with uniform noise of nNoise peak */
+static void MakeFrame(int nDc, int nAmplitude, int nFrequency, int nNoise)
+{
+        for (int i = 0; i < FRAME_SAMPLE; i++) {
+                int32_t nValue = nDc + lrint(nAmplitude * sin(g_fPhase));
+
+                if (nNoise)
+                        nValue += (int32_t)Random(2 * nNoise + 1) - nNoise;
+                g_saFrame[i] = nValue;
+                g_fPhase += 2 * M_PI * nFrequency / SAMPLING_RATE;
+        }
+}
+
+static int32_t Peak(void)
+{
+        return FramePeak(g_saFrame, FRAME_SAMPLE);
+}
+
+static void TestKernels(void)
+{
+        static const int32_t naGain[] = { 1 << 16, 0x18000, 8 << 16, 0x7FFF, 3 };
+        int16_t saCopy[FRAME_SAMPLE + 1];
+
+        for (int nRun = 0; nRun < 200; nRun++) {
+                // Odd lengths leave one sample to the generic loop, full scale runs exercise the saturation
+                int nNumSample = nRun % 2 ? FRAME_SAMPLE + 1 : FRAME_SAMPLE;
+                int32_t nGain = naGain[nRun % 5];
+                int64_t nSum = 0;
+                int32_t nPeak = 0;
+
+                for (int i = 0; i < nNumSample; i++) {
+                        g_saFrame[i] = nRun % 4 == 3 ? (Random(2) ? INT16_MIN : INT16_MAX) : (int32_t)Random(65536) - 32768;
+                        nSum += (int32_t)g_saFrame[i] * g_saFrame[i];
+                        if (abs(g_saFrame[i]) > nPeak)
+                                nPeak = abs(g_saFrame[i]);
+                }
+                CHECK(FrameEnergy(g_saFrame, nNumSample) == (uint32_t)(nSum / nNumSample));
+                CHECK(FramePeak(g_saFrame, nNumSample) == nPeak);
+
+                memcpy(saCopy, g_saFrame, sizeof(saCopy));
+                FrameScale(g_saFrame, nNumSample, nGain);
+                for (int i = 0; i < nNumSample; i++) {
+                        int64_t nExpected = ((int64_t)nGain * saCopy[i]) >> 16;
+
+                        nExpected = nExpected > INT16_MAX ? INT16_MAX : nExpected < INT16_MIN ? INT16_MIN : nExpected;
+                        CHECK(g_saFrame[i] == nExpected);
+                }
+        }
+}
+
+static void TestHpf(void)
+{
+        HpfState state = { 0, 0, true };
+        AudioFrontEndFrame frame = { g_saFrame, FRAME_SAMPLE, false };
+
+        // DC is gone after a few frames
+        for (int i = 0; i < 20; i++) {
+                MakeFrame(8000, 0, 0, 0);
+                HpfProcess(&frame, &state);
+        }
+        CHECK(Peak() < 100);
+
+        // 1KHz is kept, the DC step back to 0 has settled too
+        for (int i = 0; i < 20; i++) {
+                MakeFrame(0, 10000, 1000, 0);
+                HpfProcess(&frame, &state);
+        }
+        CHECK(Peak() > 9500 && Peak() < 10500);
+
+        // Full scale steps saturate instead of wrapping around
+        for (int i = 0; i < FRAME_SAMPLE; i++)
+                g_saFrame[i] = i % 100 < 50 ? INT16_MAX : INT16_MIN;
+        HpfProcess(&frame, &state);
+        CHECK(g_saFrame[0] == INT16_MAX && g_saFrame[50] == INT16_MIN && g_saFrame[100] == INT16_MAX);
+}
+
+static void TestGate(void)
+{
+        GateState state = { AUDIO_FE_GATE_MIN_ENERGY, 0 };
+        AudioFrontEndFrame frame = { g_saFrame, FRAME_SAMPLE, false };
+        int nVoice = 0;
+
+        for (int i = 0; i < 100; i++) {
+                MakeFrame(0, 0, 0, 30);
+                GateProcess(&frame, &state);
+                nVoice += !frame.bSilent;
+        }
+        CHECK(nVoice == 0);
+
+        // Opens on the first voice frame
+        for (int i = 0; i < 20; i++) {
+                MakeFrame(0, 3000, 440, 30);
+                GateProcess(&frame, &state);
+                CHECK(!frame.bSilent);
+        }
+
+        // Stays open for the hangover, then closes
+        for (int i = 0; i < 40; i++) {
+                MakeFrame(0, 0, 0, 30);
+                GateProcess(&frame, &state);
+                CHECK(frame.bSilent == (i >= AUDIO_FE_GATE_HANGOVER));
+        }
+
+        // A steady noise ends up in the noise floor
+        nVoice = 0;
+        for (int i = 0; i < 600; i++) {
+                MakeFrame(0, 0, 0, 2000);
+                GateProcess(&frame, &state);
+                if (i >= 500)
+                        nVoice += !frame.bSilent;
+        }
+        CHECK(nVoice == 0);
+
+        // Voice over that noise still opens the gate
+        MakeFrame(0, 8000, 440, 2000);
+        GateProcess(&frame, &state);
+        CHECK(!frame.bSilent);
+
+        // Once the noise is gone, quieter voice opens it again
+        for (int i = 0; i < 20; i++) {
+                MakeFrame(0, 0, 0, 30);
+                GateProcess(&frame, &state);
+        }
+        CHECK(frame.bSilent);
+        MakeFrame(0, 600, 440, 30);
+        GateProcess(&frame, &state);
+        CHECK(!frame.bSilent);
+}
+
+static void TestAgc(void)
+{
+        AgcState state = { 1 << 16 };
+        AudioFrontEndFrame frame = { g_saFrame, FRAME_SAMPLE, false };
+        int32_t nGainQ16;
+
+        // Quiet voice is amplified up to the maximum gain, slowly
+        MakeFrame(0, 1000, 440, 0);
+        AgcProcess(&frame, &state);
+        CHECK(state.nGainQ16 > (1 << 16) && state.nGainQ16 < (2 << 16));
+        for (int i = 0; i < 100; i++) {
+                MakeFrame(0, 1000, 440, 0);
+                AgcProcess(&frame, &state);
+        }
+        CHECK(state.nGainQ16 > (AUDIO_FE_AGC_MAX_GAIN << 16) * 99 / 100 && state.nGainQ16 <= (AUDIO_FE_AGC_MAX_GAIN << 16));
+        CHECK(Peak() > 7900 && Peak() <= 8000);
+
+        // Silent frames keep the gain
+        nGainQ16 = state.nGainQ16;
+        frame.bSilent = true;
+        MakeFrame(0, 100, 440, 0);
+        AgcProcess(&frame, &state);
+        CHECK(state.nGainQ16 == nGainQ16);
+        frame.bSilent = false;
+
+        // Loud voice drops the gain within the frame, so it is not clipped
+        MakeFrame(0, 30000, 440, 0);
+        AgcProcess(&frame, &state);
+        CHECK(state.nGainQ16 == (1 << 16));
+        CHECK(Peak() == 30000);
+
+        // Voice peaking at the target is left alone
+        MakeFrame(0, AUDIO_FE_AGC_TARGET, 440, 0);
+        AgcProcess(&frame, &state);
+        CHECK(state.nGainQ16 == (1 << 16));
+}
+
+static void TestPipeline(void)
+{
+        int nVoice = 0;
+
+        AudioFrontEndInit();
+        for (int i = 0; i < 50; i++) {
+                MakeFrame(500, 0, 0, 30);
+                nVoice += AudioFrontEndProcess(g_saFrame, FRAME_SAMPLE);
+        }
+        CHECK(nVoice == 0);
+
+        // The voice is passed on, amplified
+        MakeFrame(500, 2000, 440, 30);
+        CHECK(AudioFrontEndProcess(g_saFrame, FRAME_SAMPLE));
+        for (int i = 0; i < 30; i++) {
+                MakeFrame(500, 2000, 440, 30);
+                CHECK(AudioFrontEndProcess(g_saFrame, FRAME_SAMPLE));
+        }
+        CHECK(Peak() > 2 * 2000);
+}
+
+/* Runs a capture through the front end, returns the number of frames or -1 */
+static int ProcessWav(const char *lpPath, int *pnVoice)
+{
+        FILE *f = fopen(lpPath, "rb");
+        uint8_t baHeader[44];
+        int nFrames = 0;
+
+        if (f == NULL || fread(baHeader, 1, sizeof(baHeader), f) != sizeof(baHeader)
+                || memcmp(baHeader, "RIFF", 4) || memcmp(&baHeader[8], "WAVE", 4)
+                || baHeader[22] != 1 || baHeader[34] != 16 || memcmp(&baHeader[36], "data", 4)) {
+                printf("%s: not a 16 bits mono WAV file\n", lpPath);
+                if (f)
+                        fclose(f);
+                return -1;
+        }
+
+        *pnVoice = 0;
+        AudioFrontEndInit();
+        while (fread(g_saFrame, sizeof(int16_t), FRAME_SAMPLE, f) == FRAME_SAMPLE) {
+                *pnVoice += AudioFrontEndProcess(g_saFrame, FRAME_SAMPLE);
+                nFrames++;
+        }
+        fclose(f);
+
+        return nFrames;
+}
+
+int main(int argc, char *argv[])
+{
+        TestKernels();
+        TestHpf();
+        TestGate();
+        TestAgc();
+        TestPipeline();
+
+        for (int i = 1; i < argc; i++) {
+                int nVoice;
+                int nFrames = ProcessWav(argv[i], &nVoice);
+
+                if (nFrames < 0) {
+                        g_nFailures++;
+                        continue;
+                }
+                printf("%s: %d frames, %d passed to the recognition\n", argv[i], nFrames, nVoice);
+        }
+
+#ifdef AUDIO_FE_USE_DSP
+        printf("DSP kernels: ");
+#else
+        printf("Generic kernels: ");
+#endif
+        printf(g_nFailures ? "FAILED\n" : "OK\n");
+        return g_nFailures ? 1 : 0;
+}
@@ -0,0 +1,208 @@
+/**
+ ****************************************************************************************
+ *
+ * @file FrameQueue_test.c
+ *
+ * @brief Host test of the frame queue against a simulated 16KHz microphone DMA
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run on the host:
+ *      gcc -Wall -Wextra -O2 -o FrameQueue_test FrameQueue_test.c ../Util/FrameQueue.c && ./FrameQueue_test
+ *
+ * The DMA writes one sample per tick into a circular buffer of frame slots, as the SDADC does at 16KHz, and
+ * the sample values count up. The consumer reads the frames in place with random processing times and
+ * stalls. A frame handed over must be complete, newer than the previous one and, if its release succeeds,
+ * untouched until then. Every frame recorded is either read intact or counted as lost.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Util/FrameQueue.h"
+
+#define FRAME_SAMPLE            480
+#define MAX_SLOTS               16
+
+static uint32_t g_naBuffer[MAX_SLOTS][FRAME_SAMPLE];
+static uint32_t g_nRandom = 1;
+static int g_nFailures;
+
+#define CHECK(cond)                                                                     \
+        do {                                                                            \
+                if (!(cond)) {                                                          \
+                        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+                        g_nFailures++;                                                  \
+                }                                                                       \
+        } while (0)
+
+static uint32_t Random(uint32_t nRange)
+{
+        g_nRandom = g_nRandom * 1103515245 + 12345;
+        return (g_nRandom >> 16) % nRange;
+}
+
+/* Frame number held by the slot, -1 if the slot does not hold one complete frame */
+static int64_t SlotFrame(int nSlot)
+{
+        uint32_t nFirst = g_naBuffer[nSlot][0];
+
+        if (nFirst % FRAME_SAMPLE)
+                return -1;
+        for (int i = 1; i < FRAME_SAMPLE; i++)
+                if (g_naBuffer[nSlot][i] != nFirst + i)
+                        return -1;
+        return nFirst / FRAME_SAMPLE;
+}
+
+static void TestPlainQueue(void)
+{
+        FrameQueue queue;
+        uint32_t naEntries[4];
+
+        FrameQueueInit(&queue, naEntries, 4);
+        CHECK(FrameQueuePeek(&queue) == -1);
+        for (uint32_t i = 0; i < 4; i++)
+                CHECK(FrameQueuePut(&queue, i));
+        CHECK(!FrameQueuePut(&queue, 4));
+        CHECK(FrameQueueGetCount(&queue) == 4);
+        for (int i = 0; i < 4; i++) {
+                CHECK(FrameQueuePeek(&queue) == i);
+                CHECK(FrameQueueRelease(&queue));
+        }
+        CHECK(FrameQueuePeek(&queue) == -1);
+}
+
+/*
+ * nStallFrames: the consumer does not read for so many frames at start, then stalls as long again every
+ * now and then.
+ */
+static void TestCircularQueue(uint32_t nSlots, uint32_t nQueueSize, uint32_t nStallFrames, uint32_t nFrames)
+{
+        FrameQueue queue;
+        uint32_t naEntries[MAX_SLOTS];
+        uint32_t nSample = 0;                   // Next sample written by the DMA
+        uint32_t nBusy = nStallFrames * FRAME_SAMPLE;
+        int nSlot = -1;                         // Slot being read by the consumer
+        int64_t nFrame = -1, nLastFrame = -1;
+        uint32_t nRead = 0;
+
+        memset(g_naBuffer, 0xFF, sizeof(g_naBuffer));
+        FrameQueueInitCircular(&queue, naEntries, nQueueSize, nSlots);
+
+        for (uint32_t nTick = 0; nTick < nFrames * FRAME_SAMPLE; nTick++) {
+                // DMA
+                uint32_t nDmaSlot = (nSample / FRAME_SAMPLE) % nSlots;
+
+                g_naBuffer[nDmaSlot][nSample % FRAME_SAMPLE] = nSample;
+                if (++nSample % FRAME_SAMPLE == 0)
+                        FrameQueueFilled(&queue, nDmaSlot, true);
+
+                // Consumer
+                if (nBusy > 0) {
+                        nBusy--;
+                        continue;
+                }
+                if (nSlot >= 0) {
+                        bool bIntact = SlotFrame(nSlot) == nFrame;
+
+                        // A frame reported intact must not have been touched by the DMA
+                        if (FrameQueueRelease(&queue)) {
+                                CHECK(bIntact);
+                                nRead++;
+                        }
+                        nSlot = -1;
+                }
+                nSlot = FrameQueuePeek(&queue);
+                if (nSlot < 0)
+                        continue;
+
+                // Complete, not being written and not read before
+                nFrame = SlotFrame(nSlot);
+                CHECK(nFrame >= 0);
+                CHECK(nFrame > nLastFrame);
+                CHECK((uint32_t)nSlot != (nSample / FRAME_SAMPLE) % nSlots);
+                nLastFrame = nFrame;
+
+                // Mostly faster than real time, sometimes slower, stalled from time to time
+                if (Random(200) == 0)
+                        nBusy = nStallFrames * FRAME_SAMPLE;
+                else if (Random(8) == 0)
+                        nBusy = FRAME_SAMPLE + Random(FRAME_SAMPLE);
+                else
+                        nBusy = Random(FRAME_SAMPLE / 2);
+        }
+
+        // The DMA stops, whatever is left in the queue is read
+        if (nSlot >= 0) {
+                bool bIntact = SlotFrame(nSlot) == nFrame;
+
+                if (FrameQueueRelease(&queue)) {
+                        CHECK(bIntact);
+                        nRead++;
+                }
+        }
+        while ((nSlot = FrameQueuePeek(&queue)) >= 0) {
+                nFrame = SlotFrame(nSlot);
+                CHECK(nFrame > nLastFrame);
+                nLastFrame = nFrame;
+                if (FrameQueueRelease(&queue))
+                        nRead++;
+        }
+
+        printf("%2u slots, stalls of %2u frames: %u frames, %u read, %u lost\n", (unsigned)nSlots,
+               (unsigned)nStallFrames, (unsigned)nFrames, (unsigned)nRead, (unsigned)FrameQueueGetLostCount(&queue));
+        CHECK(nRead + FrameQueueGetLostCount(&queue) == nFrames);
+}
+
+/* The DMA restarts at another slot, e.g. after a callback was missed */
+static void TestSkippedSlot(void)
+{
+        FrameQueue queue;
+        uint32_t naEntries[8];
+
+        FrameQueueInitCircular(&queue, naEntries, 8, 6);
+        CHECK(FrameQueueFilled(&queue, 0, true));
+        CHECK(FrameQueueFilled(&queue, 2, true));
+        CHECK(FrameQueuePeek(&queue) == 0);
+        CHECK(FrameQueueRelease(&queue));
+        CHECK(FrameQueuePeek(&queue) == 2);
+        // Slots 3, 4, 5, 0 and 1 are filled, the DMA is back at slot 2 while it is read
+        for (uint32_t i = 3; i < 8; i++)
+                FrameQueueFilled(&queue, i % 6, true);
+        CHECK(!FrameQueueRelease(&queue));
+        CHECK(FrameQueuePeek(&queue) == 3);
+}
+
+int main(void)
+{
+        TestPlainQueue();
+        TestSkippedSlot();
+        TestCircularQueue(6, 8, 9, 20000);
+        TestCircularQueue(6, 8, 3, 20000);
+        TestCircularQueue(16, 16, 9, 20000);
+        TestCircularQueue(16, 16, 20, 20000);
+
+        printf(g_nFailures ? "FAILED\n" : "OK\n");
+        return g_nFailures ? 1 : 0;
+}
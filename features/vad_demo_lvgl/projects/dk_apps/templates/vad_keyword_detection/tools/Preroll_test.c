@@ -0,0 +1,282 @@
+/**
+ ****************************************************************************************
+ *
+ * @file Preroll_test.c
+ *
+ * @brief Host test of the pre-roll handed over to the recognition on VAD wake-up
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run on the host:
+ *      gcc -Wall -Wextra -O2 -o Preroll_test Preroll_test.c ../Util/FrameQueue.c -lm && ./Preroll_test [speech.wav]
+ *
+ * A recording (16KHz, 16 bits, mono WAV, e.g. a capture of dump2wav.py) is played into a simulated microphone
+ * DMA, a synthetic utterance if none is given. The frames are handled as analog_mic_mem_cb() and
+ * AudioRecordStart() of AudioRecord.c do with AUDIO_PREROLL_MS set to 300: while the VAD listens they are only
+ * counted as history, on wake-up FrameQueuePutHistory() queues the history ahead of the live frames. The VAD
+ * wakes the system at a growing offset after the start of the speech. The frames read by the recognition must
+ * follow each other without a gap up to the end of the recording, and for offsets up to AUDIO_PREROLL_MS they
+ * must start before the speech does. The speech lost without the pre-roll, where the microphone is opened on
+ * wake-up, is printed next to it.
+ */
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Util/FrameQueue.h"
+
+// As in AudioRecord.c
+#define SAMPLING_RATE           16000
+#define FRAME_SAMPLE            480
+#define PREROLL_MS              300
+#define PREROLL_FRAMES          ((PREROLL_MS * (SAMPLING_RATE / 1000) + FRAME_SAMPLE - 1) / FRAME_SAMPLE)
+#define FRAME_SLOTS             (PREROLL_FRAMES + 6)
+#define FRAME_QUEUE_SIZE        ((FRAME_SLOTS) <= 8 ? 8 : 16)
+
+#define MAX_SAMPLES             (60 * SAMPLING_RATE)
+#define MS_SAMPLES(ms)          ((ms) * (SAMPLING_RATE / 1000))
+
+static int16_t g_saRecording[MAX_SAMPLES];
+static int16_t g_saSlots[FRAME_SLOTS][FRAME_SAMPLE];
+static uint32_t g_naSlotStart[FRAME_SLOTS];     // Sample of the recording the slot starts with
+static uint32_t g_nRandom = 1;
+static int g_nFailures;
+
+#define CHECK(cond)                                                                     \
+        do {                                                                            \
+                if (!(cond)) {                                                          \
+                        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+                        g_nFailures++;                                                  \
+                }                                                                       \
+        } while (0)
+
+static uint32_t Random(uint32_t nRange)
+{
+        g_nRandom = g_nRandom * 1103515245 + 12345;
+        return (g_nRandom >> 16) % nRange;
+}
+
+/* Returns the number of samples or -1 */
+static int LoadWav(const char *lpPath)
+{
+        FILE *f = fopen(lpPath, "rb");
+        uint8_t baHeader[44];
+        int nSamples;
+
+        if (f == NULL || fread(baHeader, 1, sizeof(baHeader), f) != sizeof(baHeader)
+                || memcmp(baHeader, "RIFF", 4) || memcmp(&baHeader[8], "WAVE", 4)
+                || baHeader[22] != 1 || baHeader[34] != 16 || memcmp(&baHeader[36], "data", 4)
+                || (baHeader[24] | baHeader[25] << 8) != SAMPLING_RATE) {
+                printf("%s: not a 16KHz 16 bits mono WAV file\n", lpPath);
+                if (f)
+                        fclose(f);
+                return -1;
+        }
+
+        nSamples = fread(g_saRecording, sizeof(int16_t), MAX_SAMPLES, f);
+        fclose(f);
+
+        return nSamples;
+}
+
+/* 1s of background noise, a 600ms voiced word and 400ms of noise */
+static int MakeUtterance(void)
+{
+        int nSamples = MS_SAMPLES(2000);
+
+        for (int i = 0; i < nSamples; i++) {
+                double fVoice = 0;
+                int nWord = i - MS_SAMPLES(1000);
+
+                if (nWord >= 0 && nWord < MS_SAMPLES(600)) {
+                        double fEnvelope = fmin(1.0, nWord / (double)MS_SAMPLES(20));
+
+                        for (int h = 1; h <= 5; h++)
+                                fVoice += sin(2 * M_PI * 140 * h * i / SAMPLING_RATE) / h;
+                        fVoice *= 4000 * fEnvelope;
+                }
+                g_saRecording[i] = (int16_t)(fVoice + (int)Random(41) - 20);
+        }
+
+        return nSamples;
+}
+
+/* First sample of the first 10ms window within 18dB of the loudest one */
+static int SpeechStart(int nSamples)
+{
+        int nWindow = MS_SAMPLES(10);
+        double fPeak = 0;
+
+        for (int pass = 0; pass < 2; pass++) {
+                for (int i = 0; i + nWindow <= nSamples; i += nWindow) {
+                        double fEnergy = 0;
+
+                        for (int j = i; j < i + nWindow; j++)
+                                fEnergy += (double)g_saRecording[j] * g_saRecording[j];
+                        if (pass == 0 && fEnergy > fPeak)
+                                fPeak = fEnergy;
+                        else if (pass == 1 && fEnergy * 64 >= fPeak)
+                                return i;
+                }
+        }
+
+        return 0;
+}
+
+/* Whether the slot still holds the frame starting at nStart */
+static bool SlotIntact(int nSlot, uint32_t nStart)
+{
+        return g_naSlotStart[nSlot] == nStart
+                && !memcmp(g_saSlots[nSlot], &g_saRecording[nStart], sizeof(g_saSlots[nSlot]));
+}
+
+/*
+ * Plays the recording and wakes the recognition at nWake. With bPreroll the microphone records from the start,
+ * otherwise from nWake on. Returns the first sample of the recording read by the recognition, -1 if none.
+ */
+static int Run(int nSamples, int nWake, bool bPreroll)
+{
+        FrameQueue queue;
+        uint32_t naEntries[FRAME_QUEUE_SIZE];
+        bool bListening = true;                 // The VAD listens, frames are only kept as history
+        int nHistoryFrames = 0;
+        int nFirst = -1, nNext = -1;            // Sample the next frame read must start with
+        int nSlot = -1;                         // Slot being read by the recognition
+        uint32_t nStart = 0;
+        uint32_t nBusy = 0;
+        int nDma = 0;                           // Next sample written by the DMA
+        int nBegin = bPreroll ? 0 : nWake;
+
+        FrameQueueInitCircular(&queue, naEntries, FRAME_QUEUE_SIZE, FRAME_SLOTS);
+
+        for (int nTick = nBegin; nTick < nSamples; nTick++) {
+                // AudioRecordStart() on VAD wake-up
+                if (nTick == nWake) {
+                        FrameQueuePutHistory(&queue, nHistoryFrames);
+                        bListening = false;
+                }
+
+                // DMA and analog_mic_mem_cb()
+                int nDmaSlot = (nDma / FRAME_SAMPLE) % FRAME_SLOTS;
+
+                if (nDma % FRAME_SAMPLE == 0)
+                        g_naSlotStart[nDmaSlot] = nTick;
+                g_saSlots[nDmaSlot][nDma % FRAME_SAMPLE] = g_saRecording[nTick];
+                if (++nDma % FRAME_SAMPLE == 0) {
+                        if (bListening) {
+                                FrameQueueFilled(&queue, nDmaSlot, false);
+                                if (nHistoryFrames < PREROLL_FRAMES)
+                                        nHistoryFrames++;
+                        } else {
+                                CHECK(FrameQueueFilled(&queue, nDmaSlot, true));
+                        }
+                }
+
+                // Recognition, which catches up with the history faster than real time
+                if (bListening)
+                        continue;
+                if (nBusy > 0) {
+                        nBusy--;
+                        continue;
+                }
+                if (nSlot >= 0) {
+                        bool bIntact = SlotIntact(nSlot, nStart);
+
+                        CHECK(FrameQueueRelease(&queue));
+                        CHECK(bIntact);
+                        nSlot = -1;
+                }
+                nSlot = FrameQueuePeek(&queue);
+                if (nSlot < 0)
+                        continue;
+
+                nStart = g_naSlotStart[nSlot];
+                if (nFirst < 0)
+                        nFirst = nNext = nStart;
+                CHECK(nStart == (uint32_t)nNext);
+                nNext = nStart + FRAME_SAMPLE;
+                nBusy = FRAME_SAMPLE / 4 + Random(FRAME_SAMPLE / 2);
+        }
+
+        // The recording ends, whatever is left in the queue is read
+        if (nSlot >= 0) {
+                CHECK(SlotIntact(nSlot, nStart));
+                CHECK(FrameQueueRelease(&queue));
+        }
+        while ((nSlot = FrameQueuePeek(&queue)) >= 0) {
+                nStart = g_naSlotStart[nSlot];
+                if (nFirst < 0)
+                        nFirst = nNext = nStart;
+                CHECK(nStart == (uint32_t)nNext);
+                CHECK(SlotIntact(nSlot, nStart));
+                CHECK(FrameQueueRelease(&queue));
+                nNext = nStart + FRAME_SAMPLE;
+        }
+
+        // Nothing is lost up to the last complete frame
+        CHECK(FrameQueueGetLostCount(&queue) == 0);
+        CHECK(nNext == nBegin + (nSamples - nBegin) / FRAME_SAMPLE * FRAME_SAMPLE);
+
+        return nFirst;
+}
+
+int main(int argc, char *argv[])
+{
+        int nSamples = argc > 1 ? LoadWav(argv[1]) : MakeUtterance();
+        int nSpeech;
+
+        if (nSamples < 0)
+                return 1;
+
+        nSpeech = SpeechStart(nSamples);
+        printf("%s: speech starts at %d ms, pre-roll of %d ms (%d frames)\n", argc > 1 ? argv[1] : "Synthetic utterance",
+               nSpeech / MS_SAMPLES(1), PREROLL_MS, PREROLL_FRAMES);
+        printf("VAD wake-up after [ms]   speech lost with pre-roll [ms]   without [ms]\n");
+
+        for (int nOffset = 0; nOffset <= PREROLL_MS + 150; nOffset += 10) {
+                // Wake-up anywhere within the DMA frame
+                int nWake = nSpeech + MS_SAMPLES(nOffset) + Random(MS_SAMPLES(10));
+                int nFirst, nFirstLive, nLost, nLostLive;
+
+                if (nWake + FRAME_SAMPLE > nSamples)
+                        break;
+
+                nFirst = Run(nSamples, nWake, true);
+                nFirstLive = Run(nSamples, nWake, false);
+                nLost = nFirst > nSpeech ? nFirst - nSpeech : 0;
+                nLostLive = nFirstLive > nSpeech ? nFirstLive - nSpeech : 0;
+
+                // The history covers the speech as long as the VAD wakes up within the pre-roll
+                if (nWake - nSpeech <= MS_SAMPLES(PREROLL_MS))
+                        CHECK(nLost == 0);
+
+                if (nOffset % 50 == 0)
+                        printf("%22d %32d %14d\n", (nWake - nSpeech) / MS_SAMPLES(1), nLost / MS_SAMPLES(1),
+                               nLostLive / MS_SAMPLES(1));
+        }
+
+        printf(g_nFailures ? "FAILED\n" : "OK\n");
+        return g_nFailures ? 1 : 0;
+}
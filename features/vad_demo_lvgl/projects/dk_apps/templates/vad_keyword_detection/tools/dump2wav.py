@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+#
+# Turns a raw capture of the audio UART of vad_keyword_detection, built with
+# SUPPORT_UART_DUMP_RECORD, into a 16KHz mono 16-bit WAV file. AudioDump.c
+# sends each frame as a header ('V', 'D' and a 16-bit sequence number) and 480
+# samples, in groups of four data bytes followed by a checksum, the inverted
+# XOR of the four bytes. A frame with a bad checksum is discarded. Discarded
+# frames and frames missing from the sequence, e.g. dropped on the device, are
+# replaced with silence so that the timing of the capture is kept.
+#
+# Usage: dump2wav.py <capture.bin> <output.wav>
+#
+
+import sys
+import wave
+
+SAMPLE_RATE = 16000
+FRAME_SAMPLE = 480
+GROUP_SIZE = 5
+FRAME_GROUPS = FRAME_SAMPLE * 2 // 4
+FRAME_SIZE = GROUP_SIZE * (1 + FRAME_GROUPS)
+SILENCE = bytes(FRAME_SAMPLE * 2)
+
+
+def group_valid(data, i):
+        return (data[i] ^ data[i + 1] ^ data[i + 2] ^ data[i + 3] ^ 0xFF) == data[i + 4]
+
+
+def header_at(data, i):
+        return data[i] == ord('V') and data[i + 1] == ord('D') and group_valid(data, i)
+
+
+def decode(data):
+        pcm = bytearray()
+        frames = 0
+        discarded = 0
+        missing = 0
+        skipped = 0
+        last_seq = None
+        i = 0
+
+        while i + FRAME_SIZE <= len(data):
+                if not header_at(data, i):
+                        i += 1
+                        skipped += 1
+                        continue
+
+                groups = range(i + GROUP_SIZE, i + FRAME_SIZE, GROUP_SIZE)
+                if not all(group_valid(data, g) for g in groups):
+                        # The samples are lost, their place is known from the next sequence number
+                        discarded += 1
+                        i += GROUP_SIZE
+                        continue
+
+                seq = data[i + 2] | data[i + 3] << 8
+                if last_seq is not None:
+                        gap = (seq - last_seq - 1) & 0xFFFF
+                        missing += gap
+                        pcm += SILENCE * gap
+                last_seq = seq
+
+                for g in groups:
+                        pcm += data[g:g + 4]
+                frames += 1
+                i += FRAME_SIZE
+
+        skipped += len(data) - i
+        return pcm, frames, discarded, missing, skipped
+
+
+def main():
+        if len(sys.argv) != 3:
+                print('Usage: %s <capture.bin> <output.wav>' % sys.argv[0])
+                return 1
+
+        with open(sys.argv[1], 'rb') as f:
+                data = f.read()
+
+        pcm, frames, discarded, missing, skipped = decode(data)
+
+        with wave.open(sys.argv[2], 'wb') as w:
+                w.setnchannels(1)
+                w.setsampwidth(2)
+                w.setframerate(SAMPLE_RATE)
+                w.writeframes(bytes(pcm))
+
+        print('%s: %.2f s of audio, %d frames decoded, %d discarded as corrupt, %d missing from the sequence '
+              '(silence, discarded ones included), %d bytes skipped' %
+              (sys.argv[2], len(pcm) / 2 / SAMPLE_RATE, frames, discarded, missing, skipped))
+        return 0 if frames else 1
+
+
+if __name__ == '__main__':
+        sys.exit(main())
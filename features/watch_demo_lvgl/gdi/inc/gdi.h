@@ -83,6 +83,15 @@ typedef struct {
  */
 typedef void (*draw_callback)(bool underflow, void *user_data);
 
+/**
+ * Callback function for the completion of an asynchronous DMA copy, called from the GDI task
+ *
+ * \param[in] user_data         User data as provided with the copy function
+ *
+ * \sa gdi_dma_copy_async()
+ */
+typedef void (*gdi_dma_callback)(void *user_data);
+
 /**
  * Callback function for storing touch events into the graphics buffers
  *
@@ -692,6 +701,39 @@ void gdi_memcpy_2d(void *dst, const void *src, size_t length, int dst_step, int
  */
 void gdi_buffer_memcpy(HW_LCDC_LAYER dst_layer, uint8_t dst, HW_LCDC_LAYER src_layer, uint8_t src);
 
+/**
+ * \brief Submit an asynchronous 2D DMA copy
+ *
+ * The copy is queued and started on the first free one of the DMA channels reserved for GDI, so
+ * that the CPU is free while it runs. Copies on different channels run in parallel. \p reps rows
+ * of \p length bytes are copied, the addresses are increased by the provided steps after each row.
+ * The function blocks only while the queue is full. Copies longer than the DMA length register
+ * allows are split into several queued copies. Callbacks are called in the order the copies were
+ * submitted.
+ *
+ * \note Must not be called from the GDI task, e.g. from a draw or DMA callback. The queue is
+ *       emptied by the GDI task, which would wait for itself once the queue is full.
+ *
+ * \param[out] dst      Destination address
+ * \param[in] src       Source address
+ * \param[in] length    Length in bytes of each row
+ * \param[in] dst_step  Increase step of the destination address after each row
+ * \param[in] src_step  Increase step of the source address after each row
+ * \param[in] reps      Number of rows
+ * \param[in] cb        Callback function to be called once the copy is done, can be NULL. It runs
+ *                      in the GDI task and must not block or update the display.
+ * \param[in] user_data User-defined data to be passed in the callback function
+ */
+void gdi_dma_copy_async(void *dst, const void *src, size_t length, int dst_step, int src_step, size_t reps,
+        gdi_dma_callback cb, void *user_data);
+
+/**
+ * \brief Wait until all the submitted DMA copies are done and their callbacks have returned
+ *
+ * \note Must not be called from the GDI task, e.g. from a draw or DMA callback.
+ */
+void gdi_dma_wait(void);
+
 /**
  * \brief Set output color mode
  *
@@ -804,6 +846,11 @@ void gdi_perf_render_op_end(void);
  */
 void gdi_perf_render_op_time(int time_us, uint8_t tag);
 
+/**
+ * \brief Counts a render buffer submitted to the GPU in the current frame (used for performance measurements)
+ */
+void gdi_perf_render_submit(void);
+
 /**
  * \brief Indicates that render operation for current screen has started (used for performance measurements)
  */
@@ -845,6 +892,20 @@ void gdi_perf_transfer_time(int time_us);
  */
 void gdi_perf_transfer_last(bool last);
 
+/**
+ * brief Provides time spent to open or close the LCD controller for the current screen (used for performance measurements)
+ *
+ * \param[in] time_us   Measured time in micro seconds
+ */
+void gdi_perf_transfer_open_time(int time_us);
+
+/**
+ * brief Provides the time the DMA channels spent on copies since the last call (used for performance measurements)
+ *
+ * \return Time in micro seconds
+ */
+int gdi_perf_dma_time(void);
+
 #endif /* dg_configLCDC_ADAPTER */
 
 #endif /* GDI_H_ */
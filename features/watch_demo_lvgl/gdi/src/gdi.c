@@ -140,10 +140,48 @@
 #define GDI_MULTIPLEX_TOUCH_DISPLAY             (0)
 #endif
 
+/*
+ * Time (in msec) for which the LCDC stays open after an asynchronous frame update, so that
+ * frames following each other do not pay for opening and closing the display. 0: The display
+ * is opened and closed for every frame.
+ */
+#ifndef GDI_DISPLAY_SESSION_IDLE_MS
+#define GDI_DISPLAY_SESSION_IDLE_MS             (0)
+#endif
+
+#if (GDI_DISPLAY_SESSION_IDLE_MS > 0) && !GDI_USE_CONTINUOUS_MODE && !GDI_MULTIPLEX_TOUCH_DISPLAY && !defined(OS_BAREMETAL)
+#define GDI_DISPLAY_SESSION                     (1)
+#else
+#define GDI_DISPLAY_SESSION                     (0)
+#endif
+
+/*
+ * DMA channels used by the copy engine, starting from GDI_DMA_FIRST_CHANNEL. The submitted copies
+ * are spread over them and run in parallel.
+ */
+#ifndef GDI_DMA_FIRST_CHANNEL
+#define GDI_DMA_FIRST_CHANNEL                   (HW_DMA_CHANNEL_0)
+#endif
+
+#ifndef GDI_DMA_CHANNELS
+#define GDI_DMA_CHANNELS                        (2)
+#endif
+
+/* Number of copies that can be pending before gdi_dma_copy_async() blocks */
+#ifndef GDI_DMA_QUEUE_LEN
+#define GDI_DMA_QUEUE_LEN                       (8)
+#endif
+
+/* Transfers of one DMA run, the DMA length register holds 16 bits */
+#define GDI_DMA_MAX_TRANSFERS                   (0x10000)
+
 /* Notification bit-masks */
 #define DEV_DRAW_ASYNC_EVT                      (1 << 0)
 #define DEV_DRAW_ASYNC_CMPL_EVT                 (1 << 1)
 #define DEV_TOUCH_EVT                           (1 << 2)
+#define DEV_DISPLAY_IDLE_EVT                    (1 << 3)
+#define DEV_DMA_CMPL_EVT                        (1 << 4)
+#define DEV_DISPLAY_RESET_EVT                   (1 << 5)
 
 #if GDI_USE_CONTINUOUS_MODE
 #define DISPLAY_MUTEX_GET() OS_MUTEX_GET(gdi->block_mutex_display_status, OS_MUTEX_FOREVER)
@@ -164,15 +202,35 @@
 #error "QSPI RAM must be enabled in order to place frame buffer or heap!"
 #endif
 
+typedef enum {
+        GDI_DMA_JOB_FREE,
+        GDI_DMA_JOB_NEW,                /* Being submitted, the channels are acquired */
+        GDI_DMA_JOB_QUEUED,
+        GDI_DMA_JOB_ACTIVE,
+        GDI_DMA_JOB_DONE,               /* The callback is still to be called */
+} gdi_dma_job_state_t;
+
 typedef struct {
         uint32_t dst;
         uint32_t src;
+        size_t length;
         int dst_step;
         int src_step;
         int reps;
-        resource_mask_t res;
+        gdi_dma_callback cb;
+        void *user_data;
+        volatile gdi_dma_job_state_t state;
+} gdi_dma_job_t;
+
+typedef struct {
+        gdi_dma_job_t *job;             /* Copy in progress, NULL if the channel is idle */
+        uint32_t dst;
+        uint32_t src;
+        int reps;                       /* Rows left */
         DMA_setup dma;
-        gdi_t *gdi;
+#ifdef PERFORMANCE_METRICS
+        uint64_t start;
+#endif
 } gdi_dma_t;
 
 #if (!GDI_FB_USE_QSPI_RAM) && (GDI_NO_PREALLOC == 0)
@@ -190,9 +248,29 @@ PRIVILEGED_DATA static OS_TASK task_h;
 PRIVILEGED_DATA OS_TIMER draw_async_timer_h;
 #endif
 
+/* Copies are submitted in ring order and started on the channels in the same order */
+PRIVILEGED_DATA static gdi_dma_job_t dma_jobs[GDI_DMA_QUEUE_LEN];
+PRIVILEGED_DATA static gdi_dma_t dma_channels[GDI_DMA_CHANNELS];
+PRIVILEGED_DATA static uint8_t dma_job_head;
+PRIVILEGED_DATA static uint8_t dma_job_next;
+PRIVILEGED_DATA static bool dma_acquired;
+#ifndef OS_BAREMETAL
+PRIVILEGED_DATA static OS_MUTEX dma_mutex;
+#endif
+#ifdef PERFORMANCE_METRICS
+PRIVILEGED_DATA static uint64_t dma_busy_ticks;
+#endif
+
+#if GDI_DISPLAY_SESSION
+PRIVILEGED_DATA static OS_MUTEX display_session_mutex;
+PRIVILEGED_DATA static OS_TIMER display_idle_timer_h;
+PRIVILEGED_DATA static bool display_session;
+#endif
+
 #if GDI_CONSOLE_LOG
 PRIVILEGED_DATA static uint64_t frame_render_op_start, frame_render_op_end, frame_render_start, frame_render_end, frame_transfer_start, frame_transfer_end;
 PRIVILEGED_DATA static int frame_render_op_duration_us, frame_render_duration_us, frame_transfer_duration_us, frame_total_duration_us;
+PRIVILEGED_DATA static int frame_display_open_duration_us;
 PRIVILEGED_DATA static bool transfer_last;
 #endif
 
@@ -200,6 +278,9 @@ void *_gdi_get_frame_buffer_addr(void);
 #ifndef OS_BAREMETAL
 static void frame_update_async_cb(AD_LCDC_ERROR status, void *cb_data);
 #endif
+static void dma_setup(DMA_setup *dma, HW_DMA_CHANNEL ch);
+static void dma_cb(void *user_data, dma_size_t len);
+static void dev_dma_cmpl_evt(void);
 
 #ifdef PERFORMANCE_METRICS
 static int pixel_count;
@@ -295,10 +376,12 @@ static void console_log(void)
                 metrics.frame_rendering_time = frame_render_duration_us;
                 metrics.display_transfer_time = frame_transfer_duration_us;
                 metrics.pixel_count = pixel_count;
+                metrics.display_open_time = frame_display_open_duration_us;
                 metrics_add(&metrics);
 
                 /* Clear variables */
                 frame_render_duration_us = frame_transfer_duration_us = frame_total_duration_us = 0;
+                frame_display_open_duration_us = 0;
         }
 
 #if !defined(PERFORMANCE_METRICS)
@@ -344,6 +427,13 @@ void gdi_perf_render_op_time(int time_us, uint8_t tag)
 #endif
 }
 
+void gdi_perf_render_submit(void)
+{
+#ifdef PERFORMANCE_METRICS
+        metrics_gpu_submit();
+#endif
+}
+
 void gdi_perf_render_start(void)
 {
 #ifdef PERFORMANCE_METRICS
@@ -419,6 +509,46 @@ void gdi_perf_transfer_last(bool last)
 #endif
 }
 
+void gdi_perf_transfer_open_time(int time_us)
+{
+#ifdef PERFORMANCE_METRICS
+        frame_display_open_duration_us += time_us;
+#endif
+}
+
+int gdi_perf_dma_time(void)
+{
+#ifdef PERFORMANCE_METRICS
+        uint64_t ticks;
+
+        OS_ENTER_CRITICAL_SECTION();
+        ticks = dma_busy_ticks;
+        dma_busy_ticks = 0;
+        OS_LEAVE_CRITICAL_SECTION();
+
+        return gdi_convert_ticks_to_us(ticks);
+#else
+        return 0;
+#endif
+}
+
+#if GDI_DISPLAY_SESSION
+/* The LCDC is also opened from interrupt context to recover from errors, where no lock is needed */
+static void display_session_lock(void)
+{
+        if (!in_interrupt()) {
+                OS_MUTEX_GET(display_session_mutex, OS_MUTEX_FOREVER);
+        }
+}
+
+static void display_session_unlock(void)
+{
+        if (!in_interrupt()) {
+                OS_MUTEX_PUT(display_session_mutex);
+        }
+}
+#endif /* GDI_DISPLAY_SESSION */
+
 static void dev_open_display(void)
 {
         if (gdi->continuous_mode_enable_current) {
@@ -427,6 +557,17 @@ static void dev_open_display(void)
                 return;
         }
 
+#if GDI_DISPLAY_SESSION
+        display_session_lock();
+        if (gdi->display_h != NULL) {
+                /* Use the device of the open display session */
+                return;
+        }
+#endif
+#ifdef PERFORMANCE_METRICS
+        uint64_t open_start = gdi_get_sys_uptime_ticks();
+#endif
+
 #if GDI_MULTIPLEX_TOUCH_DISPLAY
         OS_MUTEX_GET(gdi->block_mutex_multiplex_display_touch, OS_MUTEX_FOREVER);
 #endif
@@ -439,6 +580,10 @@ static void dev_open_display(void)
 #endif /* dg_configLCDC_TEST_APP */
         OS_ASSERT(dev != NULL);
         gdi->display_h = dev;
+
+#ifdef PERFORMANCE_METRICS
+        gdi_perf_transfer_open_time(gdi_convert_ticks_to_us(gdi_get_sys_uptime_ticks() - open_start));
+#endif
 }
 
 static void dev_close_display(void)
@@ -452,6 +597,17 @@ static void dev_close_display(void)
                 return;
         }
 
+#if GDI_DISPLAY_SESSION
+        if (display_session) {
+                /* Keep the device open until the display session becomes idle */
+                display_session_unlock();
+                return;
+        }
+#endif
+#ifdef PERFORMANCE_METRICS
+        uint64_t close_start = gdi_get_sys_uptime_ticks();
+#endif
+
         ad_lcdc_handle_t handle = gdi->display_h;
         gdi->display_h = NULL;
 
@@ -474,7 +630,50 @@ static void dev_close_display(void)
 #if GDI_MULTIPLEX_TOUCH_DISPLAY
         OS_MUTEX_PUT(gdi->block_mutex_multiplex_display_touch);
 #endif
+
+#ifdef PERFORMANCE_METRICS
+        gdi_perf_transfer_open_time(gdi_convert_ticks_to_us(gdi_get_sys_uptime_ticks() - close_start));
+#endif
+#if GDI_DISPLAY_SESSION
+        display_session_unlock();
+#endif
+}
+
+#if GDI_DISPLAY_SESSION
+static void dev_display_session_close(void)
+{
+        display_session_lock();
+        if (!display_session) {
+                display_session_unlock();
+                return;
+        }
+
+        display_session = false;
+
+        /* Closes the device and releases the lock */
+        dev_close_display();
+}
+
+/* Closes and reopens the device of the open display session to recover the LCDC from an error */
+static void dev_display_session_reset(void)
+{
+        display_session_lock();
+        if (gdi->display_h == NULL) {
+                /* The session has already been closed, the next frame opens the device again */
+                display_session_unlock();
+                return;
+        }
+
+        bool session = display_session;
+
+        display_session = false;
+        /* Closes the device and releases the lock */
+        dev_close_display();
+        dev_open_display();
+        display_session = session;
+        display_session_unlock();
 }
+#endif /* GDI_DISPLAY_SESSION */
 
 #if GDI_TOUCH_ENABLE
 static void dev_open_touch(void)
@@ -528,6 +727,17 @@ static void handle_error(int error)
         case AD_LCDC_ERROR_LLD_ERROR: {
                 int code = ad_lcdc_get_lld_status(gdi->display_h);
                 printf("Return: %X (%d)\r\n", code, code);
+#if GDI_DISPLAY_SESSION
+                if (display_session) {
+                        /* The device of a display session cannot be closed from interrupt context */
+                        if (in_interrupt()) {
+                                OS_TASK_NOTIFY_FROM_ISR(task_h, DEV_DISPLAY_RESET_EVT, OS_NOTIFY_SET_BITS);
+                        } else {
+                                dev_display_session_reset();
+                        }
+                        break;
+                }
+#endif
                 dev_close_display();
                 dev_open_display();
                 break;
@@ -803,6 +1013,10 @@ static void draw_async_cmpl(AD_LCDC_ERROR status, void *user_data)
         gdi_perf_transfer_end();
 
         dev_close_display();
+#if GDI_DISPLAY_SESSION
+        /* Close the display if no other frame follows within the idle time */
+        OS_TIMER_RESET(display_idle_timer_h, OS_TIMER_FOREVER);
+#endif
 
         DISPLAY_MUTEX_PUT();
         dev_draw_async_signal();
@@ -814,7 +1028,13 @@ void dev_draw_async_evt(void)
         DISPLAY_MUTEX_GET();
 
         if (!gdi->continuous_mode_enable_current) {
+#if GDI_DISPLAY_SESSION
+                OS_TIMER_STOP(display_idle_timer_h, OS_TIMER_FOREVER);
+#endif
                 dev_open_display();
+#if GDI_DISPLAY_SESSION
+                display_session = true;
+#endif
 #ifdef GDI_DISP_PRE_DRAW
                 GDI_DISP_PRE_DRAW(gdi, gdi->display_h, &gdi->active_layer);
 #endif /* GDI_DISP_PRE_DRAW */
@@ -952,6 +1172,14 @@ static void draw_async_timer_cb(OS_TIMER timer)
         OS_TASK_NOTIFY(task, DEV_DRAW_ASYNC_CMPL_EVT, OS_NOTIFY_SET_BITS);
 }
 
+#if GDI_DISPLAY_SESSION
+static void display_idle_timer_cb(OS_TIMER timer)
+{
+        OS_TASK task = (OS_TASK)OS_TIMER_GET_TIMER_ID(timer);
+        OS_TASK_NOTIFY(task, DEV_DISPLAY_IDLE_EVT, OS_NOTIFY_SET_BITS);
+}
+#endif
+
 static void gdi_task(void *pvParameters)
 {
         int8_t wdog_id;
@@ -962,6 +1190,12 @@ static void gdi_task(void *pvParameters)
                                                                                           draw_async_timer_cb);
         OS_ASSERT(draw_async_timer_h);
 
+#if GDI_DISPLAY_SESSION
+        display_idle_timer_h = OS_TIMER_CREATE("DISP_IDLE", OS_MS_2_TICKS(GDI_DISPLAY_SESSION_IDLE_MS), OS_TIMER_FAIL,
+                                                                                 (void *)OS_GET_CURRENT_TASK(),
+                                                                                          display_idle_timer_cb);
+        OS_ASSERT(display_idle_timer_h);
+#endif
 
         /* Register Wearable Sleep Quality task to be monitored by watchdog */
         wdog_id = sys_watchdog_register(false);
@@ -988,6 +1222,17 @@ static void gdi_task(void *pvParameters)
                         dev_draw_async_evt();
                 }
 
+                if (notif & DEV_DMA_CMPL_EVT) {
+                        dev_dma_cmpl_evt();
+                }
+
+#if GDI_DISPLAY_SESSION
+                /* Reset the LCDC before the frame that failed completes and the next one can start */
+                if (notif & DEV_DISPLAY_RESET_EVT) {
+                        dev_display_session_reset();
+                }
+#endif
+
                 if (notif & DEV_DRAW_ASYNC_CMPL_EVT) {
                         /*
                          * Protect the following code block from being executed twice.
@@ -1000,6 +1245,13 @@ static void gdi_task(void *pvParameters)
                         }
                 }
 
+#if GDI_DISPLAY_SESSION
+                /* A frame update in progress restarts the idle time when it completes */
+                if ((notif & DEV_DISPLAY_IDLE_EVT) && !draw_async_cmpl_en) {
+                        dev_display_session_close();
+                }
+#endif
+
 #if GDI_TOUCH_ENABLE
                 if (notif & DEV_TOUCH_EVT) {
                         /* Read touch events */
@@ -1173,12 +1425,21 @@ gdi_t *gdi_init(void)
 
         OS_EVENT_CREATE(gdi->draw_event);
         OS_EVENT_CREATE(gdi->dma_event);
+#ifndef OS_BAREMETAL
+        OS_MUTEX_CREATE(dma_mutex);
+#endif
+        for (int i = 0; i < GDI_DMA_CHANNELS; i++) {
+                dma_setup(&dma_channels[i].dma, GDI_DMA_FIRST_CHANNEL + i);
+        }
 #if GDI_MULTIPLEX_TOUCH_DISPLAY
         OS_MUTEX_CREATE(gdi->block_mutex_multiplex_display_touch);
 #endif
 #if GDI_USE_CONTINUOUS_MODE
         OS_MUTEX_CREATE(gdi->block_mutex_display_status);
 #endif
+#if GDI_DISPLAY_SESSION
+        OS_MUTEX_CREATE(display_session_mutex);
+#endif
 
 #if !DEVICE_FPGA && !defined(OS_BAREMETAL)
         gdi->draw_smphr = xSemaphoreCreateCounting(1, 1);
@@ -1257,6 +1518,13 @@ void gdi_display_power_off(void)
                 screen_power_off();
         }
         gdi->display_powered = false;
+
+#if GDI_DISPLAY_SESSION
+        /* Let the GDI task close the display so that the system can sleep */
+        if (task_h) {
+                OS_TASK_NOTIFY(task_h, DEV_DISPLAY_IDLE_EVT, OS_NOTIFY_SET_BITS);
+        }
+#endif
 }
 
 bool gdi_display_is_powered(void)
@@ -1288,6 +1556,13 @@ void gdi_display_disable(void)
         }
 
         gdi->display_enabled = false;
+
+#if GDI_DISPLAY_SESSION
+        /* Let the GDI task close the display so that the system can sleep */
+        if (task_h) {
+                OS_TASK_NOTIFY(task_h, DEV_DISPLAY_IDLE_EVT, OS_NOTIFY_SET_BITS);
+        }
+#endif
 }
 
 bool gdi_display_is_enabled(void)
@@ -1405,6 +1680,311 @@ void gdi_set_frame_buffer(HW_LCDC_LAYER layer_no, uint8_t frame)
         gdi->layer[layer_no].layer_dirty = true;
 }
 
+static void dma_setup(DMA_setup *dma, HW_DMA_CHANNEL ch)
+{
+        dma->channel_number  = ch;
+        dma->dma_prio        = HW_DMA_PRIO_7;
+        dma->burst_mode      = HW_DMA_BURST_MODE_8x;
+        dma->irq_enable      = HW_DMA_IRQ_STATE_ENABLED;
+        dma->dma_idle        = HW_DMA_IDLE_BLOCKING_MODE;
+        dma->bus_width       = HW_DMA_BW_WORD;
+        dma->circular        = HW_DMA_MODE_NORMAL;
+        dma->callback        = NULL;
+        dma->user_data       = NULL;
+        dma->irq_nr_of_trans = 0;
+        dma->dma_init        = HW_DMA_INIT_AX_BX_AY_BY;
+        dma->a_inc           = HW_DMA_AINC_TRUE;
+        dma->b_inc           = HW_DMA_BINC_TRUE;
+        dma->dreq_mode       = HW_DMA_DREQ_START;
+        dma->dma_req_mux     = HW_DMA_TRIG_NONE;
+}
+
+static resource_mask_t dma_res_mask(void)
+{
+        static const resource_mask_t res_mask[] = {
+                RES_MASK(RES_ID_DMA_CH0), RES_MASK(RES_ID_DMA_CH1),
+                RES_MASK(RES_ID_DMA_CH2), RES_MASK(RES_ID_DMA_CH3),
+                RES_MASK(RES_ID_DMA_CH4), RES_MASK(RES_ID_DMA_CH5),
+                RES_MASK(RES_ID_DMA_CH6), RES_MASK(RES_ID_DMA_CH7)
+        };
+        resource_mask_t mask = 0;
+
+        for (int i = 0; i < GDI_DMA_CHANNELS; i++) {
+                mask |= res_mask[GDI_DMA_FIRST_CHANNEL + i];
+        }
+        return mask;
+}
+
+static bool dma_idle(void)
+{
+        for (int i = 0; i < GDI_DMA_QUEUE_LEN; i++) {
+                if (dma_jobs[i].state != GDI_DMA_JOB_FREE) {
+                        return false;
+                }
+        }
+        return true;
+}
+
+/* Called with interrupts disabled or from the DMA interrupt */
+static void dma_start_next(gdi_dma_t *ch)
+{
+        gdi_dma_job_t *job = &dma_jobs[dma_job_next];
+        uint32_t align;
+
+        if (job->state != GDI_DMA_JOB_QUEUED) {
+                ch->job = NULL;
+                return;
+        }
+        dma_job_next = (dma_job_next + 1) % GDI_DMA_QUEUE_LEN;
+
+        job->state = GDI_DMA_JOB_ACTIVE;
+        ch->job = job;
+        ch->dst = job->dst;
+        ch->src = job->src;
+        ch->reps = job->reps;
+
+        /* The widest bus access all the rows are aligned to */
+        align = job->length | job->dst | job->src | job->dst_step | job->src_step;
+        ch->dma.bus_width = !(align & 3) ? HW_DMA_BW_WORD :
+                            !(align & 1) ? HW_DMA_BW_HALFWORD : HW_DMA_BW_BYTE;
+        ch->dma.length =
+                (ch->dma.bus_width != 0) ? (job->length / ch->dma.bus_width) : job->length;
+        ch->dma.src_address = ch->src;
+        ch->dma.dest_address = ch->dst;
+        ch->dma.callback = dma_cb;
+        ch->dma.user_data = ch;
+
+#ifdef PERFORMANCE_METRICS
+        ch->start = gdi_get_sys_uptime_ticks();
+#endif
+
+        hw_dma_channel_initialization(&ch->dma);
+        hw_dma_channel_enable(ch->dma.channel_number, HW_DMA_STATE_ENABLED);
+}
+
+static void dma_cb(void *user_data, dma_size_t len)
+{
+        gdi_dma_t *ch = (gdi_dma_t *)user_data;
+
+        /* Next row of a 2D copy */
+        if (--ch->reps > 0) {
+                ch->dst += ch->job->dst_step;
+                ch->src += ch->job->src_step;
+
+                hw_dma_channel_update_source(ch->dma.channel_number, (void *)ch->src, ch->dma.length, dma_cb);
+                hw_dma_channel_update_destination(ch->dma.channel_number, (void *)ch->dst, ch->dma.length, dma_cb);
+                hw_dma_channel_enable(ch->dma.channel_number, HW_DMA_STATE_ENABLED);
+                return;
+        }
+
+#ifdef PERFORMANCE_METRICS
+        dma_busy_ticks += gdi_get_sys_uptime_ticks() - ch->start;
+#endif
+
+        ch->job->state = GDI_DMA_JOB_DONE;
+        dma_start_next(ch);
+
+        /* Callbacks are called from the GDI task */
+#ifndef OS_BAREMETAL
+        OS_TASK_NOTIFY_FROM_ISR(task_h, DEV_DMA_CMPL_EVT, OS_NOTIFY_SET_BITS);
+#else
+        dev_dma_cmpl_evt();
+#endif
+}
+
+static void dev_dma_cmpl_evt(void)
+{
+        bool release;
+
+        /* Oldest copies first. A callback is called only once the copies submitted before are done,
+         * so that the parts of a split copy complete in order */
+        for (int i = 0; i < GDI_DMA_QUEUE_LEN; i++) {
+                gdi_dma_job_t *job = &dma_jobs[(dma_job_head + i) % GDI_DMA_QUEUE_LEN];
+
+                if (job->state == GDI_DMA_JOB_DONE) {
+                        if (job->cb) {
+                                job->cb(job->user_data);
+                        }
+                        job->state = GDI_DMA_JOB_FREE;
+                }
+                else if (job->state != GDI_DMA_JOB_FREE) {
+                        break;
+                }
+        }
+
+        /* Give the channels back once all the copies are done */
+        OS_ENTER_CRITICAL_SECTION();
+        release = dma_acquired && dma_idle();
+        if (release) {
+                dma_acquired = false;
+        }
+        OS_LEAVE_CRITICAL_SECTION();
+
+        if (release) {
+                resource_release(dma_res_mask());
+        }
+
+        OS_EVENT_SIGNAL(gdi->dma_event);
+}
+
+/* Longest run in bytes of a copy between the given addresses */
+static size_t dma_max_length(uint32_t align)
+{
+        return GDI_DMA_MAX_TRANSFERS * (!(align & 3) ? 4 : !(align & 1) ? 2 : 1);
+}
+
+/* Queues one job, the rows of which fit in a DMA run */
+static void dma_submit(uint32_t dst, uint32_t src, size_t length, int dst_step, int src_step, size_t reps,
+        gdi_dma_callback cb, void *user_data)
+{
+        gdi_dma_job_t *job;
+        bool acquire;
+
+        /* The queue is full until the oldest copy is done */
+        job = &dma_jobs[dma_job_head];
+        while (job->state != GDI_DMA_JOB_FREE) {
+                OS_EVENT_WAIT(gdi->dma_event, OS_EVENT_FOREVER);
+        }
+
+        job->dst = dst;
+        job->src = src;
+        job->length = length;
+        job->dst_step = dst_step;
+        job->src_step = src_step;
+        job->reps = reps;
+        job->cb = cb;
+        job->user_data = user_data;
+
+        /* The channels stay acquired as long as any copy is pending */
+        OS_ENTER_CRITICAL_SECTION();
+        job->state = GDI_DMA_JOB_NEW;
+        acquire = !dma_acquired;
+        dma_acquired = true;
+        OS_LEAVE_CRITICAL_SECTION();
+
+        if (acquire) {
+                resource_acquire(dma_res_mask(), RES_WAIT_FOREVER);
+        }
+
+        OS_ENTER_CRITICAL_SECTION();
+        job->state = GDI_DMA_JOB_QUEUED;
+        dma_job_head = (dma_job_head + 1) % GDI_DMA_QUEUE_LEN;
+        for (int i = 0; i < GDI_DMA_CHANNELS; i++) {
+                if (!dma_channels[i].job) {
+                        dma_start_next(&dma_channels[i]);
+                        break;
+                }
+        }
+        OS_LEAVE_CRITICAL_SECTION();
+}
+
+void gdi_dma_copy_async(void *dst, const void *src, size_t length, int dst_step, int src_step, size_t reps,
+        gdi_dma_callback cb, void *user_data)
+{
+        uint32_t d = (uint32_t)dst;
+        uint32_t s = (uint32_t)src;
+        size_t max_length;
+
+        if (!length || !reps) {
+                if (cb) {
+                        cb(user_data);
+                }
+                return;
+        }
+
+#ifndef OS_BAREMETAL
+        /* Done copies are handled in the GDI task, which would wait for itself once the queue is full */
+        OS_ASSERT(OS_GET_CURRENT_TASK() != task_h);
+
+        OS_MUTEX_GET(dma_mutex, OS_MUTEX_FOREVER);
+#endif
+
+        max_length = dma_max_length(d | s | length | dst_step | src_step);
+
+        /* Contiguous rows are copied as one block */
+        if (dst_step == (int)length && src_step == (int)length) {
+                length *= reps;
+                reps = 1;
+        }
+
+        if (length > max_length) {
+                if (reps == 1) {
+                        /* A block longer than a DMA run is copied in runs, the rest last */
+                        size_t runs = length / max_length;
+                        size_t rest = length - runs * max_length;
+
+                        dma_submit(d, s, max_length, max_length, max_length, runs,
+                                rest ? NULL : cb, user_data);
+                        if (rest) {
+                                dma_submit(d + runs * max_length, s + runs * max_length, rest, 0, 0, 1,
+                                        cb, user_data);
+                        }
+                }
+                else {
+                        /* Rows longer than a DMA run, e.g. of a wide frame, are copied as blocks */
+                        for (size_t i = 0; i < reps; i++) {
+                                size_t runs = length / max_length;
+                                size_t rest = length - runs * max_length;
+                                bool last = (i == reps - 1);
+
+                                dma_submit(d, s, max_length, max_length, max_length, runs,
+                                        (last && !rest) ? cb : NULL, user_data);
+                                if (rest) {
+                                        dma_submit(d + runs * max_length, s + runs * max_length, rest, 0, 0,
+                                                1, last ? cb : NULL, user_data);
+                                }
+                                d += dst_step;
+                                s += src_step;
+                        }
+                }
+        }
+        else {
+                dma_submit(d, s, length, dst_step, src_step, reps, cb, user_data);
+        }
+
+#ifndef OS_BAREMETAL
+        OS_MUTEX_PUT(dma_mutex);
+#endif
+}
+
+void gdi_dma_wait(void)
+{
+#ifndef OS_BAREMETAL
+        OS_ASSERT(OS_GET_CURRENT_TASK() != task_h);
+#endif
+
+        while (!dma_idle()) {
+                OS_EVENT_WAIT(gdi->dma_event, OS_EVENT_FOREVER);
+        }
+}
+
+void gdi_memcpy(void *dst, const void *src, size_t length)
+{
+        size_t part = FLOOR_FUNC(length / GDI_DMA_CHANNELS, 4);
+
+        /* Every channel copies a part */
+        for (int i = 0; i < GDI_DMA_CHANNELS - 1 && part; i++) {
+                gdi_dma_copy_async(dst, src, part, 0, 0, 1, NULL, NULL);
+                dst = (uint8_t *)dst + part;
+                src = (const uint8_t *)src + part;
+                length -= part;
+        }
+        gdi_dma_copy_async(dst, src, length, 0, 0, 1, NULL, NULL);
+
+        gdi_dma_wait();
+}
+
+void gdi_memcpy_2d(void *dst, const void *src, size_t length, int dst_step, int src_step, size_t reps)
+{
+        gdi_dma_copy_async(dst, src, length, dst_step, src_step, reps, NULL, NULL);
+        gdi_dma_wait();
+}
+
+void gdi_buffer_memcpy(HW_LCDC_LAYER dst_layer, uint8_t dst, HW_LCDC_LAYER src_layer, uint8_t src)
+{
+        gdi_memcpy(gdi->layer[dst_layer].buffer[dst], gdi->layer[src_layer].buffer[src],
+                gdi->layer[dst_layer].single_buff_sz);
+}
 
 void *_gdi_get_frame_buffer_addr(void)
 {
@@ -32,9 +32,16 @@
  *********************/
 #include "lv_port_disp.h"
 #include "lv_port_gpu.h"
+#include "lv_port_img_cache.h"
+#include "lv_port_glyph_atlas.h"
+#include "lv_port_shadow_cache.h"
+#include "lv_port_snapshot.h"
 #include "lv_port_version.h"
 #include "osal.h"
 #include "gdi.h"
+#ifdef PERFORMANCE_METRICS
+#include "metrics.h"
+#endif
 
 /*---------------------------------------------------------------------------
  * These helper macros are used to stringify a given macro */
@@ -53,9 +60,49 @@ static const char lvgl_ext_versionid[] = "v" XSTR(LVGL_CONF_VERSION_MAJOR)
 #define LAYER_OFFSET_X                  ((GDI_DISP_RESX - GDI_FB_RESX) / 2)
 #define LAYER_OFFSET_Y                  ((GDI_DISP_RESY - GDI_FB_RESY) / 2)
 
+#if GDI_FB_COLOR_FORMAT == CF_NATIVE_RGB332
+#define LAYER_COLOR_FMT                 (GDI_FORMAT_RGB332)
+#elif GDI_FB_COLOR_FORMAT == CF_NATIVE_RGB565
+#define LAYER_COLOR_FMT                 (GDI_FORMAT_RGB565)
+#else
+#define LAYER_COLOR_FMT                 (GDI_FORMAT_ARGB8888)
+#endif
+
+/* LVGL draws in the first buffer only while the second one keeps the whole frame */
+#define FRAME_KEPT_EN                   (LV_PORT_DISP_OVERLAY_EN || LV_PORT_DISP_VSCROLL_EN)
+
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct {
+        lv_port_disp_transition_dsc_t dsc;
+        lv_color_t *frame_old;
+        lv_color_t *frame_new;
+        lv_timer_t *refr_timer_def;
+        lv_timer_t *dummy_timer;
+        bool new_on_top;                /* The new frame is shown on layer 1 */
+        bool active;
+} transition_t;
+
+#if LV_PORT_DISP_OVERLAY_EN
+typedef struct {
+        lv_obj_t *obj;                  /* Object shown on layer 1, NULL if no overlay is attached */
+        void *buf;
+        uint32_t buf_size;
+        lv_coord_t ext_size;            /* Extra draw size of the object around its coordinates */
+        lv_area_t area;                 /* Area of the overlay buffer on the display */
+        lv_color_t *frame;              /* Whole frame layer 0 is transferred from */
+} overlay_t;
+#endif
+
+#if LV_PORT_DISP_VSCROLL_EN
+typedef struct {
+        lv_obj_t *obj;                  /* Scrolled object, NULL if no object is attached */
+        lv_color_t *frame;              /* Ring of rows, display row y is kept in row (offset + y) */
+        lv_coord_t offset;
+        bool moved;                     /* The whole display is to be transferred again */
+} vscroll_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -66,6 +113,35 @@ static void disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_
 static void disp_rounder(struct _lv_disp_drv_t *disp_drv, lv_area_t *area);
 static void disp_wait(lv_disp_drv_t *disp_drv);
 
+static bool transition_prepare(lv_port_disp_transition_cb_t new_frame_cb, void *user_data);
+static void transition_update(lv_coord_t x_new, lv_coord_t y_new, lv_coord_t x_old, lv_coord_t y_old,
+        lv_opa_t opa);
+static void transition_finish(void);
+static void transition_anim_cb(void *var, int32_t v);
+static void transition_anim_ready_cb(lv_anim_t *a);
+
+#if FRAME_KEPT_EN
+static void frame_keep(void);
+static void frame_release(void);
+static bool frame_copy(lv_disp_drv_t *disp_drv, lv_color_t *frame, lv_coord_t offset, const lv_area_t *area,
+        const lv_color_t *color_p);
+static void frame_transfer(void);
+static void frame_transfer_cb(bool underflow, void *user_data);
+static void frame_wait(void);
+#endif
+
+#if LV_PORT_DISP_OVERLAY_EN
+static bool overlay_render(lv_coord_t x, lv_coord_t y);
+static void overlay_update(const lv_area_t *area);
+static void overlay_delete_cb(lv_event_t *e);
+#endif
+
+#if LV_PORT_DISP_VSCROLL_EN
+static bool vscroll_scroll_cb(lv_disp_drv_t *disp_drv, lv_obj_t *obj, lv_coord_t x, lv_coord_t y);
+static void vscroll_set_layers(void);
+static void vscroll_delete_cb(lv_event_t *e);
+#endif
+
 #ifdef PERFORMANCE_METRICS
 static void perf_monitor(lv_disp_drv_t *disp_drv, uint32_t time, uint32_t px);
 #endif
@@ -76,9 +152,27 @@ PRIVILEGED_DATA static lv_disp_draw_buf_t draw_buf_dsc;
 INITIALISED_PRIVILEGED_DATA static lv_color_t *fb_addr[2] = { 0 };
 PRIVILEGED_DATA static OS_EVENT flush_evt;
 
+PRIVILEGED_DATA static transition_t transition;
+
 #if TWO_LAYERS_HORIZONTAL_SLIDING
-INITIALISED_PRIVILEGED_DATA static void *flush_cb_def = NULL;
-PRIVILEGED_DATA static lv_timer_t *refr_timer_def, *dummy_timer;
+PRIVILEGED_DATA static lv_coord_t slide_dx;
+#endif
+
+#if FRAME_KEPT_EN
+PRIVILEGED_DATA static volatile bool frame_transfer_busy;
+PRIVILEGED_DATA static lv_area_t frame_area;           /* Area of the kept frame to be transferred */
+PRIVILEGED_DATA static bool frame_area_set;
+#if LV_PORT_DISP_DMA_COPY
+PRIVILEGED_DATA static int frame_copies;                /* Copies of the draw buffer still in progress */
+#endif
+#endif
+
+#if LV_PORT_DISP_OVERLAY_EN
+PRIVILEGED_DATA static overlay_t overlay;
+#endif
+
+#if LV_PORT_DISP_VSCROLL_EN
+PRIVILEGED_DATA static vscroll_t vscroll;
 #endif
 
 #ifdef PERFORMANCE_METRICS
@@ -134,6 +228,16 @@ void lv_port_disp_init(void)
         /* Set rounder callback to modify coordinates according to LCD requirements */
         disp_drv.rounder_cb = disp_rounder;
 
+#if DLG_LVGL_INV_AREA_COST_JOIN
+        /* Join invalidated areas when one flush of their bounding box is cheaper */
+        disp_drv.flush_overhead = LV_PORT_DISP_FLUSH_OVERHEAD;
+#endif
+
+#if LV_PORT_DISP_VSCROLL_EN
+        /* Scrolling an attached object shifts the ring instead of invalidating the object */
+        disp_drv.scroll_cb = vscroll_scroll_cb;
+#endif
+
         /* Enable task go to sleep while waiting for event */
         OS_EVENT_CREATE(flush_evt);
         disp_drv.wait_cb = disp_wait;
@@ -149,7 +253,20 @@ void lv_port_disp_init(void)
         disp_drv.gpu_blit_cb = lv_port_gpu_blit;
         disp_drv.gpu_blit_with_mask_cb = lv_port_gpu_blit_with_mask;
         disp_drv.gpu_config_blit_cb = lv_port_gpu_config_blit;
+        disp_drv.gpu_draw_rect_cb = lv_port_gpu_draw_rect;
+        disp_drv.gpu_draw_arc_cb = lv_port_gpu_draw_arc;
+        disp_drv.gpu_draw_line_cb = lv_port_gpu_draw_line;
+        disp_drv.gpu_draw_polygon_cb = lv_port_gpu_draw_polygon;
         disp_drv.gpu_wait_cb = lv_port_gpu_wait;
+#if LV_PORT_GPU_PIPELINE
+        disp_drv.gpu_wait_area_cb = lv_port_gpu_wait_area;
+#endif
+#if LV_PORT_GLYPH_ATLAS_EN
+        disp_drv.gpu_draw_letter_cb = lv_port_glyph_atlas_draw_letter;
+#endif
+#if LV_PORT_SHADOW_CACHE_EN
+        disp_drv.gpu_draw_shadow_cb = lv_port_shadow_cache_draw;
+#endif
 #endif /* LV_PORT_DISP_GPU_EN */
 
 #ifdef PERFORMANCE_METRICS
@@ -158,163 +275,305 @@ void lv_port_disp_init(void)
 
         /* Finally register the driver */
         lv_disp_drv_register(&disp_drv);
+
+#if LV_PORT_IMG_CACHE_EN
+        /* Keep RLE images decoded in the GUI heap */
+        lv_port_img_cache_init();
+#endif
+
+#if LV_PORT_SNAPSHOT_EN
+        /* Keep snapshots of static layers in the GUI heap after the image cache */
+        lv_port_snapshot_init();
+#endif
+}
+
+void lv_port_disp_transition_dsc_init(lv_port_disp_transition_dsc_t *dsc)
+{
+        lv_memset_00(dsc, sizeof(*dsc));
+        dsc->type = LV_PORT_DISP_TRANSITION_SLIDE;
+        dsc->dir = LV_DIR_LEFT;
+        dsc->time = 300;
+        dsc->path_cb = lv_anim_path_ease_out;
+}
+
+bool lv_port_disp_transition_start(const lv_port_disp_transition_dsc_t *dsc)
+{
+        lv_anim_t a;
+
+        if (!transition_prepare(dsc->new_frame_cb, dsc->user_data)) {
+                /* LVGL draws the new frame as usual */
+                dsc->new_frame_cb(dsc->user_data);
+                if (dsc->ready_cb) {
+                        dsc->ready_cb(dsc->user_data);
+                }
+                return false;
+        }
+
+        transition.dsc = *dsc;
+        transition.new_on_top = (dsc->type == LV_PORT_DISP_TRANSITION_COVER);
+
+        /* Every frame of the animation is a layer position or alpha update */
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &transition);
+        lv_anim_set_values(&a, 0, LV_PORT_DISP_TRANSITION_RANGE);
+        lv_anim_set_time(&a, dsc->time);
+        lv_anim_set_path_cb(&a, dsc->path_cb);
+        lv_anim_set_exec_cb(&a, transition_anim_cb);
+        lv_anim_set_ready_cb(&a, transition_anim_ready_cb);
+        lv_anim_start(&a);
+
+        return true;
 }
 
 #if TWO_LAYERS_HORIZONTAL_SLIDING
+static void slide_new_frame_cb(void *user_data)
+{
+        lv_obj_t *obj = user_data;
+
+        /* Set the menu screen visible and invalidate the active screen */
+        lv_obj_move_children_by(obj, slide_dx, 0, true);
+}
+
 void lv_port_disp_slide_init(lv_obj_t *obj, lv_dir_t dir)
 {
-        int dx = 0;
         lv_disp_t *disp;
 
         disp = lv_disp_get_default();
 
+        slide_dx = 0;
         if (dir == LV_DIR_RIGHT) {
-                dx = -lv_disp_get_hor_res(disp);
+                slide_dx = -lv_disp_get_hor_res(disp);
         }
         else if (dir == LV_DIR_LEFT) {
-                dx = lv_disp_get_hor_res(disp);
+                slide_dx = lv_disp_get_hor_res(disp);
         }
 
         lv_obj_clear_state(obj, LV_STATE_SCROLLED);
 
-        /* When partial update is enabled full redraw of watch face is required */
-        lv_obj_invalidate(obj);
+        /* The layers follow the scrolling, the old frame is on layer 1 */
+        if (transition_prepare(slide_new_frame_cb, obj)) {
+                transition.new_on_top = false;
 
-        /* Force a full frame update (disable partial update) */
-        gdi_set_partial_update_area(LAYER_OFFSET_X + 0, LAYER_OFFSET_Y + 0,
-                LAYER_OFFSET_X + lv_disp_get_hor_res(disp),
-                LAYER_OFFSET_Y + lv_disp_get_ver_res(disp));
+                /* Move back the position of the affected objects since scroll_by_raw handles it */
+                lv_obj_move_children_by(obj, -slide_dx, 0, true);
+        }
+}
 
-        /* Store default display driver call backs */
-        flush_cb_def = *disp->driver->flush_cb;
-        refr_timer_def = disp->refr_timer;
+void lv_port_disp_slide(int posXLayer0, int posXLayer1)
+{
+        if (transition.active) {
+                transition_update(posXLayer0, 0, posXLayer1, 0, LV_OPA_COVER);
+        }
+}
 
-        /* Stop display update */
-        disp->driver->flush_cb = NULL;
+void lv_port_disp_slide_end()
+{
+        lv_disp_t *disp;
 
-        /* Draw the whole watch face screen */
-        lv_refr_now(disp);
+        if (!transition.active) {
+                return;
+        }
 
-        /* Inform the graphics library that you are ready with the flushing */
-        lv_disp_flush_ready(disp->driver);
+        disp = lv_disp_get_default();
 
-        /* Pause the refresh time to prevent any display update or frame buffer switch */
-        lv_timer_pause(disp->refr_timer);
+        /* The scrolling invalidated the screens which are drawn already */
+        lv_memset_00(disp->inv_areas, sizeof(disp->inv_areas));
+        lv_memset_00(disp->inv_area_joined, sizeof(disp->inv_area_joined));
+        disp->inv_p = 0;
 
-        /* Set the menu screen visible and invalidate the active screen */
-        lv_obj_move_children_by(obj, dx, 0, true);
-        lv_obj_invalidate(obj);
+        transition_finish();
+}
+#endif /* TWO_LAYERS_HORIZONTAL_SLIDING */
 
-        /* Draw the menu screen in the non active frame buffer */
-        lv_refr_now(disp);
+#if LV_PORT_DISP_OVERLAY_EN
+bool lv_port_disp_overlay_attach(lv_obj_t *obj, void *buf, uint32_t buf_size)
+{
+        lv_disp_t *disp = lv_obj_get_disp(obj);
 
-        /* Inform the graphics library that you are ready with the flushing */
-        lv_disp_flush_ready(disp->driver);
+        /* Layer 1 and the second buffer are also used by the sliding */
+        if (overlay.obj || !fb_addr[1] || disp->driver->flush_cb != disp_flush) {
+                return false;
+        }
 
-        /* Move back the position of the affected objects since scroll_by_raw handles it */
-        lv_obj_move_children_by(obj, -dx, 0, true);
+#if LV_PORT_DISP_VSCROLL_EN
+        /* The overlay takes over the second buffer */
+        lv_port_disp_vscroll_detach();
+#endif
 
-        /* Create a dummy timer to prevent drawing triggered from objects invalidation */
-        dummy_timer = lv_timer_create_basic();
-        disp->refr_timer = dummy_timer;
+        /* The second buffer may still be transferred */
+        while (draw_buf_dsc.flushing) {
+                disp_wait(disp->driver);
+        }
+
+        overlay.obj = obj;
+        overlay.buf = buf;
+        overlay.buf_size = buf_size;
+        if (!overlay_render(obj->coords.x1, obj->coords.y1)) {
+                overlay.obj = NULL;
+                return false;
+        }
+
+        overlay.frame = fb_addr[1];
+        frame_keep();
+
+        gdi_set_layer_blending(HW_LCDC_LAYER_1, HW_LCDC_BL_SRC_OVER, 0xFF);
+        gdi_set_layer_enable(HW_LCDC_LAYER_1, true);
+
+        /* Remove the object from layer 0 */
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_event_cb(obj, overlay_delete_cb, LV_EVENT_DELETE, NULL);
+
+        /* Fill the frame, the overlay can be moved right after */
+        lv_obj_invalidate(lv_disp_get_scr_act(disp));
+        lv_refr_now(disp);
+
+        return true;
 }
 
-void lv_port_disp_slide(int posXLayer0, int posXLayer1)
+void lv_port_disp_overlay_move(lv_coord_t x, lv_coord_t y)
 {
-        int posYLayer0 = 0, posYLayer1 = 0;
-        lv_disp_t *disp;
-        lv_disp_draw_buf_t *draw_buf;
+        lv_area_t area;
+
+        if (!overlay.obj) {
+                return;
+        }
 
-        void *layer0_addr = NULL, *layer1_addr = NULL;
-        gdi_color_fmt_t color_fmt = GDI_FORMAT_ARGB8888;
+        frame_wait();
 
-#if GDI_FB_COLOR_FORMAT == CF_NATIVE_RGB332
-        color_fmt = GDI_FORMAT_RGB332;
-#elif GDI_FB_COLOR_FORMAT == CF_NATIVE_RGB565
-        color_fmt = GDI_FORMAT_RGB565;
-#elif GDI_FB_COLOR_FORMAT == CF_NATIVE_ARGB8888
-        color_fmt = GDI_FORMAT_ARGB8888;
+#ifdef PERFORMANCE_METRICS
+        uint64_t timestamp = gdi_get_sys_uptime_ticks();
 #endif
 
-        /* Set the position of Layer 0 in x direction */
-        gdi_set_layer_start(HW_LCDC_LAYER_0, posXLayer0 + LAYER_OFFSET_X,
-                posYLayer0 + LAYER_OFFSET_Y);
+        lv_area_copy(&area, &overlay.area);
+        _lv_area_set_pos(&overlay.area, x - overlay.ext_size, y - overlay.ext_size);
+        gdi_set_layer_start(HW_LCDC_LAYER_1, LAYER_OFFSET_X + overlay.area.x1,
+                LAYER_OFFSET_Y + overlay.area.y1);
 
-        /* Set the position of Layer 1 in x direction */
-        gdi_set_layer_start(HW_LCDC_LAYER_1, posXLayer1 + LAYER_OFFSET_X,
-                posYLayer1 + LAYER_OFFSET_Y);
+        /* Only the old and the new position of the overlay are transferred again */
+        _lv_area_join(&area, &area, &overlay.area);
 
-        if (!gdi_get_layer_enable(HW_LCDC_LAYER_1)) {
-                disp = lv_disp_get_default();
-                /* Manual refresh was triggered without display update.
-                 * Change the frame buffer addresses of both Layers */
-                draw_buf = lv_disp_get_draw_buf(disp);
-                if (draw_buf->buf1 && draw_buf->buf2) {
-                        if (draw_buf->buf_act == draw_buf->buf1) {
-                                layer0_addr = draw_buf->buf2;
-                                layer1_addr = draw_buf->buf1;
-                        }
-                        else if (draw_buf->buf_act == draw_buf->buf2) {
-                                layer0_addr = draw_buf->buf1;
-                                layer1_addr = draw_buf->buf2;
-                        }
-                }
+#ifdef PERFORMANCE_METRICS
+        /* Nothing is drawn, the register update is all the rendering */
+        gdi_perf_render_time(gdi_convert_ticks_to_us(gdi_get_sys_uptime_ticks() - timestamp));
+#endif
 
-                /* Set the address of the video RAM of Layer 1 */
-                gdi_set_layer_src(HW_LCDC_LAYER_1, layer1_addr, DEMO_RESX, DEMO_RESY, color_fmt);
+        overlay_update(&area);
+}
 
-                /* Enable the visibility of Layer 1 */
-                gdi_set_layer_enable(HW_LCDC_LAYER_1, 1);
+void lv_port_disp_overlay_refresh(void)
+{
+        lv_area_t area;
 
-                /* Set the address of the video RAM of Layer 0 */
-                gdi_set_layer_src(HW_LCDC_LAYER_0, layer0_addr, DEMO_RESX, DEMO_RESY, color_fmt);
+        if (!overlay.obj) {
+                return;
         }
 
-        /* Trigger an LCD display update */
-        gdi_display_update_async(NULL, NULL);
+        /* The LCDC may still read the overlay buffer */
+        frame_wait();
+
+        lv_area_copy(&area, &overlay.area);
+        if (!overlay_render(overlay.area.x1 + overlay.ext_size, overlay.area.y1 + overlay.ext_size)) {
+                lv_port_disp_overlay_detach();
+                return;
+        }
+
+        _lv_area_join(&area, &area, &overlay.area);
+        overlay_update(&area);
 }
 
-void lv_port_disp_slide_end()
+void lv_port_disp_overlay_detach(void)
 {
-        lv_disp_t *disp;
-        int posXLayer0 = 0, posYLayer0 = 0;
-        gdi_color_fmt_t color_fmt = GDI_FORMAT_ARGB8888;
+        lv_obj_t *obj = overlay.obj;
 
-#if GDI_FB_COLOR_FORMAT == CF_NATIVE_RGB332
-        color_fmt = GDI_FORMAT_RGB332;
-#elif GDI_FB_COLOR_FORMAT == CF_NATIVE_RGB565
-        color_fmt = GDI_FORMAT_RGB565;
-#elif GDI_FB_COLOR_FORMAT == CF_NATIVE_ARGB8888
-        color_fmt = GDI_FORMAT_ARGB8888;
+        if (!obj) {
+                return;
+        }
+
+        frame_wait();
+        overlay.obj = NULL;
+
+        lv_obj_remove_event_cb(obj, overlay_delete_cb);
+
+        gdi_set_layer_enable(HW_LCDC_LAYER_1, false);
+        gdi_set_layer_blending(HW_LCDC_LAYER_1, HW_LCDC_BL_SRC, 0xFF);
+
+        frame_release();
+
+        /* LVGL draws the object at its own position, the overlay is removed with the same update */
+        lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_invalidate(obj);
+        lv_obj_invalidate_area(lv_disp_get_scr_act(lv_obj_get_disp(obj)), &overlay.area);
+}
+#endif /* LV_PORT_DISP_OVERLAY_EN */
+
+#if LV_PORT_DISP_VSCROLL_EN
+bool lv_port_disp_vscroll_attach(lv_obj_t *obj)
+{
+        lv_disp_t *disp = lv_obj_get_disp(obj);
+        lv_area_t disp_area = { 0, 0, LV_PORT_DISP_HOR_RES - 1, LV_PORT_DISP_VER_RES - 1 };
+
+        if (vscroll.obj == obj) {
+                return true;
+        }
+
+        /* Layer 1 and the second buffer are also used by the overlay and the sliding */
+        if (vscroll.obj || !fb_addr[1] || disp->driver->flush_cb != disp_flush) {
+                return false;
+        }
+#if LV_PORT_DISP_OVERLAY_EN
+        if (overlay.obj) {
+                return false;
+        }
 #endif
 
-        disp = lv_disp_get_default();
+        /* The whole display moves with the object, which has to cover it */
+        if (!_lv_area_is_in(&disp_area, &obj->coords, 0)) {
+                return false;
+        }
 
-        /*Clean up invalidated areas*/
-        lv_memset_00(disp->inv_areas, sizeof(disp->inv_areas));
-        lv_memset_00(disp->inv_area_joined, sizeof(disp->inv_area_joined));
-        disp->inv_p = 0;
+        /* The second buffer may still be transferred */
+        while (draw_buf_dsc.flushing) {
+                disp_wait(disp->driver);
+        }
 
-        /* Re-enable display update and refresh timer callbacks */
-        disp->driver->flush_cb = flush_cb_def;
-        disp->refr_timer = refr_timer_def;
+        vscroll.obj = obj;
+        vscroll.frame = fb_addr[1];
+        vscroll.offset = 0;
+        vscroll.moved = false;
+        frame_keep();
 
-        lv_timer_del(dummy_timer);
-        dummy_timer = NULL;
+        lv_obj_add_event_cb(obj, vscroll_delete_cb, LV_EVENT_DELETE, NULL);
 
-        lv_timer_resume(disp->refr_timer);
+        /* Fill the ring with the next refresh */
+        lv_obj_invalidate(lv_disp_get_scr_act(disp));
 
-        /* Disable the visibility of Layer 1 */
-        gdi_set_layer_enable(HW_LCDC_LAYER_1, 0);
+        return true;
+}
 
-        /* Reset the address of the video RAM of Layer 1 */
-        gdi_set_layer_src(HW_LCDC_LAYER_1, 0, DEMO_RESX, DEMO_RESY, color_fmt);
+void lv_port_disp_vscroll_detach(void)
+{
+        lv_obj_t *obj = vscroll.obj;
 
-        /* Restore the position of Layer 0 */
-        gdi_set_layer_start(HW_LCDC_LAYER_0, posXLayer0 + LAYER_OFFSET_X,
-                posYLayer0 + LAYER_OFFSET_Y);
+        if (!obj) {
+                return;
+        }
+
+        frame_wait();
+        vscroll.obj = NULL;
+
+        lv_obj_remove_event_cb(obj, vscroll_delete_cb);
+
+        gdi_set_layer_enable(HW_LCDC_LAYER_1, false);
+
+        /* The display keeps the frame */
+        frame_release();
+
+        /* The shifted rows have not been transferred yet */
+        if (vscroll.moved) {
+                lv_obj_invalidate(obj);
+        }
 }
-#endif /* TWO_LAYERS_HORIZONTAL_SLIDING */
+#endif /* LV_PORT_DISP_VSCROLL_EN */
 
 /**********************
  *   STATIC FUNCTIONS
@@ -364,16 +623,6 @@ static void flush_cb(bool underflow, void *user_data)
 
 static void disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
 {
-        gdi_color_fmt_t color_fmt = GDI_FORMAT_ARGB8888;
-
-#if GDI_FB_COLOR_FORMAT == CF_NATIVE_RGB332
-        color_fmt = GDI_FORMAT_RGB332;
-#elif GDI_FB_COLOR_FORMAT == CF_NATIVE_RGB565
-        color_fmt = GDI_FORMAT_RGB565;
-#elif GDI_FB_COLOR_FORMAT == CF_NATIVE_ARGB8888
-        color_fmt = GDI_FORMAT_ARGB8888;
-#endif
-
 #ifdef PERFORMANCE_METRICS
         uint64_t flush_evt_timestamp = gdi_get_sys_uptime_ticks();
 #endif
@@ -382,21 +631,231 @@ static void disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_
         lv_port_gpu_flush();
 #endif
 
+#if FRAME_KEPT_EN
+        /* An earlier update may still be transferred out of the kept frame */
+        frame_wait();
+#endif
 
         gdi_set_partial_update_area(LAYER_OFFSET_X + area->x1, LAYER_OFFSET_Y + area->y1,
                 LAYER_OFFSET_X + area->x2, LAYER_OFFSET_Y + area->y2);
 
-        gdi_set_layer_src(HW_LCDC_LAYER_0, color_p, lv_area_get_width(area), lv_area_get_height(area), color_fmt);
-        gdi_set_layer_start(HW_LCDC_LAYER_0, LAYER_OFFSET_X + area->x1, LAYER_OFFSET_Y + area->y1);
+#if LV_PORT_DISP_OVERLAY_EN
+        if (overlay.obj) {
+                /* Layer 0 is transferred out of the whole frame, so that the overlay can be moved
+                 * over any part of it */
+                if (frame_copy(disp_drv, overlay.frame, 0, area, color_p)) {
+                        gdi_set_layer_src(HW_LCDC_LAYER_0, overlay.frame, LV_PORT_DISP_HOR_RES,
+                                LV_PORT_DISP_VER_RES, LAYER_COLOR_FMT);
+                        gdi_set_layer_start(HW_LCDC_LAYER_0, LAYER_OFFSET_X, LAYER_OFFSET_Y);
 
-        gdi_perf_transfer_last(lv_disp_flush_is_last(disp_drv));
-        gdi_display_update_async(flush_cb, disp_drv);
+                        frame_transfer();
+                }
+        }
+        else
+#endif
+#if LV_PORT_DISP_VSCROLL_EN
+        if (vscroll.obj) {
+                /* After a scroll every row is shown from another position */
+                if (vscroll.moved) {
+                        frame_area.x1 = 0;
+                        frame_area.y1 = 0;
+                        frame_area.x2 = LV_PORT_DISP_HOR_RES - 1;
+                        frame_area.y2 = LV_PORT_DISP_VER_RES - 1;
+                        frame_area_set = true;
+                        vscroll.moved = false;
+                }
+
+                if (frame_copy(disp_drv, vscroll.frame, vscroll.offset, area, color_p)) {
+                        vscroll_set_layers();
+                        frame_transfer();
+                }
+        }
+        else
+#endif
+        {
+                gdi_set_layer_src(HW_LCDC_LAYER_0, color_p, lv_area_get_width(area), lv_area_get_height(area), LAYER_COLOR_FMT);
+                gdi_set_layer_start(HW_LCDC_LAYER_0, LAYER_OFFSET_X + area->x1, LAYER_OFFSET_Y + area->y1);
+
+                gdi_perf_transfer_last(lv_disp_flush_is_last(disp_drv));
+                gdi_display_update_async(flush_cb, disp_drv);
+        }
 
 #ifdef PERFORMANCE_METRICS
         flush_evt_wait += gdi_get_sys_uptime_ticks() - flush_evt_timestamp;
 #endif
 }
 
+static bool transition_prepare(lv_port_disp_transition_cb_t new_frame_cb, void *user_data)
+{
+        lv_disp_t *disp = lv_disp_get_default();
+
+        /* Both frame buffers are needed */
+        if (transition.active || !fb_addr[1] || disp->driver->flush_cb != disp_flush) {
+                return false;
+        }
+
+#if LV_PORT_DISP_OVERLAY_EN
+        /* Layer 1 shows the old or the new frame */
+        lv_port_disp_overlay_detach();
+#endif
+#if LV_PORT_DISP_VSCROLL_EN
+        lv_port_disp_vscroll_detach();
+#endif
+
+        /* The frame buffer to draw in may still be transferred */
+        while (draw_buf_dsc.flushing) {
+                disp_wait(disp->driver);
+        }
+
+        /* Force a full frame update (disable partial update) */
+        gdi_set_partial_update_area(LAYER_OFFSET_X, LAYER_OFFSET_Y,
+                LAYER_OFFSET_X + lv_disp_get_hor_res(disp) - 1,
+                LAYER_OFFSET_Y + lv_disp_get_ver_res(disp) - 1);
+
+        /* Stop display update */
+        transition.refr_timer_def = disp->refr_timer;
+        disp->driver->flush_cb = NULL;
+
+        /* Draw the old frame */
+        transition.frame_old = draw_buf_dsc.buf_act;
+        lv_obj_invalidate(lv_disp_get_scr_act(disp));
+        lv_refr_now(disp);
+
+        /* Inform the graphics library that you are ready with the flushing */
+        lv_disp_flush_ready(disp->driver);
+
+        /* Pause the refresh time to prevent any display update or frame buffer switch */
+        lv_timer_pause(disp->refr_timer);
+
+        /* Draw the new frame in the other frame buffer */
+        new_frame_cb(user_data);
+        transition.frame_new = draw_buf_dsc.buf_act;
+        lv_obj_invalidate(lv_disp_get_scr_act(disp));
+        lv_refr_now(disp);
+        lv_disp_flush_ready(disp->driver);
+
+        /* Create a dummy timer to prevent drawing triggered from objects invalidation */
+        transition.dummy_timer = lv_timer_create_basic();
+        disp->refr_timer = transition.dummy_timer;
+        transition.active = true;
+
+        return true;
+}
+
+static void transition_update(lv_coord_t x_new, lv_coord_t y_new, lv_coord_t x_old, lv_coord_t y_old,
+        lv_opa_t opa)
+{
+        HW_LCDC_LAYER layer_new = transition.new_on_top ? HW_LCDC_LAYER_1 : HW_LCDC_LAYER_0;
+        HW_LCDC_LAYER layer_old = transition.new_on_top ? HW_LCDC_LAYER_0 : HW_LCDC_LAYER_1;
+
+#ifdef PERFORMANCE_METRICS
+        uint64_t timestamp = gdi_get_sys_uptime_ticks();
+#endif
+
+        gdi_set_layer_start(layer_new, LAYER_OFFSET_X + x_new, LAYER_OFFSET_Y + y_new);
+        gdi_set_layer_start(layer_old, LAYER_OFFSET_X + x_old, LAYER_OFFSET_Y + y_old);
+
+        if (!gdi_get_layer_enable(HW_LCDC_LAYER_1)) {
+                /* Set the address of the video RAM of both layers */
+                gdi_set_layer_src(layer_new, transition.frame_new, LV_PORT_DISP_HOR_RES,
+                        LV_PORT_DISP_VER_RES, LAYER_COLOR_FMT);
+                gdi_set_layer_src(layer_old, transition.frame_old, LV_PORT_DISP_HOR_RES,
+                        LV_PORT_DISP_VER_RES, LAYER_COLOR_FMT);
+
+                /* Enable the visibility of Layer 1 */
+                gdi_set_layer_enable(HW_LCDC_LAYER_1, true);
+        }
+
+        /* Layer 1 is blended over layer 0 */
+        gdi_set_layer_blending(HW_LCDC_LAYER_1, opa >= LV_OPA_MAX ? HW_LCDC_BL_SRC : HW_LCDC_BL_SRC_OVER, opa);
+
+#ifdef PERFORMANCE_METRICS
+        /* Nothing is drawn, the register update is all the rendering */
+        gdi_perf_render_time(gdi_convert_ticks_to_us(gdi_get_sys_uptime_ticks() - timestamp));
+#endif
+
+        /* Trigger an LCD display update */
+        gdi_perf_transfer_last(true);
+        gdi_display_update_async(NULL, NULL);
+}
+
+static void transition_finish(void)
+{
+        lv_disp_t *disp = lv_disp_get_default();
+
+        /* Re-enable display update and refresh timer callbacks */
+        disp->driver->flush_cb = disp_flush;
+        disp->refr_timer = transition.refr_timer_def;
+
+        lv_timer_del(transition.dummy_timer);
+        transition.dummy_timer = NULL;
+
+        lv_timer_resume(disp->refr_timer);
+
+        /* The display shows the new frame already, LVGL flushes set up layer 0 again */
+        gdi_set_layer_enable(HW_LCDC_LAYER_1, 0);
+        gdi_set_layer_blending(HW_LCDC_LAYER_1, HW_LCDC_BL_SRC, 0xFF);
+
+        /* Reset the address of the video RAM of Layer 1 */
+        gdi_set_layer_src(HW_LCDC_LAYER_1, 0, LV_PORT_DISP_HOR_RES, LV_PORT_DISP_VER_RES, LAYER_COLOR_FMT);
+
+        /* Restore the position of Layer 0 */
+        gdi_set_layer_start(HW_LCDC_LAYER_0, LAYER_OFFSET_X, LAYER_OFFSET_Y);
+
+        transition.active = false;
+}
+
+static void transition_anim_cb(void *var, int32_t v)
+{
+        lv_coord_t dx = 0, dy = 0;
+        lv_coord_t x_new, y_new;
+
+        /* Offset the new frame starts from */
+        switch (transition.dsc.dir) {
+        case LV_DIR_LEFT:
+                dx = LV_PORT_DISP_HOR_RES;
+                break;
+        case LV_DIR_RIGHT:
+                dx = -LV_PORT_DISP_HOR_RES;
+                break;
+        case LV_DIR_TOP:
+                dy = LV_PORT_DISP_VER_RES;
+                break;
+        case LV_DIR_BOTTOM:
+                dy = -LV_PORT_DISP_VER_RES;
+                break;
+        default:
+                break;
+        }
+
+        x_new = dx - dx * v / LV_PORT_DISP_TRANSITION_RANGE;
+        y_new = dy - dy * v / LV_PORT_DISP_TRANSITION_RANGE;
+
+        switch (transition.dsc.type) {
+        case LV_PORT_DISP_TRANSITION_SLIDE:
+                transition_update(x_new, y_new, x_new - dx, y_new - dy, LV_OPA_COVER);
+                break;
+        case LV_PORT_DISP_TRANSITION_COVER:
+                transition_update(x_new, y_new, 0, 0, LV_OPA_COVER);
+                break;
+        case LV_PORT_DISP_TRANSITION_UNCOVER:
+                transition_update(0, 0, x_new - dx, y_new - dy, LV_OPA_COVER);
+                break;
+        case LV_PORT_DISP_TRANSITION_FADE:
+                transition_update(0, 0, 0, 0, LV_OPA_COVER - LV_OPA_COVER * v / LV_PORT_DISP_TRANSITION_RANGE);
+                break;
+        }
+}
+
+static void transition_anim_ready_cb(lv_anim_t *a)
+{
+        transition_finish();
+
+        if (transition.dsc.ready_cb) {
+                transition.dsc.ready_cb(transition.dsc.user_data);
+        }
+}
+
 static void disp_wait(lv_disp_drv_t *disp_drv)
 {
 #ifdef PERFORMANCE_METRICS
@@ -408,11 +867,287 @@ static void disp_wait(lv_disp_drv_t *disp_drv)
 #endif
 }
 
+#if FRAME_KEPT_EN
+static void frame_keep(void)
+{
+#if LV_PORT_DISP_DMA_COPY
+        /* LVGL draws in the two halves of the first buffer, one is copied while the other one is drawn */
+        draw_buf_dsc.size = LV_PORT_DISP_HOR_RES * LV_PORT_DISP_VER_RES / 2;
+        draw_buf_dsc.buf2 = fb_addr[0] + draw_buf_dsc.size;
+#else
+        /* LVGL draws in the first buffer only */
+        draw_buf_dsc.buf2 = NULL;
+#endif
+        draw_buf_dsc.buf_act = draw_buf_dsc.buf1;
+}
+
+static void frame_release(void)
+{
+#if LV_PORT_DISP_DMA_COPY
+        /* The draw buffer may still be copied */
+        gdi_dma_wait();
+        draw_buf_dsc.size = LV_PORT_DISP_HOR_RES * LV_PORT_DISP_VER_RES;
+#endif
+
+        /* Back to double buffering, the frame is not kept anymore */
+        draw_buf_dsc.buf2 = fb_addr[1];
+        draw_buf_dsc.buf_act = draw_buf_dsc.buf1;
+}
+
+#if LV_PORT_DISP_DMA_COPY
+static void frame_copy_cb(void *user_data)
+{
+        if (--frame_copies) {
+                return;
+        }
+
+        /* The draw buffer is free again */
+        lv_disp_flush_ready((lv_disp_drv_t *)user_data);
+        OS_EVENT_SIGNAL(flush_evt);
+}
+#endif
+
+/* Copy an area to the rows (offset + y) of a frame, which wrap around. Returns true once all the
+ * areas of the refresh are in the frame */
+static bool frame_copy(lv_disp_drv_t *disp_drv, lv_color_t *frame, lv_coord_t offset, const lv_area_t *area,
+        const lv_color_t *color_p)
+{
+        lv_coord_t w = lv_area_get_width(area);
+        lv_coord_t h = lv_area_get_height(area);
+        lv_coord_t y = (area->y1 + offset) % LV_PORT_DISP_VER_RES;
+
+#ifdef PERFORMANCE_METRICS
+        uint64_t timestamp = gdi_get_sys_uptime_ticks();
+#endif
+
+#if LV_PORT_DISP_DMA_COPY
+        lv_coord_t h_wrap = LV_MAX(y + h - LV_PORT_DISP_VER_RES, 0);
+
+        /* The rows wrapped around are copied on another channel at the same time */
+        frame_copies = h_wrap ? 2 : 1;
+        gdi_dma_copy_async(frame + y * LV_PORT_DISP_HOR_RES + area->x1, color_p, w * sizeof(lv_color_t),
+                LV_PORT_DISP_HOR_RES * sizeof(lv_color_t), w * sizeof(lv_color_t), h - h_wrap,
+                frame_copy_cb, disp_drv);
+        if (h_wrap) {
+                gdi_dma_copy_async(frame + area->x1, color_p + (h - h_wrap) * w, w * sizeof(lv_color_t),
+                        LV_PORT_DISP_HOR_RES * sizeof(lv_color_t), w * sizeof(lv_color_t), h_wrap,
+                        frame_copy_cb, disp_drv);
+        }
+#else
+        for (; h > 0; h--) {
+                lv_memcpy(frame + y * LV_PORT_DISP_HOR_RES + area->x1, color_p, w * sizeof(lv_color_t));
+                color_p += w;
+
+                if (++y == LV_PORT_DISP_VER_RES) {
+                        y = 0;
+                }
+        }
+
+        /* The draw buffer is free again */
+        lv_disp_flush_ready(disp_drv);
+#endif
+
+#ifdef PERFORMANCE_METRICS
+        /* CPU time spent on the copy, see gdi_perf_dma_time() for the time of the DMA */
+        gdi_perf_render_op_time(gdi_convert_ticks_to_us(gdi_get_sys_uptime_ticks() - timestamp),
+                GPU_METRICS_COPY_CPU);
+#endif
+
+        if (frame_area_set) {
+                _lv_area_join(&frame_area, &frame_area, area);
+        }
+        else {
+                lv_area_copy(&frame_area, area);
+                frame_area_set = true;
+        }
+
+        /* The areas of a refresh are transferred at once, out of the frame */
+        if (!lv_disp_flush_is_last(disp_drv)) {
+                return false;
+        }
+
+#if LV_PORT_DISP_DMA_COPY
+        gdi_dma_wait();
+#endif
+        return true;
+}
+
+static void frame_transfer(void)
+{
+        gdi_set_partial_update_area(LAYER_OFFSET_X + frame_area.x1, LAYER_OFFSET_Y + frame_area.y1,
+                LAYER_OFFSET_X + frame_area.x2, LAYER_OFFSET_Y + frame_area.y2);
+        frame_area_set = false;
+
+        gdi_perf_transfer_last(true);
+        frame_transfer_busy = true;
+        gdi_display_update_async(frame_transfer_cb, NULL);
+}
+
+static void frame_transfer_cb(bool underflow, void *user_data)
+{
+        frame_transfer_busy = false;
+
+        /* Trigger event in case task was blocked */
+        OS_EVENT_SIGNAL(flush_evt);
+}
+
+static void frame_wait(void)
+{
+        while (frame_transfer_busy) {
+                disp_wait(NULL);
+        }
+}
+#endif /* FRAME_KEPT_EN */
+
+#if LV_PORT_DISP_OVERLAY_EN
+static bool overlay_render(lv_coord_t x, lv_coord_t y)
+{
+        lv_obj_t *obj = overlay.obj;
+        lv_obj_flag_t hidden = obj->flags & LV_OBJ_FLAG_HIDDEN;
+        lv_img_dsc_t dsc;
+        lv_res_t res;
+        uint32_t px_cnt;
+
+        /* A hidden object is not drawn, show it to the snapshot only */
+        obj->flags &= ~LV_OBJ_FLAG_HIDDEN;
+        overlay.ext_size = _lv_obj_get_ext_draw_size(obj);
+        res = lv_snapshot_take_to_buf(obj, LV_IMG_CF_TRUE_COLOR_ALPHA, &dsc, overlay.buf, overlay.buf_size);
+        obj->flags |= hidden;
+
+        px_cnt = dsc.header.w * dsc.header.h;
+        if (res != LV_RES_OK || px_cnt * sizeof(lv_color32_t) > overlay.buf_size) {
+                return false;
+        }
+
+#if LV_COLOR_DEPTH != 32
+        /* Expand to ARGB8888 in place, from the end since the pixels grow */
+        const uint8_t *src = (const uint8_t *)overlay.buf + px_cnt * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        lv_color32_t *dst = (lv_color32_t *)overlay.buf + px_cnt;
+
+        while (px_cnt--) {
+                lv_color_t c;
+                lv_opa_t opa;
+
+                src -= LV_IMG_PX_SIZE_ALPHA_BYTE;
+                lv_memcpy_small(&c, src, sizeof(c));
+                opa = src[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+
+                dst--;
+                dst->full = lv_color_to32(c);
+                dst->ch.alpha = opa;
+        }
+#endif
+
+        overlay.area.x1 = x - overlay.ext_size;
+        overlay.area.y1 = y - overlay.ext_size;
+        overlay.area.x2 = overlay.area.x1 + dsc.header.w - 1;
+        overlay.area.y2 = overlay.area.y1 + dsc.header.h - 1;
+
+        gdi_set_layer_src(HW_LCDC_LAYER_1, overlay.buf, dsc.header.w, dsc.header.h, GDI_FORMAT_ARGB8888);
+        gdi_set_layer_start(HW_LCDC_LAYER_1, LAYER_OFFSET_X + overlay.area.x1,
+                LAYER_OFFSET_Y + overlay.area.y1);
+
+        return true;
+}
+
+static void overlay_update(const lv_area_t *area)
+{
+        lv_area_t disp_area = { 0, 0, LV_PORT_DISP_HOR_RES - 1, LV_PORT_DISP_VER_RES - 1 };
+        lv_area_t update_area;
+
+        /* The layer settings are applied with the next update */
+        if (!_lv_area_intersect(&update_area, area, &disp_area)) {
+                return;
+        }
+
+        gdi_set_partial_update_area(LAYER_OFFSET_X + update_area.x1, LAYER_OFFSET_Y + update_area.y1,
+                LAYER_OFFSET_X + update_area.x2, LAYER_OFFSET_Y + update_area.y2);
+
+        gdi_perf_transfer_last(true);
+        frame_transfer_busy = true;
+        gdi_display_update_async(frame_transfer_cb, NULL);
+}
+
+static void overlay_delete_cb(lv_event_t *e)
+{
+        lv_port_disp_overlay_detach();
+}
+#endif /* LV_PORT_DISP_OVERLAY_EN */
+
+#if LV_PORT_DISP_VSCROLL_EN
+static bool vscroll_scroll_cb(lv_disp_drv_t *disp_drv, lv_obj_t *obj, lv_coord_t x, lv_coord_t y)
+{
+        lv_disp_t *disp = lv_obj_get_disp(obj);
+        lv_area_t area;
+        uint16_t inv_p;
+
+        if (obj != vscroll.obj || x != 0) {
+                return false;
+        }
+
+        /* Areas still to be drawn moved with the content, their old rows are moved into view */
+        inv_p = disp->inv_p;
+        for (uint16_t i = 0; i < inv_p; i++) {
+                lv_area_copy(&area, &disp->inv_areas[i]);
+                lv_area_move(&area, 0, y);
+                _lv_inv_area(disp, &area);
+        }
+
+        /* Display row r now shows what was on row r - y */
+        vscroll.offset = (vscroll.offset - y) % LV_PORT_DISP_VER_RES;
+        if (vscroll.offset < 0) {
+                vscroll.offset += LV_PORT_DISP_VER_RES;
+        }
+        vscroll.moved = true;
+
+        /* Only the rows scrolled into view are drawn */
+        lv_area_copy(&area, &obj->coords);
+        if (y > 0 && y < LV_PORT_DISP_VER_RES) {
+                area.y2 = area.y1 + y - 1;
+        }
+        else if (y < 0 && y > -LV_PORT_DISP_VER_RES) {
+                area.y1 = area.y2 + y + 1;
+        }
+        lv_obj_invalidate_area(obj, &area);
+
+        return true;
+}
+
+static void vscroll_set_layers(void)
+{
+        lv_coord_t offset = vscroll.offset;
+
+        /* Layer 0 shows the ring from the offset on, layer 1 the rows wrapped around below it */
+        gdi_set_layer_src(HW_LCDC_LAYER_0, vscroll.frame + offset * LV_PORT_DISP_HOR_RES,
+                LV_PORT_DISP_HOR_RES, LV_PORT_DISP_VER_RES - offset, LAYER_COLOR_FMT);
+        gdi_set_layer_start(HW_LCDC_LAYER_0, LAYER_OFFSET_X, LAYER_OFFSET_Y);
+
+        if (offset) {
+                gdi_set_layer_src(HW_LCDC_LAYER_1, vscroll.frame, LV_PORT_DISP_HOR_RES, offset,
+                        LAYER_COLOR_FMT);
+                gdi_set_layer_start(HW_LCDC_LAYER_1, LAYER_OFFSET_X,
+                        LAYER_OFFSET_Y + LV_PORT_DISP_VER_RES - offset);
+        }
+        gdi_set_layer_enable(HW_LCDC_LAYER_1, offset != 0);
+}
+
+static void vscroll_delete_cb(lv_event_t *e)
+{
+        lv_port_disp_vscroll_detach();
+}
+#endif /* LV_PORT_DISP_VSCROLL_EN */
+
 #ifdef PERFORMANCE_METRICS
 static void perf_monitor(lv_disp_drv_t *disp_drv, uint32_t time, uint32_t px)
 {
         time -= gdi_convert_ticks_to_us(flush_evt_wait) / 1000;
         flush_evt_wait = 0;
         gdi_perf_render_time(time * 1000);
+#if FRAME_KEPT_EN && LV_PORT_DISP_DMA_COPY
+        gdi_perf_render_op_time(gdi_perf_dma_time(), GPU_METRICS_COPY_DMA);
+#endif
+
+        /* A frame has been rendered, which completes the opening of a screen */
+        metrics_screen_frame();
 }
 #endif
@@ -49,19 +49,84 @@
 #define LV_PORT_DISP_VER_RES                    (DEMO_RESY)
 #endif
 
+/* Cost of flushing one more invalidated area (LCDC and panel setup, interrupt and draw setup)
+ * expressed in pixels. Areas are joined when it is cheaper to flush their bounding box */
+#ifndef LV_PORT_DISP_FLUSH_OVERHEAD
+#define LV_PORT_DISP_FLUSH_OVERHEAD             (4 * LV_PORT_DISP_HOR_RES)
+#endif
+
+/* An object can be moved on LCDC layer 1 without redrawing or transferring the background.
+ * While an overlay is attached LVGL draws in a single buffer and the other one keeps the frame */
+#ifndef LV_PORT_DISP_OVERLAY
+#define LV_PORT_DISP_OVERLAY                    (1)
+#endif
+
+#define LV_PORT_DISP_OVERLAY_EN                 (LV_PORT_DISP_OVERLAY && LV_USE_SNAPSHOT)
+
+/* Size of the overlay buffer of an object of w x h pixels, its extra draw size included */
+#define LV_PORT_DISP_OVERLAY_BUF_SIZE(w, h)     ((w) * (h) * sizeof(lv_color32_t))
+
+/* Areas are copied into the frame kept for the overlay or the scrolling by the GDI DMA engine. LVGL
+ * meanwhile draws the next area into the other half of the first buffer */
+#ifndef LV_PORT_DISP_DMA_COPY
+#define LV_PORT_DISP_DMA_COPY                   (1)
+#endif
+
+/* A full-screen object scrolled vertically is kept in the second buffer as a ring of rows, which
+ * the LCDC layers show from the scroll offset on. Only the newly exposed rows are drawn */
+#ifndef LV_PORT_DISP_VSCROLL
+#define LV_PORT_DISP_VSCROLL                    (1)
+#endif
+
+#define LV_PORT_DISP_VSCROLL_EN                 (LV_PORT_DISP_VSCROLL && DLG_LVGL_SCROLL_CB)
+
+/* Range of the progress of a transition driven by lv_anim */
+#define LV_PORT_DISP_TRANSITION_RANGE           (1024)
+
 /**********************
  *      TYPEDEFS
  **********************/
+/* The old and the new frame are drawn once, in the two frame buffers, and composed by the LCDC */
+typedef enum {
+        LV_PORT_DISP_TRANSITION_SLIDE,          /* The new frame pushes the old one out */
+        LV_PORT_DISP_TRANSITION_COVER,          /* The new frame moves in over the old one */
+        LV_PORT_DISP_TRANSITION_UNCOVER,        /* The old frame moves out and reveals the new one */
+        LV_PORT_DISP_TRANSITION_FADE,           /* The old frame fades out over the new one */
+} lv_port_disp_transition_type_t;
+
+typedef void (*lv_port_disp_transition_cb_t)(void *user_data);
+
+typedef struct {
+        lv_port_disp_transition_type_t type;
+        lv_dir_t dir;                           /* Direction the frames move to, not used by the fade */
+        uint32_t time;                          /* Duration in msec */
+        lv_anim_path_cb_t path_cb;              /* Easing of the transition */
+        lv_port_disp_transition_cb_t new_frame_cb;      /* Makes the new frame current, e.g. loads a screen */
+        lv_port_disp_transition_cb_t ready_cb;  /* Optional, called once the transition is over */
+        void *user_data;
+} lv_port_disp_transition_dsc_t;
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 void lv_port_disp_init(void);
+void lv_port_disp_transition_dsc_init(lv_port_disp_transition_dsc_t *dsc);
+bool lv_port_disp_transition_start(const lv_port_disp_transition_dsc_t *dsc);
 #if TWO_LAYERS_HORIZONTAL_SLIDING
 void lv_port_disp_slide_init(lv_obj_t *obj, lv_dir_t dir);
 void lv_port_disp_slide(int posXLayer0, int posXLayer1);
 void lv_port_disp_slide_end();
 #endif
+#if LV_PORT_DISP_OVERLAY_EN
+bool lv_port_disp_overlay_attach(lv_obj_t *obj, void *buf, uint32_t buf_size);
+void lv_port_disp_overlay_move(lv_coord_t x, lv_coord_t y);
+void lv_port_disp_overlay_refresh(void);
+void lv_port_disp_overlay_detach(void);
+#endif
+#if LV_PORT_DISP_VSCROLL_EN
+bool lv_port_disp_vscroll_attach(lv_obj_t *obj);
+void lv_port_disp_vscroll_detach(void);
+#endif
 
 /**********************
  *      MACROS
@@ -0,0 +1,414 @@
+/**
+ ****************************************************************************************
+ *
+ * @file lv_port_glyph_atlas.c
+ *
+ * @brief Glyph atlas for GPU text rendering
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lvgl.h"
+#include "lv_port_glyph_atlas.h"
+#include "gdi.h"
+#ifdef PERFORMANCE_METRICS
+#include "metrics.h"
+#endif
+
+#if LV_PORT_GLYPH_ATLAS_EN
+/*********************
+ *      DEFINES
+ *********************/
+#define ATLAS_PAGE_STRIDE                       (LV_PORT_GLYPH_ATLAS_PAGE_WIDTH * LV_PORT_GLYPH_ATLAS_BPP / 8)
+#define ATLAS_PAGE_SIZE                         (ATLAS_PAGE_STRIDE * LV_PORT_GLYPH_ATLAS_PAGE_HEIGHT)
+
+/* Glyphs are packed in rows (shelves) of similar height */
+#define ATLAS_SHELF_NUM                         (16)
+#define ATLAS_SHELF_SLACK                       (4)
+
+#define ATLAS_HASH_SIZE                         (64)
+
+/* Sub-byte pages are written in the bit order of the GPU */
+#if LV_PORT_GLYPH_ATLAS_BPP == 8
+#define ATLAS_CF                                (LV_IMG_CF_ALPHA_8BIT)
+#elif DLG_LVGL_CF == 1
+#define ATLAS_CF                                (LV_IMG_CF_ALPHA_4BIT | LV_IMG_CF_NATIVE_ORDER_FLAG)
+#else
+#define ATLAS_CF                                (LV_IMG_CF_ALPHA_4BIT)
+#endif
+
+#if LV_PORT_GLYPH_ATLAS_PAGE_WIDTH % 8
+#error "LV_PORT_GLYPH_ATLAS_PAGE_WIDTH must be a multiple of 8"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+        const lv_font_t *font;                  /* NULL if the entry is free */
+        uint32_t letter;
+        uint16_t next;                          /* Index + 1 of the next glyph in the hash chain, 0 for none */
+        uint16_t x;
+        uint16_t y;
+        uint8_t page;
+} glyph_entry;
+
+typedef struct {
+        uint16_t y;
+        uint16_t h;
+        uint16_t x;                             /* Start of the free part of the shelf */
+} atlas_shelf;
+
+typedef struct {
+        atlas_shelf shelves[ATLAS_SHELF_NUM];
+        uint8_t shelf_count;
+        uint16_t y;                             /* Start of the area not used by shelves */
+        uint32_t last_use;
+} atlas_page;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static glyph_entry *lv_port_glyph_atlas_find(const lv_font_t *font, uint32_t letter);
+static glyph_entry *lv_port_glyph_atlas_add(const lv_font_t *font, uint32_t letter, const lv_font_glyph_dsc_t *g,
+        const uint8_t *map_p);
+static glyph_entry *lv_port_glyph_atlas_get_free_entry(void);
+static bool lv_port_glyph_atlas_alloc(uint16_t w, uint16_t h, uint8_t *page, uint16_t *x, uint16_t *y);
+static bool lv_port_glyph_atlas_evict(void);
+static void lv_port_glyph_atlas_clear_page(uint8_t page);
+static bool lv_port_glyph_atlas_rasterize(const lv_font_glyph_dsc_t *g, const uint8_t *map_p, uint8_t *dst);
+static uint32_t lv_port_glyph_atlas_hash(const lv_font_t *font, uint32_t letter);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+PRIVILEGED_DATA static uint32_t atlas_mem[LV_PORT_GLYPH_ATLAS_PAGE_NUM][ATLAS_PAGE_SIZE / sizeof(uint32_t)];
+PRIVILEGED_DATA static atlas_page atlas_pages[LV_PORT_GLYPH_ATLAS_PAGE_NUM];
+PRIVILEGED_DATA static glyph_entry glyph_entries[LV_PORT_GLYPH_ATLAS_GLYPH_NUM];
+PRIVILEGED_DATA static uint16_t glyph_hash[ATLAS_HASH_SIZE];
+PRIVILEGED_DATA static uint32_t atlas_use_count;
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+extern const uint8_t _lv_bpp1_opa_table[2];
+extern const uint8_t _lv_bpp2_opa_table[4];
+extern const uint8_t _lv_bpp4_opa_table[16];
+extern const uint8_t _lv_bpp8_opa_table[256];
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool lv_port_glyph_atlas_draw_letter(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area,
+        lv_coord_t dst_pitch, const lv_font_t *font, uint32_t letter, const lv_font_glyph_dsc_t *g,
+        const uint8_t *map_p, const lv_area_t *letter_area, lv_color_t color, lv_opa_t opa,
+        lv_blend_mode_t blend_mode)
+{
+        lv_draw_img_dsc_t dsc;
+        lv_area_t page_area;
+        glyph_entry *entry;
+
+        if (blend_mode != LV_BLEND_MODE_NORMAL && blend_mode != LV_BLEND_MODE_ADDITIVE) {
+                return false;
+        }
+
+        entry = lv_port_glyph_atlas_find(font, letter);
+        if (entry == NULL) {
+                entry = lv_port_glyph_atlas_add(font, letter, g, map_p);
+                if (entry == NULL) {
+                        return false;
+                }
+        }
+        atlas_pages[entry->page].last_use = ++atlas_use_count;
+
+        /* The alpha of the page is colorized with the letter color */
+        lv_draw_img_dsc_init(&dsc);
+        dsc.recolor = color;
+        dsc.opa = opa;
+        dsc.blend_mode = blend_mode;
+        if (!lv_port_gpu_config_blit(disp_drv, &dsc, LV_IMG_CF_TRUE_COLOR, ATLAS_CF, true, false, true, true)) {
+                return false;
+        }
+
+        /* Place the page so that the glyph lands on the letter, the rest is clipped by dst_area */
+        page_area.x1 = letter_area->x1 - entry->x;
+        page_area.y1 = letter_area->y1 - entry->y;
+        page_area.x2 = page_area.x1 + LV_PORT_GLYPH_ATLAS_PAGE_WIDTH - 1;
+        page_area.y2 = page_area.y1 + LV_PORT_GLYPH_ATLAS_PAGE_HEIGHT - 1;
+
+#ifdef PERFORMANCE_METRICS
+        lv_port_gpu_set_metrics_tag(GPU_METRICS_TEXT_GPU);
+#endif
+        lv_port_gpu_blit(disp_drv, dst, dst_area, dst_pitch, (const lv_color_t *)atlas_mem[entry->page],
+                &page_area, opa);
+#ifdef PERFORMANCE_METRICS
+        lv_port_gpu_set_metrics_tag(0);
+#endif
+
+        return true;
+}
+
+bool lv_port_glyph_atlas_is_page(const void *buf)
+{
+        return (const uint8_t *)buf >= (const uint8_t *)atlas_mem &&
+                (const uint8_t *)buf < (const uint8_t *)atlas_mem + sizeof(atlas_mem);
+}
+
+void lv_port_glyph_atlas_flush(void)
+{
+        while (lv_port_glyph_atlas_evict());
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static glyph_entry *lv_port_glyph_atlas_find(const lv_font_t *font, uint32_t letter)
+{
+        uint16_t i = glyph_hash[lv_port_glyph_atlas_hash(font, letter)];
+
+        while (i) {
+                glyph_entry *entry = &glyph_entries[i - 1];
+
+                if (entry->font == font && entry->letter == letter) {
+                        return entry;
+                }
+                i = entry->next;
+        }
+
+        return NULL;
+}
+
+static glyph_entry *lv_port_glyph_atlas_add(const lv_font_t *font, uint32_t letter, const lv_font_glyph_dsc_t *g,
+        const uint8_t *map_p)
+{
+        glyph_entry *entry;
+        uint16_t x, y;
+        uint8_t page;
+        uint32_t hash;
+
+        if (g->box_w > LV_PORT_GLYPH_ATLAS_PAGE_WIDTH || g->box_h > LV_PORT_GLYPH_ATLAS_PAGE_HEIGHT) {
+                return NULL;
+        }
+
+        while ((entry = lv_port_glyph_atlas_get_free_entry()) == NULL) {
+                if (!lv_port_glyph_atlas_evict()) {
+                        return NULL;
+                }
+        }
+
+        /* Clear the least recently used pages until the glyph fits */
+        while (!lv_port_glyph_atlas_alloc(g->box_w, g->box_h, &page, &x, &y)) {
+                if (!lv_port_glyph_atlas_evict()) {
+                        return NULL;
+                }
+        }
+
+#ifdef PERFORMANCE_METRICS
+        uint64_t raster_start = gdi_get_sys_uptime_ticks();
+#endif
+        if (!lv_port_glyph_atlas_rasterize(g, map_p, (uint8_t *)atlas_mem[page] + y * ATLAS_PAGE_STRIDE +
+                x * LV_PORT_GLYPH_ATLAS_BPP / 8)) {
+                return NULL;
+        }
+#ifdef PERFORMANCE_METRICS
+        gdi_perf_render_op_time(gdi_convert_ticks_to_us(gdi_get_sys_uptime_ticks() - raster_start),
+                GPU_METRICS_TEXT_CPU);
+#endif
+
+        entry->font = font;
+        entry->letter = letter;
+        entry->page = page;
+        entry->x = x;
+        entry->y = y;
+
+        hash = lv_port_glyph_atlas_hash(font, letter);
+        entry->next = glyph_hash[hash];
+        glyph_hash[hash] = entry - glyph_entries + 1;
+
+        return entry;
+}
+
+static glyph_entry *lv_port_glyph_atlas_get_free_entry(void)
+{
+        for (int i = 0; i < LV_PORT_GLYPH_ATLAS_GLYPH_NUM; i++) {
+                if (glyph_entries[i].font == NULL) {
+                        return &glyph_entries[i];
+                }
+        }
+
+        return NULL;
+}
+
+static bool lv_port_glyph_atlas_alloc(uint16_t w, uint16_t h, uint8_t *page, uint16_t *x, uint16_t *y)
+{
+#if LV_PORT_GLYPH_ATLAS_BPP == 4
+        /* Glyphs start on a byte boundary */
+        w = (w + 1) & ~1;
+#endif
+        for (uint8_t p = 0; p < LV_PORT_GLYPH_ATLAS_PAGE_NUM; p++) {
+                atlas_page *atlas = &atlas_pages[p];
+
+                /* Use an existing shelf which is not much higher than the glyph */
+                for (uint8_t i = 0; i < atlas->shelf_count; i++) {
+                        atlas_shelf *shelf = &atlas->shelves[i];
+
+                        if (h <= shelf->h && shelf->h - h <= ATLAS_SHELF_SLACK &&
+                                shelf->x + w <= LV_PORT_GLYPH_ATLAS_PAGE_WIDTH) {
+                                *page = p;
+                                *x = shelf->x;
+                                *y = shelf->y;
+                                shelf->x += w;
+                                return true;
+                        }
+                }
+
+                /* Otherwise open a new shelf */
+                if (atlas->shelf_count < ATLAS_SHELF_NUM && atlas->y + h <= LV_PORT_GLYPH_ATLAS_PAGE_HEIGHT) {
+                        atlas_shelf *shelf = &atlas->shelves[atlas->shelf_count++];
+
+                        shelf->y = atlas->y;
+                        shelf->h = h;
+                        shelf->x = w;
+                        atlas->y += h;
+                        *page = p;
+                        *x = 0;
+                        *y = shelf->y;
+                        return true;
+                }
+        }
+
+        return false;
+}
+
+static bool lv_port_glyph_atlas_evict(void)
+{
+        lv_disp_t *disp;
+        int lru = -1;
+
+        for (int i = 0; i < LV_PORT_GLYPH_ATLAS_PAGE_NUM; i++) {
+                if (atlas_pages[i].shelf_count && (lru < 0 || atlas_pages[i].last_use < atlas_pages[lru].last_use)) {
+                        lru = i;
+                }
+        }
+
+        if (lru < 0) {
+                return false;
+        }
+
+        /* Blits already queued to the GPU may still read the page */
+        disp = _lv_refr_get_disp_refreshing();
+        if (disp == NULL) {
+                disp = lv_disp_get_default();
+        }
+        if (disp && disp->driver->gpu_wait_cb) {
+                disp->driver->gpu_wait_cb(disp->driver);
+        }
+
+        lv_port_glyph_atlas_clear_page(lru);
+
+        return true;
+}
+
+static void lv_port_glyph_atlas_clear_page(uint8_t page)
+{
+        for (int i = 0; i < ATLAS_HASH_SIZE; i++) {
+                uint16_t *link = &glyph_hash[i];
+
+                while (*link) {
+                        glyph_entry *entry = &glyph_entries[*link - 1];
+
+                        if (entry->page == page) {
+                                *link = entry->next;
+                                entry->font = NULL;
+                        } else {
+                                link = &entry->next;
+                        }
+                }
+        }
+
+        lv_memset_00(&atlas_pages[page], sizeof(atlas_page));
+        lv_memset_00(atlas_mem[page], ATLAS_PAGE_SIZE);
+}
+
+static bool lv_port_glyph_atlas_rasterize(const lv_font_glyph_dsc_t *g, const uint8_t *map_p, uint8_t *dst)
+{
+        const uint8_t *opa_table;
+        uint32_t bpp = g->bpp;
+        uint32_t bit_pos = 0;
+
+        /* 3 bpp glyphs are stored as 4 bpp, like in draw_letter_normal() */
+        if (bpp == 3) {
+                bpp = 4;
+        }
+
+        switch (bpp) {
+        case 1:
+                opa_table = _lv_bpp1_opa_table;
+                break;
+        case 2:
+                opa_table = _lv_bpp2_opa_table;
+                break;
+        case 4:
+                opa_table = _lv_bpp4_opa_table;
+                break;
+        case 8:
+                opa_table = _lv_bpp8_opa_table;
+                break;
+        default:
+                return false;
+        }
+
+        /* The rows of the glyph bitmap are not padded */
+        for (uint16_t y = 0; y < g->box_h; y++) {
+                uint8_t *dst_row = dst + y * ATLAS_PAGE_STRIDE;
+
+                for (uint16_t x = 0; x < g->box_w; x++) {
+                        uint8_t shift = 8 - bpp - (bit_pos & 7);
+                        uint8_t opa = opa_table[(map_p[bit_pos >> 3] >> shift) & ((1 << bpp) - 1)];
+
+                        bit_pos += bpp;
+#if LV_PORT_GLYPH_ATLAS_BPP == 8
+                        dst_row[x] = opa;
+#elif DLG_LVGL_CF == 1
+                        /* The first pixel is in the low nibble */
+                        dst_row[x >> 1] |= (x & 1) ? (opa & 0xF0) : (opa >> 4);
+#else
+                        dst_row[x >> 1] |= (x & 1) ? (opa >> 4) : (opa & 0xF0);
+#endif
+                }
+        }
+
+        return true;
+}
+
+static uint32_t lv_port_glyph_atlas_hash(const lv_font_t *font, uint32_t letter)
+{
+        return (((uintptr_t)font >> 2) + letter * 31) % ATLAS_HASH_SIZE;
+}
+
+#endif /* LV_PORT_GLYPH_ATLAS_EN */
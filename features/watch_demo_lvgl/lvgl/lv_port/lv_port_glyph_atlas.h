@@ -0,0 +1,93 @@
+/**
+ ****************************************************************************************
+ *
+ * @file lv_port_glyph_atlas.h
+ *
+ * @brief Glyph atlas for GPU text rendering
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#ifndef LV_PORT_GLYPH_ATLAS_H_
+#define LV_PORT_GLYPH_ATLAS_H_
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+#include "lv_port_gpu.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/* Number of atlas pages in which glyphs are rasterized once and then drawn by the GPU. The least
+ * recently used page is cleared when a glyph does not fit. If 0, letters are drawn by the CPU */
+#ifndef LV_PORT_GLYPH_ATLAS_PAGE_NUM
+#define LV_PORT_GLYPH_ATLAS_PAGE_NUM            (2)
+#endif
+
+/* Size of an atlas page in pixels. The width must be a multiple of 8 */
+#ifndef LV_PORT_GLYPH_ATLAS_PAGE_WIDTH
+#define LV_PORT_GLYPH_ATLAS_PAGE_WIDTH          (256)
+#endif
+
+#ifndef LV_PORT_GLYPH_ATLAS_PAGE_HEIGHT
+#define LV_PORT_GLYPH_ATLAS_PAGE_HEIGHT         (64)
+#endif
+
+/* Bits per pixel of the atlas pages, 8 (A8) or 4 (A4) which halves the memory for 16 shades */
+#ifndef LV_PORT_GLYPH_ATLAS_BPP
+#define LV_PORT_GLYPH_ATLAS_BPP                 (8)
+#endif
+
+/* Maximum number of glyphs kept in the atlas pages */
+#ifndef LV_PORT_GLYPH_ATLAS_GLYPH_NUM
+#define LV_PORT_GLYPH_ATLAS_GLYPH_NUM           (128)
+#endif
+
+#define LV_PORT_GLYPH_ATLAS_EN                  (LV_PORT_DISP_GPU_EN && LV_PORT_GLYPH_ATLAS_PAGE_NUM > 0)
+
+#if LV_PORT_GLYPH_ATLAS_EN && LV_PORT_GLYPH_ATLAS_BPP != 8 && LV_PORT_GLYPH_ATLAS_BPP != 4
+#error "LV_PORT_GLYPH_ATLAS_BPP must be 8 or 4"
+#endif
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+#if LV_PORT_GLYPH_ATLAS_EN
+/* Draw a letter out of the atlas, used as `gpu_draw_letter_cb` of the display driver */
+bool lv_port_glyph_atlas_draw_letter(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area,
+        lv_coord_t dst_pitch, const lv_font_t *font, uint32_t letter, const lv_font_glyph_dsc_t *g,
+        const uint8_t *map_p, const lv_area_t *letter_area, lv_color_t color, lv_opa_t opa,
+        lv_blend_mode_t blend_mode);
+
+/* Check whether a buffer is an atlas page, which stays valid while GPU operations are queued */
+bool lv_port_glyph_atlas_is_page(const void *buf);
+
+/* Drop every glyph of the atlas */
+void lv_port_glyph_atlas_flush(void);
+#endif /* LV_PORT_GLYPH_ATLAS_EN */
+
+#endif /* LV_PORT_GLYPH_ATLAS_H_ */
@@ -31,10 +31,13 @@
  *      INCLUDES
  *********************/
 
-#include <math.h>
 #include "lvgl.h"
 #include "lv_port_gpu.h"
+#include "lv_port_gpu_shape.h"
 #include "lv_port_disp.h"
+#include "lv_port_glyph_atlas.h"
+#include "lv_port_shadow_cache.h"
+#include "lv_port_snapshot.h"
 #include "dave_driver.h"
 #ifdef PERFORMANCE_METRICS
 #include "metrics.h"
@@ -70,6 +73,16 @@
 #endif
 #define CEILING_FUNC(quotient, divisor)         (((quotient) + ((divisor) - 1)) / (divisor))
 
+/* Cached D/AVE2D state */
+#define GPU_STATE_FRAMEBUFFER                   (1 << 0)
+#define GPU_STATE_CLIPRECT                      (1 << 1)
+#define GPU_STATE_BLENDMODE                     (1 << 2)
+#define GPU_STATE_ALPHABLENDMODE                (1 << 3)
+#define GPU_STATE_ALPHA                         (1 << 4)
+
+/* Slice settings are kept per texel size: up to 8, 16 and 32 bpp */
+#define SLICE_FORMAT_NUM                        (3)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -79,11 +92,36 @@ typedef struct {
         int line;
 } log_error_entry;
 
+#if LV_PORT_GPU_PIPELINE
+typedef struct {
+        const lv_color_t *dst;
+        lv_area_t area;
+} pending_area_entry;
+#endif
+
+typedef struct {
+        uint8_t width;          /* 0: no slicing */
+        bool horizontal;
+} slice_entry;
+
+typedef struct {
+        uint8_t valid;
+        void *fb;
+        d2_s32 pitch;
+        d2_u32 width;
+        d2_u32 height;
+        d2_s32 format;
+        d2_border clip_x1, clip_y1, clip_x2, clip_y2;
+        d2_u32 blend_src, blend_dst;
+        d2_u32 alpha_blend_src, alpha_blend_dst;
+        d2_alpha alpha;
+} gpu_state_cache;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_PORT_DISP_GPU_EN
-static void lv_port_gpu_rotate_point(int *x, int *y, float cos_angle, float sin_angle, int pivot_x, int pivot_y);
+static void lv_port_gpu_rotate_point(int *x, int *y, int32_t cos_angle, int32_t sin_angle, int pivot_x, int pivot_y);
 static void lv_port_gpu_config_blit_clear(void);
 static void lv_port_gpu_blit_internal(lv_disp_drv_t *disp_drv, const lv_area_t * dst_area, const lv_color_t *src,
         const lv_area_t * src_area, d2_u32 flags);
@@ -103,7 +141,31 @@ static bool lv_port_gpu_cf_fb_valid(d2_s32 cf);
 static d2_color lv_port_gpu_color_lv_to_d2(lv_color_t color);
 static void lv_port_gpu_start_render(void);
 static void lv_port_gpu_execute_render(void);
+static void lv_port_gpu_submit_render(void);
 static void lv_port_gpu_complete_render(void);
+static bool lv_port_gpu_src_is_transient(const void *src);
+static slice_entry *lv_port_gpu_slice_get(bool filter, int bpp, int16_t angle);
+static void lv_port_gpu_render_quad_clipped(const d2_point *quad, d2_border x1, d2_border y1, d2_border x2, d2_border y2);
+static void lv_port_gpu_start_shape(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area,
+        lv_coord_t dst_pitch, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+static void lv_port_gpu_end_shape(lv_color_t *dst, const lv_area_t *dst_area);
+static void lv_port_gpu_render_rect_shape(const lv_area_t *clip, const lv_area_t *outer, lv_coord_t rout,
+        const lv_area_t *inner, lv_coord_t rin);
+static void lv_port_gpu_render_rect_box(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2);
+static void lv_port_gpu_render_rect_corner(const lv_area_t *clip, const lv_area_t *corner, d2_point cx, d2_point cy,
+        lv_coord_t rout, lv_coord_t rin);
+static void lv_port_gpu_render_shadow_slice(const lv_area_t *clip, const lv_area_t *slice, const lv_area_t *bg_area,
+        lv_coord_t r_bg, lv_coord_t src_x, lv_coord_t src_y, lv_coord_t src_w, lv_coord_t src_h,
+        lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h, d2_u32 flags);
+static d2_s32 lv_port_gpu_set_framebuffer(lv_disp_drv_t *disp_drv, void *dst, d2_s32 pitch, d2_u32 width,
+        d2_u32 height, d2_s32 format);
+static d2_s32 lv_port_gpu_set_cliprect(d2_border x1, d2_border y1, d2_border x2, d2_border y2);
+static d2_s32 lv_port_gpu_set_blendmode(d2_u32 src, d2_u32 dst);
+static d2_s32 lv_port_gpu_set_alphablendmode(d2_u32 src, d2_u32 dst);
+static d2_s32 lv_port_gpu_set_alpha(d2_alpha alpha);
+#if LV_PORT_GPU_PIPELINE
+static void lv_port_gpu_pending_add(const lv_color_t *dst, const lv_area_t *area, const void *src);
+#endif
 #ifdef LOG_ERRORS
 static void lv_port_gpu_log_error(d2_s32 status, const char *func, int line);
 #endif
@@ -117,12 +179,28 @@ PRIVILEGED_DATA static d2_s32 src_cf_val, dst_cf_val;
 PRIVILEGED_DATA static lv_draw_img_dsc_t img_dsc;
 #if LV_PORT_DISP_GPU_SUB_BYTE_SWAP
 PRIVILEGED_DATA static const lv_color_t *buf;
+PRIVILEGED_DATA static bool src_native_order;
 #endif
 
 INITIALISED_PRIVILEGED_DATA static bool d2_enabled = SCENARIO != ORIGINAL ? 1 : 0;
 PRIVILEGED_DATA static d1_device *d1_handle;
 PRIVILEGED_DATA static d2_device *d2_handle;
 PRIVILEGED_DATA static d2_renderbuffer *renderbuffer;
+PRIVILEGED_DATA static d2_renderbuffer *renderbuffer_pool[LV_PORT_GPU_RENDERBUFFER_NUM];
+PRIVILEGED_DATA static bool renderbuffer_open;
+PRIVILEGED_DATA static int renderbuffer_op_count;
+PRIVILEGED_DATA static gpu_state_cache gpu_state;
+PRIVILEGED_DATA static slice_entry slice_table[2][SLICE_FORMAT_NUM][LV_PORT_GPU_SLICE_ANGLE_STEPS];
+#if LV_PORT_GPU_SLICE_CALIBRATION
+PRIVILEGED_DATA static const slice_entry *slice_override;
+#endif
+#if LV_PORT_GPU_PIPELINE
+PRIVILEGED_DATA static int renderbuffer_index;
+PRIVILEGED_DATA static pending_area_entry pending_area_list[LV_PORT_GPU_PENDING_AREAS_NUM];
+PRIVILEGED_DATA static int pending_area_count;
+/* Set when in-flight GPU work must complete before any further CPU drawing */
+PRIVILEGED_DATA static bool pending_sync;
+#endif
 #ifdef LOG_ERRORS
 PRIVILEGED_DATA static log_error_entry log_error_list[ERROR_LIST_SIZE];
 PRIVILEGED_DATA static int error_list_index;
@@ -131,6 +209,7 @@ PRIVILEGED_DATA static int error_count;
 
 #ifdef PERFORMANCE_METRICS
 PRIVILEGED_DATA static uint8_t metrics_tag;
+PRIVILEGED_DATA static uint8_t metrics_tag_override;
 #endif
 #if LV_PORT_DISP_GPU_SUB_BYTE_SWAP
 static const d2_color mirror_1BLUT[] =
@@ -245,6 +324,15 @@ static const d2_color mirror_4BLUT[] =
 void lv_port_gpu_init(void)
 {
         lv_port_gpu_config_blit_clear();
+
+        for (int format = 0; format < SLICE_FORMAT_NUM; format++) {
+                for (int step = 0; step < LV_PORT_GPU_SLICE_ANGLE_STEPS; step++) {
+                        slice_table[0][format][step].width = LV_PORT_GPU_SLICE_WIDTH;
+                        slice_table[0][format][step].horizontal = false;
+                        slice_table[1][format][step].width = LV_PORT_GPU_SLICE_WIDTH_FILTER;
+                        slice_table[1][format][step].horizontal = false;
+                }
+        }
 }
 
 void lv_port_gpu_fill(lv_disp_drv_t *disp_drv, lv_color_t *dst, lv_coord_t dst_width,
@@ -252,33 +340,32 @@ void lv_port_gpu_fill(lv_disp_drv_t *disp_drv, lv_color_t *dst, lv_coord_t dst_w
 {
         lv_port_gpu_start_render();
 
-        D2_EXEC(d2_framebuffer(d2_handle, d1_maptovidmem(d1_handle, dst), MAX(dst_width, 2), MAX(dst_width, 2),
+        D2_EXEC(lv_port_gpu_set_framebuffer(disp_drv, dst, MAX(dst_width, 2), MAX(dst_width, 2),
                 MAX(fill_area->y2 + 1, 2), lv_port_gpu_cf_get_default()));
-        D2_EXEC(d2_cliprect(d2_handle, 0, 0, dst_width - 1, fill_area->y2));
+        D2_EXEC(lv_port_gpu_set_cliprect(0, 0, gpu_state.width - 1, gpu_state.height - 1));
 
-        D2_EXEC(d2_setalpha(d2_handle, opa > LV_OPA_MAX ? 0xFF : opa));
+        D2_EXEC(lv_port_gpu_set_alpha(opa > LV_OPA_MAX ? 0xFF : opa));
         D2_EXEC(d2_setcolor(d2_handle, 0, lv_port_gpu_color_lv_to_d2(color)));
         D2_EXEC(d2_renderbox(d2_handle, D2_FIX4(fill_area->x1), D2_FIX4(fill_area->y1),
                 D2_FIX4(lv_area_get_width(fill_area)), D2_FIX4(lv_area_get_height(fill_area))));
 
 #ifdef PERFORMANCE_METRICS
-        metrics_tag = GPU_METRICS_FILL;
+        metrics_tag = metrics_tag_override ? metrics_tag_override : GPU_METRICS_FILL;
 #endif
         lv_port_gpu_execute_render();
+#if LV_PORT_GPU_PIPELINE
+        lv_port_gpu_pending_add(dst, fill_area, NULL);
+#endif
 }
 
-static void lv_port_gpu_rotate_point(int *x, int *y, float cos_angle, float sin_angle, int pivot_x, int pivot_y)
+/* Rotate a D2_FIX4 point, cos_angle and sin_angle are in Q15 (see lv_trigo_sin_fine()) */
+static void lv_port_gpu_rotate_point(int *x, int *y, int32_t cos_angle, int32_t sin_angle, int pivot_x, int pivot_y)
 {
-        float fx, fy;
-
-        *x -= pivot_x;
-        *y -= pivot_y;
+        int32_t fx = *x - pivot_x;
+        int32_t fy = *y - pivot_y;
 
-        fx = ((float)*x) / 16.0f;
-        fy = ((float)*y) / 16.0f;
-
-        *x = (int)(((fx * cos_angle) - (fy * sin_angle)) * 16.0f);
-        *y = (int)(((fx * sin_angle) + (fy * cos_angle)) * 16.0f);
+        *x = (int)((((int64_t)fx * cos_angle - (int64_t)fy * sin_angle) + (1 << (LV_TRIGO_SHIFT - 1))) >> LV_TRIGO_SHIFT);
+        *y = (int)((((int64_t)fx * sin_angle + (int64_t)fy * cos_angle) + (1 << (LV_TRIGO_SHIFT - 1))) >> LV_TRIGO_SHIFT);
 
         *x += pivot_x;
         *y += pivot_y;
@@ -330,7 +417,7 @@ static void lv_port_gpu_blit_internal(lv_disp_drv_t *disp_drv, const lv_area_t *
         d2_s32 pitch;
         int bpp = lv_port_gpu_cf_bpp(src_cf_val);
 
-        D2_EXEC(d2_cliprect(d2_handle, dst_area->x1, dst_area->y1, dst_area->x2, dst_area->y2));
+        D2_EXEC(lv_port_gpu_set_cliprect(dst_area->x1, dst_area->y1, dst_area->x2, dst_area->y2));
 
         pitch = w = lv_area_get_width(src_area);
         h = lv_area_get_height(src_area);
@@ -358,16 +445,15 @@ static void lv_port_gpu_blit_internal(lv_disp_drv_t *disp_drv, const lv_area_t *
                         D2_FIX4(img_w), D2_FIX4(img_h), D2_FIX4(img_area->x1), D2_FIX4(img_area->y1), flags));
 
 #ifdef PERFORMANCE_METRICS
-                metrics_tag = GPU_METRICS_BLITBITMAP;
+                metrics_tag = metrics_tag_override ? metrics_tag_override : GPU_METRICS_BLITBITMAP;
 #endif
         } else {
                 int x, y, x1, y1, x2, y2, x3, y3, x4, y4, dxu, dxv, dyu, dyv, xx, xy, yx, yy;
                 int pivot_scaled_x, pivot_scaled_y;
                 int tex_offset = (flags & d2_bf_filter) ? -32767 : 0;
                 d2_u8 amode, cmode = d2_to_copy;
-                float angle = ((float)img_dsc.angle / 10) * M_PI / 180;
-                float cos_angle = cosf(angle);
-                float sin_angle = sinf(angle);
+                int32_t cos_angle = lv_trigo_cos_fine(img_dsc.angle);
+                int32_t sin_angle = lv_trigo_sin_fine(img_dsc.angle);
                 d2_u8 fillmode_backup;
 
                 /* setup texture params */
@@ -405,11 +491,11 @@ static void lv_port_gpu_blit_internal(lv_disp_drv_t *disp_drv, const lv_area_t *
                 lv_port_gpu_rotate_point(&x3, &y3, cos_angle, sin_angle, pivot_scaled_x, pivot_scaled_y);
                 lv_port_gpu_rotate_point(&x4, &y4, cos_angle, sin_angle, pivot_scaled_x, pivot_scaled_y);
 
-                /* compute texture increments */
-                xx = (int)(cos_angle * 65536.0f);
-                xy = (int)(sin_angle * 65536.0f);
-                yx = (int)(-sin_angle * 65536.0f);
-                yy = (int)(cos_angle * 65536.0f);
+                /* compute texture increments (D2_FIX16) */
+                xx = cos_angle * (1 << (16 - LV_TRIGO_SHIFT));
+                xy = sin_angle * (1 << (16 - LV_TRIGO_SHIFT));
+                yx = -sin_angle * (1 << (16 - LV_TRIGO_SHIFT));
+                yy = cos_angle * (1 << (16 - LV_TRIGO_SHIFT));
                 dxu = ((D2_FIX16(w) / D2_FIX4(img_w)) * xx) >> 12;
                 dxv = ((D2_FIX16(w) / D2_FIX4(img_w)) * xy) >> 12;
                 dyu = ((D2_FIX16(h) / D2_FIX4(img_h)) * yx) >> 12;
@@ -420,22 +506,28 @@ static void lv_port_gpu_blit_internal(lv_disp_drv_t *disp_drv, const lv_area_t *
                 D2_EXEC(d2_settexturemapping(d2_handle, (d2_point )(x + x1), (d2_point )(y + y1),
                         tex_offset, tex_offset, dxu, dxv, dyu, dyv));
 
+                const d2_point quad[8] = { x + x1, y + y1, x + x2, y + y2, x + x3, y + y3, x + x4, y + y4 };
                 int minx = MAX(dst_area->x1, D2_INT4(x + MIN(x1, MIN(x2, MIN(x3, x4)))));
                 int maxx = MIN(dst_area->x2, D2_INT4(x + MAX(x1, MAX(x2, MAX(x3, x4)))));
-                int slice = (flags & d2_bf_filter) ? 6 : 8;
-
-                /* Perform render operation in slices to acheive better performance */
-                for (int posx = minx; posx < maxx; posx += slice) {
-                        D2_EXEC(d2_cliprect(d2_handle, posx, dst_area->y1, MIN(posx + slice - 1, maxx), dst_area->y2));
-                        D2_EXEC(d2_renderquad(d2_handle, (d2_point )(x + x1), (d2_point )(y + y1),
-                                                         (d2_point )(x + x2), (d2_point )(y + y2),
-                                                         (d2_point )(x + x3), (d2_point )(y + y3),
-                                                         (d2_point )(x + x4), (d2_point )(y + y4), 0));
+                int miny = MAX(dst_area->y1, D2_INT4(y + MIN(y1, MIN(y2, MIN(y3, y4)))));
+                int maxy = MIN(dst_area->y2, D2_INT4(y + MAX(y1, MAX(y2, MAX(y3, y4)))));
+                const slice_entry *slice = lv_port_gpu_slice_get(flags & d2_bf_filter, bpp, img_dsc.angle);
+                int step = slice->width ? slice->width : MAX(maxx - minx, maxy - miny) + 1;
+
+                /* Perform render operation in slices to improve the texture cache hit rate */
+                if (slice->horizontal) {
+                        for (int posy = miny; posy <= maxy; posy += step) {
+                                lv_port_gpu_render_quad_clipped(quad, minx, posy, maxx, MIN(posy + step - 1, maxy));
+                        }
+                } else {
+                        for (int posx = minx; posx <= maxx; posx += step) {
+                                lv_port_gpu_render_quad_clipped(quad, posx, miny, MIN(posx + step - 1, maxx), maxy);
+                        }
                 }
                 D2_EXEC(d2_setfillmode(d2_handle, fillmode_backup));
 
 #ifdef PERFORMANCE_METRICS
-                metrics_tag = GPU_METRICS_ROTATEIMAGE;
+                metrics_tag = metrics_tag_override ? metrics_tag_override : GPU_METRICS_ROTATEIMAGE;
 #endif
         }
 }
@@ -450,17 +542,25 @@ void lv_port_gpu_blit(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t
         clut_len = lv_port_gpu_handle_indexed_color(&src, &clut, src_cf_val);
 
 #if LV_PORT_DISP_GPU_SUB_BYTE_SWAP
-        src = lv_port_gpu_fix_order(src, src_area, src_cf_val);
+        /* Images converted offline are already in the bit order expected by the GPU */
+        if (!src_native_order) {
+                src = lv_port_gpu_fix_order(src, src_area, src_cf_val);
+        }
 #endif
 
+        /* The CLUT is written directly to the hardware, pending operations must use the previous one */
+        if (clut) {
+                lv_port_gpu_complete_render();
+        }
+
         lv_port_gpu_start_render();
 
-        D2_EXEC(d2_framebuffer(d2_handle, d1_maptovidmem(d1_handle, dst), MAX(dst_pitch, 2),
+        D2_EXEC(lv_port_gpu_set_framebuffer(disp_drv, dst, MAX(dst_pitch, 2),
                 MAX(dst_area->x2 + 1, 2), MAX(dst_area->y2 + 1, 2), dst_cf_val));
 
         flags |= alpha_enabled ? d2_bf_usealpha : 0;
 
-        D2_EXEC(d2_setalpha(d2_handle, opa > LV_OPA_MAX ? LV_OPA_COVER : opa));
+        D2_EXEC(lv_port_gpu_set_alpha(opa > LV_OPA_MAX ? LV_OPA_COVER : opa));
 
         if (clut) {
                 D2_EXEC(d2_writetexclut_direct(d2_handle, clut, 0, clut_len));
@@ -483,17 +583,24 @@ void lv_port_gpu_blit(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t
         flags |= ((img_dsc.angle || img_dsc.zoom != LV_IMG_ZOOM_NONE) && img_dsc.antialias) ? d2_bf_filter : 0;
 
         if (blend_enabled) {
-                D2_EXEC(d2_setblendmode(d2_handle, d2_bm_alpha,
+                D2_EXEC(lv_port_gpu_set_blendmode(d2_bm_alpha,
                         img_dsc.blend_mode != LV_BLEND_MODE_NORMAL ? d2_bm_one : d2_bm_one_minus_alpha));
-                D2_EXEC(d2_setalphablendmode(d2_handle, d2_bm_one, d2_bm_one_minus_alpha));
+                D2_EXEC(lv_port_gpu_set_alphablendmode(d2_bm_one, d2_bm_one_minus_alpha));
         } else {
-                D2_EXEC(d2_setblendmode(d2_handle, d2_bm_one, d2_bm_zero));
-                D2_EXEC(d2_setalphablendmode(d2_handle, d2_bm_one, d2_bm_zero));
+                D2_EXEC(lv_port_gpu_set_blendmode(d2_bm_one, d2_bm_zero));
+                D2_EXEC(lv_port_gpu_set_alphablendmode(d2_bm_one, d2_bm_zero));
         }
 
         lv_port_gpu_blit_internal(disp_drv, dst_area, src, src_area, flags);
 
         lv_port_gpu_execute_render();
+#if LV_PORT_GPU_PIPELINE
+        lv_port_gpu_pending_add(dst, dst_area, src);
+#endif
+        /* The source may be modified as soon as we return, do not keep it in the batch */
+        if (lv_port_gpu_src_is_transient(src)) {
+                lv_port_gpu_submit_render();
+        }
 }
 
 void lv_port_gpu_blit_with_mask(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t * dst_area, lv_coord_t dst_pitch,
@@ -510,9 +617,17 @@ void lv_port_gpu_blit_with_mask(lv_disp_drv_t *disp_drv, lv_color_t *dst, const
         clut_len = lv_port_gpu_handle_indexed_color(&src, &clut, src_cf_val);
 
 #if LV_PORT_DISP_GPU_SUB_BYTE_SWAP
-        src = lv_port_gpu_fix_order(src, src_area, src_cf_val);
+        /* Images converted offline are already in the bit order expected by the GPU */
+        if (!src_native_order) {
+                src = lv_port_gpu_fix_order(src, src_area, src_cf_val);
+        }
 #endif
 
+        /* The CLUT is written directly to the hardware, pending operations must use the previous one */
+        if (clut) {
+                lv_port_gpu_complete_render();
+        }
+
         lv_port_gpu_start_render();
 
         /*
@@ -527,12 +642,12 @@ void lv_port_gpu_blit_with_mask(lv_disp_drv_t *disp_drv, lv_color_t *dst, const
         lv_area_copy(&src_area_rel, src_area);
         lv_area_move(&src_area_rel, -dst_area->x1, -dst_area->y1);
 
-        D2_EXEC(d2_framebuffer(d2_handle, d1_maptovidmem(d1_handle, work_buf), MAX(lv_area_get_width(&buf_area), 2),
+        D2_EXEC(lv_port_gpu_set_framebuffer(disp_drv, work_buf, MAX(lv_area_get_width(&buf_area), 2),
                 MAX(lv_area_get_width(&buf_area), 2), MAX(lv_area_get_height(&buf_area), 2), d2_mode_argb8888));
 
         flags |= alpha_enabled ? d2_bf_usealpha : 0;
 
-        D2_EXEC(d2_setalpha(d2_handle, opa > LV_OPA_MAX ? LV_OPA_COVER : opa));
+        D2_EXEC(lv_port_gpu_set_alpha(opa > LV_OPA_MAX ? LV_OPA_COVER : opa));
 
         if (clut) {
                 D2_EXEC(d2_writetexclut_direct(d2_handle, clut, 0, clut_len));
@@ -555,8 +670,8 @@ void lv_port_gpu_blit_with_mask(lv_disp_drv_t *disp_drv, lv_color_t *dst, const
         flags |= ((img_dsc.angle || img_dsc.zoom != LV_IMG_ZOOM_NONE) && img_dsc.antialias) ? d2_bf_filter : 0;
 
         /* Do not blend, simple overlay */
-        D2_EXEC(d2_setblendmode(d2_handle, d2_bm_one, d2_bm_zero));
-        D2_EXEC(d2_setalphablendmode(d2_handle, d2_bm_one, d2_bm_zero));
+        D2_EXEC(lv_port_gpu_set_blendmode(d2_bm_one, d2_bm_zero));
+        D2_EXEC(lv_port_gpu_set_alphablendmode(d2_bm_one, d2_bm_zero));
 
         lv_port_gpu_blit_internal(disp_drv, &buf_area, src, &src_area_rel, flags);
 
@@ -569,10 +684,10 @@ void lv_port_gpu_blit_with_mask(lv_disp_drv_t *disp_drv, lv_color_t *dst, const
         img_dsc.zoom = LV_IMG_ZOOM_NONE;
         src_cf_val = d2_mode_alpha8;
 
-        D2_EXEC(d2_setalpha(d2_handle, 0xFF));
+        D2_EXEC(lv_port_gpu_set_alpha(0xFF));
 
-        D2_EXEC(d2_setblendmode(d2_handle, d2_bm_zero, d2_bm_one));
-        D2_EXEC(d2_setalphablendmode(d2_handle, d2_bm_zero, d2_bm_alpha));
+        D2_EXEC(lv_port_gpu_set_blendmode(d2_bm_zero, d2_bm_one));
+        D2_EXEC(lv_port_gpu_set_alphablendmode(d2_bm_zero, d2_bm_alpha));
 
         lv_port_gpu_blit_internal(disp_drv, &buf_area, (const lv_color_t *)msk, &buf_area, flags);
 
@@ -586,16 +701,16 @@ void lv_port_gpu_blit_with_mask(lv_disp_drv_t *disp_drv, lv_color_t *dst, const
         flags = d2_bf_usealpha;
         src_cf_val = d2_mode_argb8888;
 
-        D2_EXEC(d2_framebuffer(d2_handle, d1_maptovidmem(d1_handle, dst), MAX(dst_pitch, 2),
+        D2_EXEC(lv_port_gpu_set_framebuffer(disp_drv, dst, MAX(dst_pitch, 2),
                 MAX(dst_area->x2 + 1, 2), MAX(dst_area->y2 + 1, 2), dst_cf_val));
 
         if (blend_enabled) {
-                D2_EXEC(d2_setblendmode(d2_handle, d2_bm_alpha,
+                D2_EXEC(lv_port_gpu_set_blendmode(d2_bm_alpha,
                         img_dsc.blend_mode != LV_BLEND_MODE_NORMAL ? d2_bm_one : d2_bm_one_minus_alpha));
-                D2_EXEC(d2_setalphablendmode(d2_handle, d2_bm_one, d2_bm_one_minus_alpha));
+                D2_EXEC(lv_port_gpu_set_alphablendmode(d2_bm_one, d2_bm_one_minus_alpha));
         } else {
-                D2_EXEC(d2_setblendmode(d2_handle, d2_bm_one, d2_bm_zero));
-                D2_EXEC(d2_setalphablendmode(d2_handle, d2_bm_one, d2_bm_zero));
+                D2_EXEC(lv_port_gpu_set_blendmode(d2_bm_one, d2_bm_zero));
+                D2_EXEC(lv_port_gpu_set_alphablendmode(d2_bm_one, d2_bm_zero));
         }
         lv_port_gpu_blit_internal(disp_drv, dst_area, (const lv_color_t *)work_buf, dst_area, flags);
 
@@ -605,6 +720,10 @@ void lv_port_gpu_blit_with_mask(lv_disp_drv_t *disp_drv, lv_color_t *dst, const
         img_dsc.zoom = zoom;
 
         lv_port_gpu_execute_render();
+#if LV_PORT_GPU_PIPELINE
+        lv_port_gpu_pending_add(dst, dst_area, work_buf);
+#endif
+        lv_port_gpu_submit_render();
 }
 
 bool lv_port_gpu_config_blit(lv_disp_drv_t *disp_drv, const lv_draw_img_dsc_t *draw_dsc,  lv_img_cf_t dst_cf,
@@ -631,6 +750,9 @@ bool lv_port_gpu_config_blit(lv_disp_drv_t *disp_drv, const lv_draw_img_dsc_t *d
         }
         src_cf_val = d2_src_cf;
         dst_cf_val = d2_dst_cf;
+#if LV_PORT_DISP_GPU_SUB_BYTE_SWAP && (DLG_LVGL_CF == 1)
+        src_native_order = !!(src_cf & LV_IMG_CF_NATIVE_ORDER_FLAG);
+#endif
 
         img_dsc = *draw_dsc;
 
@@ -654,16 +776,23 @@ static void lv_port_gpu_config_blit_clear(void)
 
         src_cf_val = lv_port_gpu_cf_get_default();
         dst_cf_val = lv_port_gpu_cf_get_default();
+#if LV_PORT_DISP_GPU_SUB_BYTE_SWAP
+        src_native_order = false;
+#endif
 }
 
 void lv_port_gpu_render_box(lv_disp_drv_t *disp_drv,  lv_color_t *dst, lv_coord_t dst_pitch,
         lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h, lv_color_t color)
 {
+#if LV_PORT_GPU_PIPELINE
+        lv_area_t box_area = { x, y, x + w - 1, y + h - 1 };
+#endif
+
         lv_port_gpu_start_render();
 
-        D2_EXEC(d2_framebuffer(d2_handle, d1_maptovidmem(d1_handle, dst), MAX(dst_pitch, 2),
+        D2_EXEC(lv_port_gpu_set_framebuffer(disp_drv, dst, MAX(dst_pitch, 2),
                 MAX(x + w, 2), MAX(y + h, 2), lv_port_gpu_cf_get_default()));
-        D2_EXEC(d2_cliprect(d2_handle, 0, 0, x + w - 1, y + h - 1));
+        D2_EXEC(lv_port_gpu_set_cliprect(0, 0, x + w - 1, y + h - 1));
 
         D2_EXEC(d2_setcolor(d2_handle, 0, lv_port_gpu_color_lv_to_d2(color)));
 
@@ -678,6 +807,220 @@ void lv_port_gpu_render_box(lv_disp_drv_t *disp_drv,  lv_color_t *dst, lv_coord_
         D2_EXEC(d2_renderline(d2_handle, x,     y + h, x + w, y + h, D2_FIX4(1), 0));
 
         lv_port_gpu_execute_render();
+#if LV_PORT_GPU_PIPELINE
+        lv_port_gpu_pending_add(dst, &box_area, NULL);
+#endif
+}
+
+bool lv_port_gpu_draw_rect(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area, lv_coord_t dst_pitch,
+        const lv_area_t *outer_area, lv_coord_t rout, const lv_area_t *inner_area, lv_coord_t rin,
+        lv_color_t color, lv_color_t grad_color, lv_grad_dir_t grad_dir, uint8_t main_stop, uint8_t grad_stop,
+        lv_opa_t opa, lv_blend_mode_t blend_mode)
+{
+        d2_point gx = 0, gy = 0, gdx = 0, gdy = 0;
+
+        if (blend_mode != LV_BLEND_MODE_NORMAL && blend_mode != LV_BLEND_MODE_ADDITIVE) {
+                return false;
+        }
+
+        /* The gradient is a second pass of grad_color with an alpha gradient, which is exact only over an opaque
+         * first pass */
+        if (grad_dir != LV_GRAD_DIR_NONE) {
+                lv_coord_t s = grad_dir == LV_GRAD_DIR_HOR ? lv_area_get_width(outer_area) :
+                                                             lv_area_get_height(outer_area);
+                d2_point start = D2_FIX4((main_stop * s) >> 8);
+                d2_point len = D2_FIX4(((grad_stop - main_stop) * s) >> 8);
+
+                if (opa < LV_OPA_MAX || blend_mode != LV_BLEND_MODE_NORMAL || len <= 0) {
+                        return false;
+                }
+                if (grad_dir == LV_GRAD_DIR_HOR) {
+                        gx = D2_FIX4(outer_area->x1) + start;
+                        gy = D2_FIX4(outer_area->y1);
+                        gdx = len;
+                } else {
+                        gx = D2_FIX4(outer_area->x1);
+                        gy = D2_FIX4(outer_area->y1) + start;
+                        gdy = len;
+                }
+        }
+
+        /* Frames are drawn with rings around the same center as the outer corners, like draw_border_generic() */
+        if (inner_area && rout > 0 && (rin <= 0 ||
+                inner_area->x1 - outer_area->x1 != rout - rin || outer_area->x2 - inner_area->x2 != rout - rin ||
+                inner_area->y1 - outer_area->y1 != rout - rin || outer_area->y2 - inner_area->y2 != rout - rin)) {
+                return false;
+        }
+
+        lv_port_gpu_start_shape(disp_drv, dst, dst_area, dst_pitch, color, opa, blend_mode);
+        lv_port_gpu_render_rect_shape(dst_area, outer_area, rout, inner_area, rin);
+
+        if (grad_dir != LV_GRAD_DIR_NONE) {
+                /* Alpha goes from 0 at the main stop to 255 at the gradient stop and is clamped outside */
+                D2_EXEC(d2_setalphagradient(d2_handle, 0, gx, gy, gdx, gdy));
+                D2_EXEC(d2_setalphamode(d2_handle, d2_am_gradient1));
+                D2_EXEC(d2_setcolor(d2_handle, 0, lv_port_gpu_color_lv_to_d2(grad_color)));
+                lv_port_gpu_render_rect_shape(dst_area, outer_area, rout, inner_area, rin);
+                D2_EXEC(d2_setalphamode(d2_handle, d2_am_constant));
+        }
+
+        lv_port_gpu_end_shape(dst, dst_area);
+
+        return true;
+}
+
+bool lv_port_gpu_draw_arc(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area, lv_coord_t dst_pitch,
+        const lv_point_t *center, uint16_t radius, uint16_t start_angle, uint16_t end_angle, lv_coord_t width,
+        bool rounded, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
+{
+        lv_port_gpu_arc_shape arc;
+
+        if (blend_mode != LV_BLEND_MODE_NORMAL && blend_mode != LV_BLEND_MODE_ADDITIVE) {
+                return false;
+        }
+
+        lv_port_gpu_arc_shape_get(&arc, center, radius, start_angle, end_angle, width);
+
+        lv_port_gpu_start_shape(disp_drv, dst, dst_area, dst_pitch, color, opa, blend_mode);
+
+        if (arc.ring) {
+                D2_EXEC(d2_rendercircle(d2_handle, arc.cx, arc.cy, arc.r, arc.w));
+        } else {
+                D2_EXEC(d2_renderwedge(d2_handle, arc.cx, arc.cy, arc.r, arc.w, arc.nx1, arc.ny1, arc.nx2, arc.ny2,
+                        arc.concave ? d2_wf_concave : 0));
+
+                if (rounded) {
+                        D2_EXEC(d2_rendercircle(d2_handle, arc.cap_x[0], arc.cap_y[0], arc.w / 2, 0));
+                        D2_EXEC(d2_rendercircle(d2_handle, arc.cap_x[1], arc.cap_y[1], arc.w / 2, 0));
+                }
+        }
+
+        lv_port_gpu_end_shape(dst, dst_area);
+
+        return true;
+}
+
+bool lv_port_gpu_draw_line(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area, lv_coord_t dst_pitch,
+        const lv_point_t *point1, const lv_point_t *point2, lv_coord_t width, lv_color_t color, lv_opa_t opa,
+        lv_blend_mode_t blend_mode)
+{
+        lv_port_gpu_line_shape line;
+
+        if (blend_mode != LV_BLEND_MODE_NORMAL && blend_mode != LV_BLEND_MODE_ADDITIVE) {
+                return false;
+        }
+
+        lv_port_gpu_line_shape_get(&line, point1, point2, width);
+
+        lv_port_gpu_start_shape(disp_drv, dst, dst_area, dst_pitch, color, opa, blend_mode);
+
+        D2_EXEC(d2_renderline(d2_handle, line.x1, line.y1, line.x2, line.y2, line.w, 0));
+
+        lv_port_gpu_end_shape(dst, dst_area);
+
+        return true;
+}
+
+bool lv_port_gpu_draw_polygon(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area,
+        lv_coord_t dst_pitch, const lv_point_t *points, uint16_t point_cnt, lv_color_t color, lv_opa_t opa,
+        lv_blend_mode_t blend_mode)
+{
+        int convexity;
+        lv_point_t max;
+        int32_t x[3], y[3];
+
+        if (blend_mode != LV_BLEND_MODE_NORMAL && blend_mode != LV_BLEND_MODE_ADDITIVE) {
+                return false;
+        }
+
+        /* Only convex polygons can be split into a triangle fan, like the CPU path assumes */
+        convexity = lv_port_gpu_polygon_convexity(points, point_cnt);
+        if (convexity < 0) {
+                return false;
+        }
+        if (convexity == 0) {
+                return true;
+        }
+
+        lv_port_gpu_start_shape(disp_drv, dst, dst_area, dst_pitch, color, opa, blend_mode);
+
+        /* Edges shared by two triangles of the fan are not anti-aliased to avoid seams */
+        lv_port_gpu_polygon_max_get(points, point_cnt, &max);
+        lv_port_gpu_polygon_point_get(points, point_cnt, 0, &max, &x[0], &y[0]);
+        lv_port_gpu_polygon_point_get(points, point_cnt, 1, &max, &x[2], &y[2]);
+        for (uint16_t i = 1; i + 1 < point_cnt; i++) {
+                d2_u32 flags = (i > 1 ? d2_edge0_shared : 0) | (i + 2 < point_cnt ? d2_edge2_shared : 0);
+
+                x[1] = x[2];
+                y[1] = y[2];
+                lv_port_gpu_polygon_point_get(points, point_cnt, i + 1, &max, &x[2], &y[2]);
+                D2_EXEC(d2_rendertri(d2_handle, x[0], y[0], x[1], y[1], x[2], y[2], flags));
+        }
+
+        lv_port_gpu_end_shape(dst, dst_area);
+
+        return true;
+}
+
+void lv_port_gpu_draw_shadow(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area,
+        lv_coord_t dst_pitch, const lv_area_t *shadow_area, const lv_area_t *bg_area, lv_coord_t r_bg,
+        const lv_opa_t *corner, lv_coord_t corner_size, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
+{
+        lv_coord_t x1 = shadow_area->x1, y1 = shadow_area->y1, x2 = shadow_area->x2, y2 = shadow_area->y2;
+        lv_coord_t cs = corner_size;
+        lv_coord_t w_half = x1 + lv_area_get_width(shadow_area) / 2;
+        lv_coord_t h_half = y1 + lv_area_get_height(shadow_area) / 2;
+        lv_coord_t side_y1 = MIN(y1 + cs, h_half + 1);
+        lv_coord_t side_y2 = MAX(y2 - cs, h_half);
+        lv_area_t slice, draw_area;
+
+        lv_port_gpu_start_shape(disp_drv, dst, dst_area, dst_pitch, color, opa, blend_mode);
+
+        /* The corner is the top right one in A8, colorized with the shadow color */
+        D2_EXEC(d2_setcolor(d2_handle, 1, lv_port_gpu_color_lv_to_d2(color)));
+        D2_EXEC(d2_setblitsrc(d2_handle, d1_maptovidmem(d1_handle, (void *)corner), cs, cs, cs, d2_mode_alpha8));
+
+        /* The slices are clipped like in draw_shadow() so that no pixel is blended twice */
+        lv_area_set(&slice, MAX(x2 - cs + 1, w_half), y1, x2, MIN(y1 + cs - 1, h_half));
+        lv_port_gpu_render_shadow_slice(dst_area, &slice, bg_area, r_bg, 0, 0, cs, cs, x2 - cs + 1, y1, cs, cs, 0);
+        lv_area_set(&slice, MAX(x2 - cs + 1, w_half), MAX(y2 - cs + 1, h_half + 1), x2, y2);
+        lv_port_gpu_render_shadow_slice(dst_area, &slice, bg_area, r_bg, 0, 0, cs, cs, x2 - cs + 1, y2 - cs + 1,
+                cs, cs, d2_bf_mirrorv);
+        lv_area_set(&slice, x1, y1, MIN(x1 + cs - 1, w_half - 1), MIN(y1 + cs - 1, h_half));
+        lv_port_gpu_render_shadow_slice(dst_area, &slice, bg_area, r_bg, 0, 0, cs, cs, x1, y1, cs, cs,
+                d2_bf_mirroru);
+        lv_area_set(&slice, x1, MAX(y2 - cs + 1, h_half + 1), MIN(x1 + cs - 1, w_half - 1), y2);
+        lv_port_gpu_render_shadow_slice(dst_area, &slice, bg_area, r_bg, 0, 0, cs, cs, x1, y2 - cs + 1, cs, cs,
+                d2_bf_mirroru | d2_bf_mirrorv);
+
+        /* The sides stretch the innermost column or row of the corner */
+        lv_area_set(&slice, x1 + cs, y1, x2 - cs, MIN(y1 + cs - 1, h_half));
+        lv_port_gpu_render_shadow_slice(dst_area, &slice, bg_area, r_bg, 0, 0, 1, cs, x1 + cs, y1,
+                lv_area_get_width(&slice), cs, 0);
+        lv_area_set(&slice, x1 + cs, MAX(y2 - cs + 1, h_half + 1), x2 - cs, y2);
+        lv_port_gpu_render_shadow_slice(dst_area, &slice, bg_area, r_bg, 0, 0, 1, cs, x1 + cs, y2 - cs + 1,
+                lv_area_get_width(&slice), cs, d2_bf_mirrorv);
+        lv_area_set(&slice, MAX(x2 - cs + 1, w_half), side_y1, x2, side_y2);
+        lv_port_gpu_render_shadow_slice(dst_area, &slice, bg_area, r_bg, 0, cs - 1, cs, 1, x2 - cs + 1, side_y1,
+                cs, lv_area_get_height(&slice), 0);
+        lv_area_set(&slice, x1, side_y1, MIN(x1 + cs - 1, w_half - 1), side_y2);
+        lv_port_gpu_render_shadow_slice(dst_area, &slice, bg_area, r_bg, 0, cs - 1, cs, 1, x1, side_y1,
+                cs, lv_area_get_height(&slice), d2_bf_mirroru);
+
+        /* The center is usually covered by the background */
+        lv_area_set(&slice, x1 + cs, y1 + cs, x2 - cs, y2 - cs);
+        if (_lv_area_intersect(&draw_area, &slice, dst_area) && !_lv_area_is_in(&draw_area, bg_area, r_bg)) {
+                D2_EXEC(lv_port_gpu_set_cliprect(draw_area.x1, draw_area.y1, draw_area.x2, draw_area.y2));
+                lv_port_gpu_render_rect_box(draw_area.x1, draw_area.y1, draw_area.x2, draw_area.y2);
+        }
+
+#ifdef PERFORMANCE_METRICS
+        metrics_tag = metrics_tag_override ? metrics_tag_override : GPU_METRICS_BLITBITMAP;
+#endif
+        lv_port_gpu_execute_render();
+#if LV_PORT_GPU_PIPELINE
+        lv_port_gpu_pending_add(dst, dst_area, corner);
+#endif
 }
 
 #if LV_PORT_DISP_GPU_SUB_BYTE_SWAP
@@ -721,12 +1064,12 @@ static const lv_color_t *lv_port_gpu_fix_order(const lv_color_t *src, const lv_a
 
         lv_port_gpu_start_render();
 
-        D2_EXEC(d2_framebuffer(d2_handle, d1_maptovidmem(d1_handle, (void *)buf), MAX(w, 2), MAX(w, 2), MAX(h, 2), d2_mode_alpha8));
-        D2_EXEC(d2_cliprect(d2_handle, 0, 0, w - 1, h - 1));
+        D2_EXEC(lv_port_gpu_set_framebuffer(NULL, (void *)buf, MAX(w, 2), MAX(w, 2), MAX(h, 2), d2_mode_alpha8));
+        D2_EXEC(lv_port_gpu_set_cliprect(0, 0, w - 1, h - 1));
 
         D2_EXEC(d2_settexclut(d2_handle, (d2_color *)clut));
 
-        D2_EXEC(d2_setalphablendmode(d2_handle, d2_bm_one, d2_bm_zero));
+        D2_EXEC(lv_port_gpu_set_alphablendmode(d2_bm_one, d2_bm_zero));
 
         D2_EXEC(d2_setblitsrc(d2_handle, d1_maptovidmem(d1_handle, (void *)src), w, w, h, d2_mode_i8 | d2_mode_clut));
         D2_EXEC(d2_blitcopy(d2_handle, w, h, 0, 0, D2_FIX4(w), D2_FIX4(h), D2_FIX4(0), D2_FIX4(0), d2_bf_usealpha));
@@ -750,8 +1093,129 @@ void lv_port_gpu_wait(lv_disp_drv_t * disp_drv)
 #endif
 }
 
+#ifdef PERFORMANCE_METRICS
+void lv_port_gpu_set_metrics_tag(uint8_t tag)
+{
+        metrics_tag_override = tag;
+}
+#endif
+
+void lv_port_gpu_set_slice(bool filter, uint8_t bpp, uint16_t angle, uint8_t width, bool horizontal)
+{
+        slice_entry *entry = lv_port_gpu_slice_get(filter, bpp, angle);
+
+        entry->width = width;
+        entry->horizontal = horizontal;
+}
+
+#if LV_PORT_GPU_SLICE_CALIBRATION
+void lv_port_gpu_slice_calibrate(lv_disp_drv_t *disp_drv, lv_color_t *dst, lv_coord_t dst_w, lv_coord_t dst_h,
+        const lv_img_dsc_t *img)
+{
+        static const uint8_t widths[] = { 0, 4, 6, 8, 12, 16, 24, 32 };
+        lv_area_t dst_area = { 0, 0, dst_w - 1, dst_h - 1 };
+        lv_area_t src_area;
+        lv_draw_img_dsc_t dsc;
+        int bpp = lv_port_gpu_cf_bpp(lv_port_gpu_cf_lv_to_d2(img->header.cf));
+
+        /* Rotate around the center of the scratch buffer */
+        src_area.x1 = (dst_w - img->header.w) / 2;
+        src_area.y1 = (dst_h - img->header.h) / 2;
+        src_area.x2 = src_area.x1 + img->header.w - 1;
+        src_area.y2 = src_area.y1 + img->header.h - 1;
+
+        lv_draw_img_dsc_init(&dsc);
+        dsc.pivot.x = img->header.w / 2;
+        dsc.pivot.y = img->header.h / 2;
+
+        lv_port_gpu_wait(disp_drv);
+        lv_port_gpu_start_render();
+        if (d2_handle == NULL) {
+                return;
+        }
+        /* Counter 0 is used by the performance metrics */
+        D2_EXEC(d2_setperfcountevent(d2_handle, 1, d2_pc_davecycles));
+
+        for (int filter = 0; filter < 2; filter++) {
+                dsc.antialias = filter;
+
+                for (int step = 0; step < LV_PORT_GPU_SLICE_ANGLE_STEPS; step++) {
+                        slice_entry *entry;
+                        d2_u32 best = UINT32_MAX;
+
+                        /* Middle of the angle range */
+                        dsc.angle = ((2 * step + 1) * 900) / (2 * LV_PORT_GPU_SLICE_ANGLE_STEPS);
+                        entry = lv_port_gpu_slice_get(filter, bpp, dsc.angle);
+
+                        for (int i = 0; i < ARRAY_LENGTH(widths); i++) {
+                                for (int horizontal = 0; horizontal < (widths[i] ? 2 : 1); horizontal++) {
+                                        slice_entry candidate = { widths[i], horizontal };
+                                        d2_u32 cycles;
+
+                                        if (!lv_port_gpu_config_blit(disp_drv, &dsc, LV_IMG_CF_TRUE_COLOR, img->header.cf,
+                                                true, false, true, false)) {
+                                                lv_port_gpu_config_blit_clear();
+                                                return;
+                                        }
+
+                                        slice_override = &candidate;
+                                        D2_EXEC(d2_setperfcountvalue(d2_handle, 1, 0));
+                                        lv_port_gpu_blit(disp_drv, dst, &dst_area, dst_w, (const lv_color_t *)img->data,
+                                                &src_area, LV_OPA_COVER);
+                                        lv_port_gpu_wait(disp_drv);
+                                        slice_override = NULL;
+
+                                        cycles = (d2_u32)d2_getperfcountvalue(d2_handle, 1);
+                                        if (cycles < best) {
+                                                best = cycles;
+                                                *entry = candidate;
+                                        }
+                                }
+                        }
+
+                        printf("GPU slice: filter %d, bpp %d, angle %d: width %d, %s\r\n", filter, bpp, dsc.angle,
+                                entry->width, entry->horizontal ? "horizontal" : "vertical");
+                }
+        }
+
+        lv_port_gpu_config_blit_clear();
+}
+#endif /* LV_PORT_GPU_SLICE_CALIBRATION */
+
+void lv_port_gpu_wait_area(lv_disp_drv_t * disp_drv, const lv_color_t *dst, const lv_area_t *area)
+{
+#if LV_PORT_GPU_PIPELINE
+        bool overlap = pending_sync;
+
+#if LV_PORT_DISP_GPU_SUB_BYTE_SWAP
+        overlap |= buf != NULL;
+#endif
+        for (int i = 0; i < pending_area_count && !overlap; i++) {
+                overlap = pending_area_list[i].dst == dst && _lv_area_is_on(&pending_area_list[i].area, area);
+        }
+
+        if (!overlap) {
+                return;
+        }
+#endif
+        lv_port_gpu_wait(disp_drv);
+}
+
 void lv_port_gpu_flush(void)
 {
+#if !LV_PORT_GPU_PERSISTENT_SESSION
+        lv_port_gpu_hw_deinit();
+#endif
+}
+
+void lv_port_gpu_release(void)
+{
+        if (d2_handle == NULL)
+                return;
+
+        /* Make sure that nothing is rendered in the frame buffer while closing the device */
+        lv_port_gpu_complete_render();
+
         lv_port_gpu_hw_deinit();
 }
 
@@ -770,6 +1234,7 @@ static int lv_port_gpu_hw_init(void)
         if (d2_setdlistblocksize(d2_handle, 25) != D2_OK) {
                 printf("Could NOT d2_setdlistblocksize\n");
                 d2_closedevice(d2_handle);
+                d2_handle = NULL;
 
                 return 0;
         }
@@ -778,6 +1243,7 @@ static int lv_port_gpu_hw_init(void)
         if (d2_inithw(d2_handle, 0) != D2_OK) {
                 printf("Could NOT d2_inithw\n");
                 d2_closedevice(d2_handle);
+                d2_handle = NULL;
 
                 return 0;
         }
@@ -786,17 +1252,32 @@ static int lv_port_gpu_hw_init(void)
         if (!d1_handle) {
                 printf("NO d1_handle\n");
                 d2_closedevice(d2_handle);
+                d2_handle = NULL;
 
                 return 0;
         }
 
-        renderbuffer = d2_newrenderbuffer(d2_handle, 20, 20);
-        if (!renderbuffer) {
-                printf("NO renderbuffer\n");
-                d2_closedevice(d2_handle);
-
-                return 0;
+        for (int i = 0; i < LV_PORT_GPU_RENDERBUFFER_NUM; i++) {
+                renderbuffer_pool[i] = d2_newrenderbuffer(d2_handle, 20, 20);
+                if (!renderbuffer_pool[i]) {
+                        printf("NO renderbuffer\n");
+                        while (i--) {
+                                d2_freerenderbuffer(d2_handle, renderbuffer_pool[i]);
+                                renderbuffer_pool[i] = NULL;
+                        }
+                        d2_closedevice(d2_handle);
+                        d2_handle = NULL;
+
+                        return 0;
+                }
         }
+        renderbuffer = renderbuffer_pool[0];
+        renderbuffer_open = false;
+        renderbuffer_op_count = 0;
+        gpu_state.valid = 0;
+#if LV_PORT_GPU_PIPELINE
+        renderbuffer_index = 0;
+#endif
 
 #ifdef PERFORMANCE_METRICS
         d2_setperfcountevent(d2_handle, 0, d2_pc_davecycles);
@@ -810,11 +1291,17 @@ static void lv_port_gpu_hw_deinit(void)
         if (d2_handle == NULL)
                 return;
 
-        D2_EXEC(d2_freerenderbuffer(d2_handle, renderbuffer));
+        for (int i = 0; i < LV_PORT_GPU_RENDERBUFFER_NUM; i++) {
+                D2_EXEC(d2_freerenderbuffer(d2_handle, renderbuffer_pool[i]));
+                renderbuffer_pool[i] = NULL;
+        }
 
         D2_EXEC(d2_closedevice(d2_handle));
 
         renderbuffer = NULL;
+        renderbuffer_open = false;
+        renderbuffer_op_count = 0;
+        gpu_state.valid = 0;
         d2_handle = NULL;
         d1_handle = NULL;
 }
@@ -914,7 +1401,7 @@ static d2_s32 lv_port_gpu_cf_lv_to_d2(lv_img_cf_t cf)
         d2_s32 d2_cf;
 
 #if (DLG_LVGL_CF == 1)
-        switch (cf & ~LV_IMG_CF_RLE_FLAG) {
+        switch (cf & ~LV_IMG_CF_FLAGS) {
 #else
         switch (cf) {
 #endif /* (DLG_LVGL_CF == 1) */
@@ -976,19 +1463,45 @@ static void lv_port_gpu_start_render(void)
         if (d2_enabled) {
                 lv_port_gpu_hw_init();
 
-                D2_EXEC(d2_selectrenderbuffer(d2_handle, renderbuffer));
+                /* Keep adding operations to the render buffer which is not submitted yet */
+                if (d2_handle && !renderbuffer_open) {
+                        D2_EXEC(d2_selectrenderbuffer(d2_handle, renderbuffer));
+                        renderbuffer_open = true;
+                }
         }
 }
 
 static void lv_port_gpu_execute_render(void)
 {
         if (d2_handle) {
+                renderbuffer_op_count++;
+                if (renderbuffer_op_count >= LV_PORT_GPU_BATCH_SIZE) {
+                        lv_port_gpu_submit_render();
+                }
+        }
+}
+
+static void lv_port_gpu_submit_render(void)
+{
+        if (d2_handle && renderbuffer_open) {
                 D2_EXEC(d2_executerenderbuffer(d2_handle, renderbuffer, 0));
+                renderbuffer_open = false;
+                renderbuffer_op_count = 0;
+#if LV_PORT_GPU_PIPELINE
+                /* Build the next display list while the GPU is busy with this one */
+                renderbuffer_index = (renderbuffer_index + 1) % LV_PORT_GPU_RENDERBUFFER_NUM;
+                renderbuffer = renderbuffer_pool[renderbuffer_index];
+#endif
+#ifdef PERFORMANCE_METRICS
+                gdi_perf_render_submit();
+#endif
         }
 }
 
 static void lv_port_gpu_complete_render(void)
 {
+        lv_port_gpu_submit_render();
+
         if (d2_handle) {
                 D2_EXEC(d2_flushframe(d2_handle));
 
@@ -1003,7 +1516,278 @@ static void lv_port_gpu_complete_render(void)
                 gdi_perf_render_op_time(render_op_duration_us, metrics_tag);
 #endif
         }
+
+#if LV_PORT_GPU_PIPELINE
+        pending_area_count = 0;
+        pending_sync = false;
+#endif
+}
+
+static slice_entry *lv_port_gpu_slice_get(bool filter, int bpp, int16_t angle)
+{
+        int format = bpp <= 8 ? 0 : (bpp <= 16 ? 1 : 2);
+        int folded = angle % 1800;
+
+#if LV_PORT_GPU_SLICE_CALIBRATION
+        if (slice_override) {
+                return (slice_entry *)slice_override;
+        }
+#endif
+        /* The texture is walked the same way for angle, 180 - angle and 180 + angle */
+        if (folded < 0) {
+                folded += 1800;
+        }
+        if (folded > 900) {
+                folded = 1800 - folded;
+        }
+
+        return &slice_table[filter][format][folded * LV_PORT_GPU_SLICE_ANGLE_STEPS / 901];
+}
+
+static void lv_port_gpu_render_quad_clipped(const d2_point *quad, d2_border x1, d2_border y1, d2_border x2, d2_border y2)
+{
+        D2_EXEC(lv_port_gpu_set_cliprect(x1, y1, x2, y2));
+        D2_EXEC(d2_renderquad(d2_handle, quad[0], quad[1], quad[2], quad[3], quad[4], quad[5], quad[6], quad[7], 0));
+}
+
+/* Prepare the GPU to draw a shape of a single color in the dst_area part of dst */
+static void lv_port_gpu_start_shape(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area,
+        lv_coord_t dst_pitch, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
+{
+        lv_port_gpu_start_render();
+
+        D2_EXEC(lv_port_gpu_set_framebuffer(disp_drv, dst, MAX(dst_pitch, 2),
+                MAX(dst_area->x2 + 1, 2), MAX(dst_area->y2 + 1, 2), lv_port_gpu_cf_get_default()));
+        D2_EXEC(lv_port_gpu_set_cliprect(dst_area->x1, dst_area->y1, dst_area->x2, dst_area->y2));
+
+        D2_EXEC(lv_port_gpu_set_blendmode(d2_bm_alpha,
+                blend_mode != LV_BLEND_MODE_NORMAL ? d2_bm_one : d2_bm_one_minus_alpha));
+        D2_EXEC(lv_port_gpu_set_alphablendmode(d2_bm_one, d2_bm_one_minus_alpha));
+        D2_EXEC(lv_port_gpu_set_alpha(opa > LV_OPA_MAX ? LV_OPA_COVER : opa));
+
+        D2_EXEC(d2_setcolor(d2_handle, 0, lv_port_gpu_color_lv_to_d2(color)));
+}
+
+static void lv_port_gpu_end_shape(lv_color_t *dst, const lv_area_t *dst_area)
+{
+#ifdef PERFORMANCE_METRICS
+        metrics_tag = metrics_tag_override ? metrics_tag_override : GPU_METRICS_FILL;
+#endif
+        lv_port_gpu_execute_render();
+#if LV_PORT_GPU_PIPELINE
+        lv_port_gpu_pending_add(dst, dst_area, NULL);
+#endif
+}
+
+/* Render a rectangle with rounded corners, or only the frame around inner, as boxes for the straight parts and
+ * circles clipped to the corners so that no pixel is blended twice */
+static void lv_port_gpu_render_rect_shape(const lv_area_t *clip, const lv_area_t *outer, lv_coord_t rout,
+        const lv_area_t *inner, lv_coord_t rin)
+{
+        lv_coord_t x1 = outer->x1, y1 = outer->y1, x2 = outer->x2, y2 = outer->y2;
+        lv_area_t corner;
+
+        D2_EXEC(lv_port_gpu_set_cliprect(clip->x1, clip->y1, clip->x2, clip->y2));
+
+        if (inner == NULL) {
+                lv_port_gpu_render_rect_box(x1, y1 + rout, x2, y2 - rout);
+                lv_port_gpu_render_rect_box(x1 + rout, y1, x2 - rout, y1 + rout - 1);
+                lv_port_gpu_render_rect_box(x1 + rout, y2 - rout + 1, x2 - rout, y2);
+        } else {
+                lv_port_gpu_render_rect_box(x1 + rout, y1, x2 - rout, inner->y1 - 1);
+                lv_port_gpu_render_rect_box(x1 + rout, inner->y2 + 1, x2 - rout, y2);
+                lv_port_gpu_render_rect_box(x1, MAX(y1 + rout, inner->y1), inner->x1 - 1, MIN(y2 - rout, inner->y2));
+                lv_port_gpu_render_rect_box(inner->x2 + 1, MAX(y1 + rout, inner->y1), x2, MIN(y2 - rout, inner->y2));
+        }
+
+        if (rout <= 0) {
+                return;
+        }
+
+        /* The circles are centered on the edges of the straight parts */
+        lv_area_set(&corner, x1, y1, x1 + rout - 1, y1 + rout - 1);
+        lv_port_gpu_render_rect_corner(clip, &corner, D2_FIX4(x1 + rout), D2_FIX4(y1 + rout), rout, rin);
+        lv_area_set(&corner, x2 - rout + 1, y1, x2, y1 + rout - 1);
+        lv_port_gpu_render_rect_corner(clip, &corner, D2_FIX4(x2 + 1 - rout), D2_FIX4(y1 + rout), rout, rin);
+        lv_area_set(&corner, x1, y2 - rout + 1, x1 + rout - 1, y2);
+        lv_port_gpu_render_rect_corner(clip, &corner, D2_FIX4(x1 + rout), D2_FIX4(y2 + 1 - rout), rout, rin);
+        lv_area_set(&corner, x2 - rout + 1, y2 - rout + 1, x2, y2);
+        lv_port_gpu_render_rect_corner(clip, &corner, D2_FIX4(x2 + 1 - rout), D2_FIX4(y2 + 1 - rout), rout, rin);
+
+        D2_EXEC(lv_port_gpu_set_cliprect(clip->x1, clip->y1, clip->x2, clip->y2));
+}
+
+static void lv_port_gpu_render_rect_box(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2)
+{
+        if (x2 < x1 || y2 < y1) {
+                return;
+        }
+
+        D2_EXEC(d2_renderbox(d2_handle, D2_FIX4(x1), D2_FIX4(y1), D2_FIX4(x2 - x1 + 1), D2_FIX4(y2 - y1 + 1)));
+}
+
+static void lv_port_gpu_render_rect_corner(const lv_area_t *clip, const lv_area_t *corner, d2_point cx, d2_point cy,
+        lv_coord_t rout, lv_coord_t rin)
+{
+        lv_area_t draw_area;
+
+        if (!_lv_area_intersect(&draw_area, corner, clip)) {
+                return;
+        }
+
+        D2_EXEC(lv_port_gpu_set_cliprect(draw_area.x1, draw_area.y1, draw_area.x2, draw_area.y2));
+
+        /* A circle outline of width w covers the radii r - w / 2 to r + w / 2 */
+        if (rin > 0) {
+                D2_EXEC(d2_rendercircle(d2_handle, cx, cy, D2_FIX4(rout + rin) / 2, D2_FIX4(rout - rin)));
+        } else {
+                D2_EXEC(d2_rendercircle(d2_handle, cx, cy, D2_FIX4(rout), 0));
+        }
+}
+
+/* Blit the part of the corner texture at src_x, src_y, scaled to w x h at x, y, which lies in slice and clip.
+ * Parts of the shadow behind the background are skipped */
+static void lv_port_gpu_render_shadow_slice(const lv_area_t *clip, const lv_area_t *slice, const lv_area_t *bg_area,
+        lv_coord_t r_bg, lv_coord_t src_x, lv_coord_t src_y, lv_coord_t src_w, lv_coord_t src_h,
+        lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h, d2_u32 flags)
+{
+        lv_area_t draw_area;
+
+        if (!_lv_area_intersect(&draw_area, slice, clip) || _lv_area_is_in(&draw_area, bg_area, r_bg)) {
+                return;
+        }
+
+        D2_EXEC(lv_port_gpu_set_cliprect(draw_area.x1, draw_area.y1, draw_area.x2, draw_area.y2));
+        D2_EXEC(d2_blitcopy(d2_handle, src_w, src_h, src_x, src_y, D2_FIX4(w), D2_FIX4(h), D2_FIX4(x), D2_FIX4(y),
+                d2_bf_usealpha | d2_bf_colorize2 | flags));
+}
+
+static bool lv_port_gpu_src_is_transient(const void *src)
+{
+#if LV_PORT_GLYPH_ATLAS_EN
+        /* Atlas pages are only rewritten after waiting for the GPU */
+        if (lv_port_glyph_atlas_is_page(src)) {
+                return false;
+        }
+#endif
+#if LV_PORT_SHADOW_CACHE_EN
+        /* Cached shadow corners are only freed after waiting for the GPU */
+        if (lv_port_shadow_cache_is_corner(src)) {
+                return false;
+        }
+#endif
+#if LV_PORT_SNAPSHOT_EN
+        /* Snapshots are only rewritten after waiting for the GPU */
+        if (lv_port_snapshot_is_buf(src)) {
+                return false;
+        }
+#endif
+        /* Sources in system RAM can be temporary LVGL buffers which are reused as soon as we return */
+        return src != NULL && (uint32_t)src >= MEMORY_SYSRAM_BASE && (uint32_t)src < MEMORY_SYSRAM_END;
+}
+
+static d2_s32 lv_port_gpu_set_framebuffer(lv_disp_drv_t *disp_drv, void *dst, d2_s32 pitch, d2_u32 width,
+        d2_u32 height, d2_s32 format)
+{
+        /* Use the whole draw buffer so that all operations of a refresh area share the same state */
+        if (disp_drv && disp_drv->draw_buf && dst == disp_drv->draw_buf->buf_act) {
+                width = pitch;
+                height = MAX(height, (d2_u32)lv_area_get_height(&disp_drv->draw_buf->area));
+        }
+
+        if ((gpu_state.valid & GPU_STATE_FRAMEBUFFER) && gpu_state.fb == dst && gpu_state.pitch == pitch &&
+                gpu_state.width == width && gpu_state.height == height && gpu_state.format == format) {
+                return D2_OK;
+        }
+
+        gpu_state.valid |= GPU_STATE_FRAMEBUFFER;
+        gpu_state.fb = dst;
+        gpu_state.pitch = pitch;
+        gpu_state.width = width;
+        gpu_state.height = height;
+        gpu_state.format = format;
+        /* D/AVE2D resets the clip rectangle to the new framebuffer */
+        gpu_state.valid &= ~GPU_STATE_CLIPRECT;
+
+        return d2_framebuffer(d2_handle, d1_maptovidmem(d1_handle, dst), pitch, width, height, format);
+}
+
+static d2_s32 lv_port_gpu_set_cliprect(d2_border x1, d2_border y1, d2_border x2, d2_border y2)
+{
+        if ((gpu_state.valid & GPU_STATE_CLIPRECT) && gpu_state.clip_x1 == x1 && gpu_state.clip_y1 == y1 &&
+                gpu_state.clip_x2 == x2 && gpu_state.clip_y2 == y2) {
+                return D2_OK;
+        }
+
+        gpu_state.valid |= GPU_STATE_CLIPRECT;
+        gpu_state.clip_x1 = x1;
+        gpu_state.clip_y1 = y1;
+        gpu_state.clip_x2 = x2;
+        gpu_state.clip_y2 = y2;
+
+        return d2_cliprect(d2_handle, x1, y1, x2, y2);
+}
+
+static d2_s32 lv_port_gpu_set_blendmode(d2_u32 src, d2_u32 dst)
+{
+        if ((gpu_state.valid & GPU_STATE_BLENDMODE) && gpu_state.blend_src == src && gpu_state.blend_dst == dst) {
+                return D2_OK;
+        }
+
+        gpu_state.valid |= GPU_STATE_BLENDMODE;
+        gpu_state.blend_src = src;
+        gpu_state.blend_dst = dst;
+
+        return d2_setblendmode(d2_handle, src, dst);
+}
+
+static d2_s32 lv_port_gpu_set_alphablendmode(d2_u32 src, d2_u32 dst)
+{
+        if ((gpu_state.valid & GPU_STATE_ALPHABLENDMODE) && gpu_state.alpha_blend_src == src &&
+                gpu_state.alpha_blend_dst == dst) {
+                return D2_OK;
+        }
+
+        gpu_state.valid |= GPU_STATE_ALPHABLENDMODE;
+        gpu_state.alpha_blend_src = src;
+        gpu_state.alpha_blend_dst = dst;
+
+        return d2_setalphablendmode(d2_handle, src, dst);
+}
+
+static d2_s32 lv_port_gpu_set_alpha(d2_alpha alpha)
+{
+        if ((gpu_state.valid & GPU_STATE_ALPHA) && gpu_state.alpha == alpha) {
+                return D2_OK;
+        }
+
+        gpu_state.valid |= GPU_STATE_ALPHA;
+        gpu_state.alpha = alpha;
+
+        return d2_setalpha(d2_handle, alpha);
+}
+
+#if LV_PORT_GPU_PIPELINE
+static void lv_port_gpu_pending_add(const lv_color_t *dst, const lv_area_t *area, const void *src)
+{
+        if (d2_handle == NULL) {
+                return;
+        }
+
+        if (lv_port_gpu_src_is_transient(src)) {
+                pending_sync = true;
+        }
+
+        if (pending_area_count == LV_PORT_GPU_PENDING_AREAS_NUM) {
+                pending_sync = true;
+                return;
+        }
+
+        pending_area_list[pending_area_count].dst = dst;
+        lv_area_copy(&pending_area_list[pending_area_count].area, area);
+        pending_area_count++;
 }
+#endif /* LV_PORT_GPU_PIPELINE */
 
 #ifdef LOG_ERRORS
 static void lv_port_gpu_log_error(d2_s32 status, const char *func, int line)
@@ -45,6 +45,65 @@
 #define LV_PORT_DISP_GPU_EN                     (DLG_LVGL_USE_GPU_DA1470X)
 #endif /* LV_PORT_DISP_GPU_EN */
 
+/* Keep the D/AVE2D device and its render buffers open across frames. If disabled, the device is
+ * opened by the first GPU operation of a frame and closed again on every display flush */
+#ifndef LV_PORT_GPU_PERSISTENT_SESSION
+#define LV_PORT_GPU_PERSISTENT_SESSION          (1)
+#endif
+
+/* Alternate between render buffers so that the CPU can build the next display list while the GPU
+ * renders the previous one. Drawing then blocks only when it touches an area still being rendered */
+#ifndef LV_PORT_GPU_PIPELINE
+#define LV_PORT_GPU_PIPELINE                    (1)
+#endif
+
+/* Number of render buffers allocated when the D/AVE2D device is opened */
+#ifndef LV_PORT_GPU_RENDERBUFFER_NUM
+#define LV_PORT_GPU_RENDERBUFFER_NUM            (LV_PORT_GPU_PIPELINE ? 2 : 1)
+#endif
+
+/* Maximum number of GPU operations collected in a render buffer before it is submitted. Operations
+ * are also submitted whenever LVGL waits for the GPU, i.e. at least once per refresh area */
+#ifndef LV_PORT_GPU_BATCH_SIZE
+#define LV_PORT_GPU_BATCH_SIZE                  (16)
+#endif
+
+/* Maximum number of destination areas tracked while GPU operations are in flight. When exceeded,
+ * the next drawing operation waits for the GPU to complete */
+#ifndef LV_PORT_GPU_PENDING_AREAS_NUM
+#define LV_PORT_GPU_PENDING_AREAS_NUM           (8)
+#endif
+
+#if LV_PORT_GPU_PIPELINE && LV_PORT_GPU_RENDERBUFFER_NUM < 2
+#error "LV_PORT_GPU_PIPELINE requires at least two render buffers"
+#endif
+
+/* Default width in pixels of the vertical slices in which rotated images are rendered, without and
+ * with filtering. Narrow slices improve the texture cache hit rate. 0 renders the whole image at once */
+#ifndef LV_PORT_GPU_SLICE_WIDTH
+#define LV_PORT_GPU_SLICE_WIDTH                 (8)
+#endif
+
+#ifndef LV_PORT_GPU_SLICE_WIDTH_FILTER
+#define LV_PORT_GPU_SLICE_WIDTH_FILTER          (6)
+#endif
+
+/* Number of angle ranges within 0..90 degrees that have their own slice settings */
+#ifndef LV_PORT_GPU_SLICE_ANGLE_STEPS
+#define LV_PORT_GPU_SLICE_ANGLE_STEPS           (6)
+#endif
+
+/* Enable lv_port_gpu_slice_calibrate() which measures the best slice settings on the target */
+#ifndef LV_PORT_GPU_SLICE_CALIBRATION
+#define LV_PORT_GPU_SLICE_CALIBRATION           (0)
+#endif
+
+/* Minimum expected GUI idle time in ms for which the persistent GPU session is released, so that
+ * the system can enter sleep */
+#ifndef LV_PORT_GPU_RELEASE_IDLE_MS
+#define LV_PORT_GPU_RELEASE_IDLE_MS             (100)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -64,6 +123,8 @@ void lv_port_gpu_init(void);
 
 void lv_port_gpu_wait(lv_disp_drv_t * disp_drv);
 
+void lv_port_gpu_wait_area(lv_disp_drv_t * disp_drv, const lv_color_t *dst, const lv_area_t *area);
+
 void lv_port_gpu_fill(lv_disp_drv_t *disp_drv, lv_color_t *dst, lv_coord_t dst_width,
         const lv_area_t *fill_area, lv_color_t color, lv_opa_t opa);
 
@@ -79,7 +140,53 @@ void lv_port_gpu_blit_with_mask(lv_disp_drv_t *disp_drv, lv_color_t *dst, const
 void lv_port_gpu_render_box(lv_disp_drv_t *disp_drv,  lv_color_t *dst, lv_coord_t dst_pitch,
         lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h, lv_color_t color);
 
+/* Draw a rectangle with rounded corners and an optional gradient, or the frame around inner_area if it is set.
+ * Returns false if the rectangle has to be drawn by the CPU */
+bool lv_port_gpu_draw_rect(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area, lv_coord_t dst_pitch,
+        const lv_area_t *outer_area, lv_coord_t rout, const lv_area_t *inner_area, lv_coord_t rin,
+        lv_color_t color, lv_color_t grad_color, lv_grad_dir_t grad_dir, uint8_t main_stop, uint8_t grad_stop,
+        lv_opa_t opa, lv_blend_mode_t blend_mode);
+
+/* Draw an arc with the outer radius from start_angle to end_angle (degrees, clockwise) */
+bool lv_port_gpu_draw_arc(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area, lv_coord_t dst_pitch,
+        const lv_point_t *center, uint16_t radius, uint16_t start_angle, uint16_t end_angle, lv_coord_t width,
+        bool rounded, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+
+/* Draw a line with flat ends */
+bool lv_port_gpu_draw_line(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area, lv_coord_t dst_pitch,
+        const lv_point_t *point1, const lv_point_t *point2, lv_coord_t width, lv_color_t color, lv_opa_t opa,
+        lv_blend_mode_t blend_mode);
+
+/* Fill a convex polygon. Returns false for concave polygons which have to be drawn by the CPU */
+bool lv_port_gpu_draw_polygon(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area,
+        lv_coord_t dst_pitch, const lv_point_t *points, uint16_t point_cnt, lv_color_t color, lv_opa_t opa,
+        lv_blend_mode_t blend_mode);
+
+/* Draw a shadow as 9 slices of its blurred top right corner (A8, corner_size^2), skipping the parts which lie
+ * behind the rounded bg_area */
+void lv_port_gpu_draw_shadow(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area,
+        lv_coord_t dst_pitch, const lv_area_t *shadow_area, const lv_area_t *bg_area, lv_coord_t r_bg,
+        const lv_opa_t *corner, lv_coord_t corner_size, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+
 void lv_port_gpu_flush(void);
+
+void lv_port_gpu_release(void);
+
+#ifdef PERFORMANCE_METRICS
+/* Report the following GPU operations under the given metrics tag, 0 restores the default tags */
+void lv_port_gpu_set_metrics_tag(uint8_t tag);
+#endif
+
+/* Set the slices used for rotated images of the given filtering, bpp and angle range. A width of 0
+ * renders the whole image at once */
+void lv_port_gpu_set_slice(bool filter, uint8_t bpp, uint16_t angle, uint8_t width, bool horizontal);
+
+#if LV_PORT_GPU_SLICE_CALIBRATION
+/* Rotate img in the dst scratch buffer with every slice setting, keep the fastest per angle range and
+ * print the results so that they can be applied with lv_port_gpu_set_slice() */
+void lv_port_gpu_slice_calibrate(lv_disp_drv_t *disp_drv, lv_color_t *dst, lv_coord_t dst_w, lv_coord_t dst_h,
+        const lv_img_dsc_t *img);
+#endif
 /**********************
  *   STATIC FUNCTIONS
  **********************/
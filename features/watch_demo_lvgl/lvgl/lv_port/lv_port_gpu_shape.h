@@ -0,0 +1,222 @@
+/**
+ ****************************************************************************************
+ *
+ * @file lv_port_gpu_shape.h
+ *
+ * @brief Geometry of the D/AVE2D shapes drawn for LVGL arcs, lines and polygons
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#ifndef LV_PORT_GPU_SHAPE_H_
+#define LV_PORT_GPU_SHAPE_H_
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+/*
+ * The shapes are computed without any driver call so that tools/gpu_shapes_test.c can check them against the
+ * LVGL software renderer on the host. Coordinates are in 12.4 fixed point like D2_FIX4(), pixel x covers
+ * x to x + 1, and normals are in 16.16 fixed point.
+ */
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_PORT_GPU_SHAPE_FIX4(x)               ((int32_t)(x) * 16)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+        int32_t cx, cy;                 /* Center */
+        int32_t r, w;                   /* Radius of the middle of the outline and its width */
+        bool ring;                      /* Full circle, drawn without the wedge */
+        int32_t nx1, ny1, nx2, ny2;     /* Normals of the start and end edges, pointing inside the wedge */
+        bool concave;                   /* Above 180 degrees the wedge is the union of the two half planes */
+        int32_t cap_x[2], cap_y[2];     /* Centers of the rounded ends, whose radius is w / 2 */
+} lv_port_gpu_arc_shape;
+
+typedef struct {
+        int32_t x1, y1, x2, y2;         /* Ends of the center line */
+        int32_t w;                      /* Width, the ends are flat */
+} lv_port_gpu_line_shape;
+
+/**********************
+ *  INLINE FUNCTIONS
+ **********************/
+
+/* Offset of a rounded end of an arc from its center along one axis. The end is placed on the pixel grid the way
+ * lv_draw_arc() does it, sin being the sine of the angle to that axis */
+static inline int32_t lv_port_gpu_arc_cap_offset(uint16_t radius, lv_coord_t width, int32_t sin)
+{
+        int32_t thick_half = width / 2;
+        int32_t thick_corr = (width & 1) ? 0 : 1;
+        int32_t c = ((radius - thick_half) * sin) >> (LV_TRIGO_SHIFT - 8);
+        int32_t c1, c2;
+
+        if (c > 0) {
+                c = (c - 127) >> 8;
+                c1 = c - thick_half + thick_corr;
+                c2 = c + thick_half;
+        } else {
+                c = (c + 127) >> 8;
+                c1 = c - thick_half;
+                c2 = c + thick_half - thick_corr;
+        }
+
+        /* Middle of the pixels c1 to c2 */
+        return LV_PORT_GPU_SHAPE_FIX4(c1 + c2 + 1) / 2;
+}
+
+/* Arc with the outer radius from start_angle to end_angle (degrees, clockwise) */
+static inline void lv_port_gpu_arc_shape_get(lv_port_gpu_arc_shape *shape, const lv_point_t *center,
+        uint16_t radius, uint16_t start_angle, uint16_t end_angle, lv_coord_t width)
+{
+        int32_t sin_start, cos_start, sin_end, cos_end;
+        int32_t sweep;
+
+        shape->cx = LV_PORT_GPU_SHAPE_FIX4(center->x);
+        shape->cy = LV_PORT_GPU_SHAPE_FIX4(center->y);
+        /* Outlines are centered on the radius, LVGL gives the outer one */
+        shape->r = LV_PORT_GPU_SHAPE_FIX4(radius) - LV_PORT_GPU_SHAPE_FIX4(width) / 2;
+        shape->w = LV_PORT_GPU_SHAPE_FIX4(width);
+
+        shape->ring = start_angle + 360 == end_angle || start_angle == end_angle + 360;
+        if (shape->ring) {
+                return;
+        }
+
+        while (start_angle >= 360) {
+                start_angle -= 360;
+        }
+        while (end_angle >= 360) {
+                end_angle -= 360;
+        }
+        sweep = end_angle >= start_angle ? end_angle - start_angle : end_angle + 360 - start_angle;
+        shape->concave = sweep > 180;
+
+        sin_start = lv_trigo_sin(start_angle);
+        cos_start = lv_trigo_cos(start_angle);
+        sin_end = lv_trigo_sin(end_angle);
+        cos_end = lv_trigo_cos(end_angle);
+
+        shape->nx1 = -(sin_start << 1);
+        shape->ny1 = cos_start << 1;
+        shape->nx2 = sin_end << 1;
+        shape->ny2 = -(cos_end << 1);
+
+        shape->cap_x[0] = shape->cx + lv_port_gpu_arc_cap_offset(radius, width, lv_trigo_sin(90 - start_angle));
+        shape->cap_y[0] = shape->cy + lv_port_gpu_arc_cap_offset(radius, width, sin_start);
+        shape->cap_x[1] = shape->cx + lv_port_gpu_arc_cap_offset(radius, width, lv_trigo_sin(90 - end_angle));
+        shape->cap_y[1] = shape->cy + lv_port_gpu_arc_cap_offset(radius, width, sin_end);
+}
+
+/* Skewed line as drawn by LVGL, which widens the line along its minor axis to a whole number of pixels, the
+ * extra pixel of an odd width being below or right of the points */
+static inline void lv_port_gpu_line_shape_get(lv_port_gpu_line_shape *shape, const lv_point_t *point1,
+        const lv_point_t *point2, lv_coord_t width)
+{
+        /* 128 * length / major axis length, indexed by 32 * minor / major axis length as in draw_line_skew() */
+        static const uint8_t wcorr[] = {
+                128, 128, 128, 129, 129, 130, 130, 131,
+                132, 133, 134, 135, 137, 138, 140, 141,
+                143, 145, 147, 149, 151, 153, 155, 158,
+                160, 162, 165, 167, 170, 173, 175, 178,
+                181,
+        };
+        int32_t xdiff = LV_ABS(point2->x - point1->x);
+        int32_t ydiff = LV_ABS(point2->y - point1->y);
+        bool flat = xdiff > ydiff;
+        int32_t corr = wcorr[flat ? (ydiff << 5) / xdiff : (xdiff << 5) / ydiff];
+        int32_t w = (width * corr + 63) >> 7;
+        int32_t offset = (w & 1) ? LV_PORT_GPU_SHAPE_FIX4(1) / 2 : 0;
+
+        shape->x1 = LV_PORT_GPU_SHAPE_FIX4(point1->x) + (flat ? 0 : offset);
+        shape->y1 = LV_PORT_GPU_SHAPE_FIX4(point1->y) + (flat ? offset : 0);
+        shape->x2 = LV_PORT_GPU_SHAPE_FIX4(point2->x) + (flat ? 0 : offset);
+        shape->y2 = LV_PORT_GPU_SHAPE_FIX4(point2->y) + (flat ? offset : 0);
+        shape->w = LV_PORT_GPU_SHAPE_FIX4(w) * 128 / corr;
+}
+
+/* Winding of a polygon, which is drawn as a triangle fan around its first point. Returns a positive value for
+ * a convex polygon, 0 if all points are on a line and a negative value for a concave polygon, which the fan
+ * cannot draw */
+static inline int lv_port_gpu_polygon_convexity(const lv_point_t *points, uint16_t point_cnt)
+{
+        int32_t winding = 0;
+
+        for (uint16_t i = 0; i < point_cnt; i++) {
+                const lv_point_t *a = &points[i];
+                const lv_point_t *b = &points[(i + 1) % point_cnt];
+                const lv_point_t *c = &points[(i + 2) % point_cnt];
+                int32_t cross = (b->x - a->x) * (c->y - b->y) - (b->y - a->y) * (c->x - b->x);
+
+                if (cross == 0) {
+                        continue;
+                }
+                if (winding == 0) {
+                        winding = cross;
+                } else if ((winding > 0) != (cross > 0)) {
+                        return -1;
+                }
+        }
+
+        return winding != 0 ? 1 : 0;
+}
+
+/* Bottom right corner of the bounding box of a polygon */
+static inline void lv_port_gpu_polygon_max_get(const lv_point_t *points, uint16_t point_cnt, lv_point_t *max)
+{
+        max->x = points[0].x;
+        max->y = points[0].y;
+        for (uint16_t i = 1; i < point_cnt; i++) {
+                max->x = LV_MAX(max->x, points[i].x);
+                max->y = LV_MAX(max->y, points[i].y);
+        }
+}
+
+/* Point i of a polygon. lv_draw_polygon() fills the last row and column of the bounding box when a horizontal or
+ * vertical edge lies on it, so the ends of such edges are moved out by one pixel */
+static inline void lv_port_gpu_polygon_point_get(const lv_point_t *points, uint16_t point_cnt, uint16_t i,
+        const lv_point_t *max, int32_t *x, int32_t *y)
+{
+        const lv_point_t *p = &points[i];
+        const lv_point_t *prev = &points[i ? i - 1 : point_cnt - 1];
+        const lv_point_t *next = &points[i + 1 < point_cnt ? i + 1 : 0];
+
+        *x = LV_PORT_GPU_SHAPE_FIX4(p->x);
+        *y = LV_PORT_GPU_SHAPE_FIX4(p->y);
+        if (p->x == max->x && (prev->x == p->x || next->x == p->x)) {
+                *x += LV_PORT_GPU_SHAPE_FIX4(1);
+        }
+        if (p->y == max->y && (prev->y == p->y || next->y == p->y)) {
+                *y += LV_PORT_GPU_SHAPE_FIX4(1);
+        }
+}
+
+#endif /* LV_PORT_GPU_SHAPE_H_ */
@@ -0,0 +1,293 @@
+/**
+ ****************************************************************************************
+ *
+ * @file lv_port_img_cache.c
+ *
+ * @brief Decoded image cache
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lvgl.h"
+#include "src/misc/lv_tlsf.h"
+#include "lv_port_img_cache.h"
+
+#if LV_PORT_IMG_CACHE_EN
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_PORT_IMG_CACHE_SIZE > GDI_GUI_HEAP_SIZE
+#error "LV_PORT_IMG_CACHE_SIZE must not exceed GDI_GUI_HEAP_SIZE"
+#endif
+
+/* D/AVE2D RLE packet header: MSB set for a repeated pixel, lower bits hold the pixel count - 1 */
+#define RLE_REPEAT_FLAG                         (0x80)
+#define RLE_COUNT_MASK                          (0x7F)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+        const lv_img_dsc_t *src;
+        uint8_t *buf;
+        uint32_t last_use;
+        uint16_t users;
+} img_cache_entry;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_res_t lv_port_img_cache_info(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header);
+static lv_res_t lv_port_img_cache_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc);
+static void lv_port_img_cache_close(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc);
+static img_cache_entry *lv_port_img_cache_load(const lv_img_dsc_t *img);
+static img_cache_entry *lv_port_img_cache_get_free_entry(void);
+static bool lv_port_img_cache_evict(void);
+static bool lv_port_img_cache_decode(const lv_img_dsc_t *img, uint8_t *dst, uint32_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+PRIVILEGED_DATA static lv_tlsf_t cache_tlsf;
+PRIVILEGED_DATA static img_cache_entry cache_entries[LV_PORT_IMG_CACHE_ENTRY_NUM];
+PRIVILEGED_DATA static uint32_t cache_use_count;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_port_img_cache_init(void)
+{
+        lv_img_decoder_t *decoder;
+
+        cache_tlsf = lv_tlsf_create_with_pool(gdi_get_gui_heap_addr(), LV_PORT_IMG_CACHE_SIZE);
+        if (cache_tlsf == NULL) {
+                return;
+        }
+
+        /* Decoders created last are tried first, RLE images fall back to the built-in decoder and the
+         * GPU if they cannot be cached */
+        decoder = lv_img_decoder_create();
+        LV_ASSERT_MALLOC(decoder);
+        if (decoder == NULL) {
+                return;
+        }
+
+        lv_img_decoder_set_info_cb(decoder, lv_port_img_cache_info);
+        lv_img_decoder_set_open_cb(decoder, lv_port_img_cache_open);
+        lv_img_decoder_set_close_cb(decoder, lv_port_img_cache_close);
+}
+
+void lv_port_img_cache_flush(void)
+{
+        while (lv_port_img_cache_evict());
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_res_t lv_port_img_cache_info(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header)
+{
+        const lv_img_dsc_t *img = src;
+
+        LV_UNUSED(decoder);
+
+        if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE || !img->header.rle ||
+                lv_img_cf_get_px_size(img->header.cf) < 8) {
+                return LV_RES_INV;
+        }
+
+        /* The image is handed out decoded */
+        *header = img->header;
+        header->rle = 0;
+
+        return LV_RES_OK;
+}
+
+static lv_res_t lv_port_img_cache_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+        const lv_img_dsc_t *img = dsc->src;
+        img_cache_entry *entry = NULL;
+
+        LV_UNUSED(decoder);
+
+        for (int i = 0; i < LV_PORT_IMG_CACHE_ENTRY_NUM; i++) {
+                if (cache_entries[i].src == img) {
+                        entry = &cache_entries[i];
+                        break;
+                }
+        }
+
+        if (entry == NULL) {
+                entry = lv_port_img_cache_load(img);
+                if (entry == NULL) {
+                        return LV_RES_INV;
+                }
+        }
+
+        entry->users++;
+        entry->last_use = ++cache_use_count;
+
+        dsc->img_data = entry->buf;
+        dsc->user_data = entry;
+
+        return LV_RES_OK;
+}
+
+static void lv_port_img_cache_close(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+        img_cache_entry *entry = dsc->user_data;
+
+        LV_UNUSED(decoder);
+
+        if (entry && entry->users) {
+                entry->users--;
+        }
+}
+
+static img_cache_entry *lv_port_img_cache_load(const lv_img_dsc_t *img)
+{
+        uint32_t size = (uint32_t)img->header.w * img->header.h * (lv_img_cf_get_px_size(img->header.cf) / 8);
+        img_cache_entry *entry;
+        uint8_t *buf;
+
+        if (size > LV_PORT_IMG_CACHE_SIZE) {
+                return NULL;
+        }
+
+        while ((entry = lv_port_img_cache_get_free_entry()) == NULL) {
+                if (!lv_port_img_cache_evict()) {
+                        return NULL;
+                }
+        }
+
+        /* Drop the least recently used images until the decoded image fits */
+        while ((buf = lv_tlsf_malloc(cache_tlsf, size)) == NULL) {
+                if (!lv_port_img_cache_evict()) {
+                        return NULL;
+                }
+        }
+
+        if (!lv_port_img_cache_decode(img, buf, size)) {
+                LV_LOG_WARN("lv_port_img_cache: corrupted RLE image");
+                lv_tlsf_free(cache_tlsf, buf);
+                return NULL;
+        }
+
+        entry->src = img;
+        entry->buf = buf;
+        entry->users = 0;
+
+        return entry;
+}
+
+static img_cache_entry *lv_port_img_cache_get_free_entry(void)
+{
+        for (int i = 0; i < LV_PORT_IMG_CACHE_ENTRY_NUM; i++) {
+                if (cache_entries[i].src == NULL) {
+                        return &cache_entries[i];
+                }
+        }
+
+        return NULL;
+}
+
+static bool lv_port_img_cache_evict(void)
+{
+        img_cache_entry *lru = NULL;
+        lv_disp_t *disp;
+
+        for (int i = 0; i < LV_PORT_IMG_CACHE_ENTRY_NUM; i++) {
+                img_cache_entry *entry = &cache_entries[i];
+
+                if (entry->src && entry->users == 0 && (lru == NULL || entry->last_use < lru->last_use)) {
+                        lru = entry;
+                }
+        }
+
+        if (lru == NULL) {
+                return false;
+        }
+
+        /* Blits already queued to the GPU may still read the decoded image */
+        disp = _lv_refr_get_disp_refreshing();
+        if (disp == NULL) {
+                disp = lv_disp_get_default();
+        }
+        if (disp && disp->driver->gpu_wait_cb) {
+                disp->driver->gpu_wait_cb(disp->driver);
+        }
+
+        lv_tlsf_free(cache_tlsf, lru->buf);
+        lru->src = NULL;
+        lru->buf = NULL;
+
+        return true;
+}
+
+static bool lv_port_img_cache_decode(const lv_img_dsc_t *img, uint8_t *dst, uint32_t size)
+{
+        const uint8_t *src = img->data;
+        const uint8_t *src_end = src + img->data_size;
+        const uint8_t *dst_end = dst + size;
+        uint8_t px_size = lv_img_cf_get_px_size(img->header.cf) / 8;
+
+        while (dst < dst_end) {
+                uint8_t packet;
+                uint32_t len;
+
+                if (src >= src_end) {
+                        return false;
+                }
+
+                packet = *src++;
+                len = ((packet & RLE_COUNT_MASK) + 1) * px_size;
+                if (dst + len > dst_end) {
+                        return false;
+                }
+
+                if (packet & RLE_REPEAT_FLAG) {
+                        if (src + px_size > src_end) {
+                                return false;
+                        }
+                        for (uint32_t i = 0; i < len; i += px_size) {
+                                lv_memcpy_small(dst + i, src, px_size);
+                        }
+                        src += px_size;
+                } else {
+                        if (src + len > src_end) {
+                                return false;
+                        }
+                        lv_memcpy(dst, src, len);
+                        src += len;
+                }
+                dst += len;
+        }
+
+        return true;
+}
+#endif /* LV_PORT_IMG_CACHE_EN */
@@ -0,0 +1,69 @@
+/**
+ ****************************************************************************************
+ *
+ * @file lv_port_img_cache.h
+ *
+ * @brief Decoded image cache
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#ifndef LV_PORT_IMG_CACHE_H_
+#define LV_PORT_IMG_CACHE_H_
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+#include "gdi.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/* Bytes of the GDI GUI heap used to keep RLE images decoded. The GUI heap is placed in QSPI RAM
+ * when GDI_HEAP_USE_QSPI_RAM is set. If 0, RLE images are decoded by the GPU on every blit */
+#ifndef LV_PORT_IMG_CACHE_SIZE
+#define LV_PORT_IMG_CACHE_SIZE                  (GDI_GUI_HEAP_SIZE)
+#endif
+
+/* Maximum number of decoded images kept at the same time */
+#ifndef LV_PORT_IMG_CACHE_ENTRY_NUM
+#define LV_PORT_IMG_CACHE_ENTRY_NUM             (8)
+#endif
+
+#define LV_PORT_IMG_CACHE_EN                    (LV_PORT_IMG_CACHE_SIZE > 0)
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+#if LV_PORT_IMG_CACHE_EN
+/* Register the RLE image decoder, must be called after lv_init() */
+void lv_port_img_cache_init(void);
+
+/* Drop every decoded image that is not in use */
+void lv_port_img_cache_flush(void);
+#endif /* LV_PORT_IMG_CACHE_EN */
+
+#endif /* LV_PORT_IMG_CACHE_H_ */
@@ -0,0 +1,217 @@
+/**
+ ****************************************************************************************
+ *
+ * @file lv_port_shadow_cache.c
+ *
+ * @brief Cache of blurred shadow corners for GPU shadow rendering
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lvgl.h"
+#include "lv_port_shadow_cache.h"
+
+#if LV_PORT_SHADOW_CACHE_EN
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/* The corner does not depend on the spread or the color, so that all shadows of the same width and radius
+ * share it */
+typedef struct {
+        lv_opa_t *buf;                          /* NULL if the entry is free */
+        lv_coord_t sw;
+        lv_coord_t r;
+        uint32_t last_use;
+} shadow_cache_entry;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static shadow_cache_entry *lv_port_shadow_cache_find(lv_coord_t sw, lv_coord_t r);
+static shadow_cache_entry *lv_port_shadow_cache_add(lv_coord_t sw, lv_coord_t r, const lv_opa_t *corner);
+static shadow_cache_entry *lv_port_shadow_cache_get_free_entry(void);
+static bool lv_port_shadow_cache_evict(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+PRIVILEGED_DATA static shadow_cache_entry cache_entries[LV_PORT_SHADOW_CACHE_ENTRY_NUM];
+PRIVILEGED_DATA static uint32_t cache_use_count;
+PRIVILEGED_DATA static uint32_t cache_used_size;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool lv_port_shadow_cache_draw(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area,
+        lv_coord_t dst_pitch, const lv_area_t *shadow_area, const lv_area_t *bg_area, lv_coord_t r_bg,
+        lv_coord_t sw, lv_coord_t r, const lv_opa_t *corner, lv_color_t color, lv_opa_t opa,
+        lv_blend_mode_t blend_mode)
+{
+        shadow_cache_entry *entry;
+
+        if (blend_mode != LV_BLEND_MODE_NORMAL && blend_mode != LV_BLEND_MODE_ADDITIVE) {
+                return false;
+        }
+
+        /* Without a corner only a cached one can be used, LVGL blurs it on a miss and calls again */
+        entry = lv_port_shadow_cache_find(sw, r);
+        if (entry == NULL) {
+                if (corner == NULL) {
+                        return false;
+                }
+                entry = lv_port_shadow_cache_add(sw, r, corner);
+                if (entry == NULL) {
+                        return false;
+                }
+        }
+        entry->last_use = ++cache_use_count;
+
+        lv_port_gpu_draw_shadow(disp_drv, dst, dst_area, dst_pitch, shadow_area, bg_area, r_bg, entry->buf,
+                sw + r, color, opa, blend_mode);
+
+        return true;
+}
+
+bool lv_port_shadow_cache_is_corner(const void *buf)
+{
+        for (int i = 0; i < LV_PORT_SHADOW_CACHE_ENTRY_NUM; i++) {
+                if (buf && cache_entries[i].buf == buf) {
+                        return true;
+                }
+        }
+
+        return false;
+}
+
+void lv_port_shadow_cache_flush(void)
+{
+        while (lv_port_shadow_cache_evict());
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static shadow_cache_entry *lv_port_shadow_cache_find(lv_coord_t sw, lv_coord_t r)
+{
+        for (int i = 0; i < LV_PORT_SHADOW_CACHE_ENTRY_NUM; i++) {
+                shadow_cache_entry *entry = &cache_entries[i];
+
+                if (entry->buf && entry->sw == sw && entry->r == r) {
+                        return entry;
+                }
+        }
+
+        return NULL;
+}
+
+static shadow_cache_entry *lv_port_shadow_cache_add(lv_coord_t sw, lv_coord_t r, const lv_opa_t *corner)
+{
+        uint32_t size = (uint32_t)(sw + r) * (sw + r);
+        shadow_cache_entry *entry;
+        lv_opa_t *buf;
+
+        if (size > LV_PORT_SHADOW_CACHE_SIZE) {
+                return NULL;
+        }
+
+        while ((entry = lv_port_shadow_cache_get_free_entry()) == NULL) {
+                if (!lv_port_shadow_cache_evict()) {
+                        return NULL;
+                }
+        }
+
+        /* Drop the least recently used corners until the new one fits in the budget */
+        while (cache_used_size + size > LV_PORT_SHADOW_CACHE_SIZE) {
+                if (!lv_port_shadow_cache_evict()) {
+                        return NULL;
+                }
+        }
+
+        buf = lv_mem_alloc(size);
+        if (buf == NULL) {
+                return NULL;
+        }
+        lv_memcpy(buf, corner, size);
+
+        entry->buf = buf;
+        entry->sw = sw;
+        entry->r = r;
+        cache_used_size += size;
+
+        return entry;
+}
+
+static shadow_cache_entry *lv_port_shadow_cache_get_free_entry(void)
+{
+        for (int i = 0; i < LV_PORT_SHADOW_CACHE_ENTRY_NUM; i++) {
+                if (cache_entries[i].buf == NULL) {
+                        return &cache_entries[i];
+                }
+        }
+
+        return NULL;
+}
+
+static bool lv_port_shadow_cache_evict(void)
+{
+        shadow_cache_entry *lru = NULL;
+        lv_disp_t *disp;
+
+        for (int i = 0; i < LV_PORT_SHADOW_CACHE_ENTRY_NUM; i++) {
+                shadow_cache_entry *entry = &cache_entries[i];
+
+                if (entry->buf && (lru == NULL || entry->last_use < lru->last_use)) {
+                        lru = entry;
+                }
+        }
+
+        if (lru == NULL) {
+                return false;
+        }
+
+        /* Blits already queued to the GPU may still read the corner */
+        disp = _lv_refr_get_disp_refreshing();
+        if (disp == NULL) {
+                disp = lv_disp_get_default();
+        }
+        if (disp && disp->driver->gpu_wait_cb) {
+                disp->driver->gpu_wait_cb(disp->driver);
+        }
+
+        cache_used_size -= (uint32_t)(lru->sw + lru->r) * (lru->sw + lru->r);
+        lv_mem_free(lru->buf);
+        lru->buf = NULL;
+
+        return true;
+}
+
+#endif /* LV_PORT_SHADOW_CACHE_EN */
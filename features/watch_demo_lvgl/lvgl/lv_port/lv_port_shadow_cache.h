@@ -0,0 +1,76 @@
+/**
+ ****************************************************************************************
+ *
+ * @file lv_port_shadow_cache.h
+ *
+ * @brief Cache of blurred shadow corners for GPU shadow rendering
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#ifndef LV_PORT_SHADOW_CACHE_H_
+#define LV_PORT_SHADOW_CACHE_H_
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+#include "lv_port_gpu.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/* Bytes of the LVGL heap used to keep blurred shadow corners, which are then drawn by the GPU. A corner takes
+ * (shadow width + radius)^2 bytes. The least recently used corners are dropped first. If 0, shadows are
+ * drawn by the CPU */
+#ifndef LV_PORT_SHADOW_CACHE_SIZE
+#define LV_PORT_SHADOW_CACHE_SIZE               (4 * 1024)
+#endif
+
+/* Maximum number of blurred corners kept at the same time */
+#ifndef LV_PORT_SHADOW_CACHE_ENTRY_NUM
+#define LV_PORT_SHADOW_CACHE_ENTRY_NUM          (8)
+#endif
+
+#define LV_PORT_SHADOW_CACHE_EN                 (LV_PORT_DISP_GPU_EN && LV_PORT_SHADOW_CACHE_SIZE > 0)
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+#if LV_PORT_SHADOW_CACHE_EN
+/* Draw a shadow out of its cached corner, used as `gpu_draw_shadow_cb` of the display driver */
+bool lv_port_shadow_cache_draw(lv_disp_drv_t *disp_drv, lv_color_t *dst, const lv_area_t *dst_area,
+        lv_coord_t dst_pitch, const lv_area_t *shadow_area, const lv_area_t *bg_area, lv_coord_t r_bg,
+        lv_coord_t sw, lv_coord_t r, const lv_opa_t *corner, lv_color_t color, lv_opa_t opa,
+        lv_blend_mode_t blend_mode);
+
+/* Check whether a buffer is a cached corner, which stays valid while GPU operations are queued */
+bool lv_port_shadow_cache_is_corner(const void *buf);
+
+/* Drop every cached corner */
+void lv_port_shadow_cache_flush(void);
+#endif /* LV_PORT_SHADOW_CACHE_EN */
+
+#endif /* LV_PORT_SHADOW_CACHE_H_ */
@@ -0,0 +1,354 @@
+/**
+ ****************************************************************************************
+ *
+ * @file lv_port_snapshot.c
+ *
+ * @brief Layers of static objects drawn from a snapshot
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lvgl.h"
+#include "src/misc/lv_tlsf.h"
+#include "lv_port_snapshot.h"
+#include "lv_port_img_cache.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_PORT_SNAPSHOT_EN
+#if LV_PORT_IMG_CACHE_SIZE + LV_PORT_SNAPSHOT_SIZE > GDI_GUI_HEAP_SIZE
+#error "LV_PORT_IMG_CACHE_SIZE and LV_PORT_SNAPSHOT_SIZE must fit in GDI_GUI_HEAP_SIZE"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+        lv_obj_t obj;
+        lv_img_dsc_t dsc;
+        uint8_t *buf;                           /* NULL if no memory is reserved for the snapshot */
+        uint32_t buf_size;
+        lv_timer_t *timer;
+        uint32_t last_use;
+} snapshot_layer_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_port_snapshot_layer_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void lv_port_snapshot_layer_destructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void lv_port_snapshot_layer_event(const lv_obj_class_t *class_p, lv_event_t *e);
+static void lv_port_snapshot_timer_cb(lv_timer_t *timer);
+static void lv_port_snapshot_drop(snapshot_layer_t *layer);
+static void lv_port_snapshot_take(snapshot_layer_t *layer);
+static bool lv_port_snapshot_alloc(snapshot_layer_t *layer, uint32_t size);
+static void lv_port_snapshot_release(snapshot_layer_t *layer);
+static bool lv_port_snapshot_evict(const snapshot_layer_t *keep);
+static void lv_port_snapshot_gpu_wait(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const lv_obj_class_t lv_port_snapshot_layer_class = {
+        .base_class = &lv_obj_class,
+        .constructor_cb = lv_port_snapshot_layer_constructor,
+        .destructor_cb = lv_port_snapshot_layer_destructor,
+        .event_cb = lv_port_snapshot_layer_event,
+        .width_def = LV_PCT(100),
+        .height_def = LV_PCT(100),
+        .instance_size = sizeof(snapshot_layer_t),
+};
+
+PRIVILEGED_DATA static lv_tlsf_t snapshot_tlsf;
+PRIVILEGED_DATA static snapshot_layer_t *snapshot_layers[LV_PORT_SNAPSHOT_LAYER_NUM];
+PRIVILEGED_DATA static uint32_t snapshot_use_count;
+#endif /* LV_PORT_SNAPSHOT_EN */
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t *lv_port_snapshot_layer_create(lv_obj_t *parent)
+{
+        lv_obj_t *obj;
+
+#if LV_PORT_SNAPSHOT_EN
+        obj = lv_obj_class_create_obj(&lv_port_snapshot_layer_class, parent);
+        lv_obj_class_init_obj(obj);
+#else
+        obj = lv_obj_create(parent);
+        lv_obj_set_size(obj, LV_PCT(100), LV_PCT(100));
+#endif
+        lv_obj_remove_style_all(obj);
+
+        /* Input goes to the parent, like for a plain image */
+        lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+
+        return obj;
+}
+
+#if LV_PORT_SNAPSHOT_EN
+void lv_port_snapshot_init(void)
+{
+        snapshot_tlsf = lv_tlsf_create_with_pool((uint8_t *)gdi_get_gui_heap_addr() + LV_PORT_IMG_CACHE_SIZE,
+                LV_PORT_SNAPSHOT_SIZE);
+}
+
+bool lv_port_snapshot_is_buf(const void *buf)
+{
+        for (int i = 0; i < LV_PORT_SNAPSHOT_LAYER_NUM; i++) {
+                if (buf && snapshot_layers[i] && snapshot_layers[i]->buf == buf) {
+                        return true;
+                }
+        }
+
+        return false;
+}
+
+void lv_port_snapshot_flush(void)
+{
+        for (int i = 0; i < LV_PORT_SNAPSHOT_LAYER_NUM; i++) {
+                snapshot_layer_t *layer = snapshot_layers[i];
+
+                if (layer) {
+                        lv_port_snapshot_release(layer);
+                        lv_port_snapshot_drop(layer);
+                }
+        }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_port_snapshot_layer_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj)
+{
+        snapshot_layer_t *layer = (snapshot_layer_t *)obj;
+
+        LV_UNUSED(class_p);
+
+        /* The first snapshot is taken once the new children have been added */
+        layer->timer = lv_timer_create(lv_port_snapshot_timer_cb, LV_PORT_SNAPSHOT_DELAY_MS, layer);
+}
+
+static void lv_port_snapshot_layer_destructor(const lv_obj_class_t *class_p, lv_obj_t *obj)
+{
+        snapshot_layer_t *layer = (snapshot_layer_t *)obj;
+
+        LV_UNUSED(class_p);
+
+        lv_timer_del(layer->timer);
+        if (layer->buf) {
+                lv_port_snapshot_release(layer);
+        }
+}
+
+static void lv_port_snapshot_layer_event(const lv_obj_class_t *class_p, lv_event_t *e)
+{
+        lv_event_code_t code = lv_event_get_code(e);
+        lv_obj_t *obj = lv_event_get_target(e);
+        snapshot_layer_t *layer = (snapshot_layer_t *)obj;
+
+        LV_UNUSED(class_p);
+
+        /* The snapshot holds the background of the layer too */
+        if (code == LV_EVENT_DRAW_MAIN && lv_obj_has_flag(obj, LV_OBJ_FLAG_SNAPSHOT)) {
+                const lv_area_t *clip_area = lv_event_get_param(e);
+                lv_draw_img_dsc_t img_dsc;
+
+                lv_draw_img_dsc_init(&img_dsc);
+                lv_draw_img(&obj->coords, clip_area, &layer->dsc, &img_dsc);
+                layer->last_use = ++snapshot_use_count;
+                return;
+        }
+
+        if (lv_obj_event_base(&lv_port_snapshot_layer_class, e) != LV_RES_OK) {
+                return;
+        }
+
+        switch (code) {
+        case LV_EVENT_REFRESH:
+        case LV_EVENT_CHILD_CHANGED:
+        case LV_EVENT_CHILD_CREATED:
+        case LV_EVENT_CHILD_DELETED:
+        case LV_EVENT_STYLE_CHANGED:
+        case LV_EVENT_SIZE_CHANGED:
+                lv_port_snapshot_drop(layer);
+                break;
+        default:
+                break;
+        }
+}
+
+static void lv_port_snapshot_timer_cb(lv_timer_t *timer)
+{
+        snapshot_layer_t *layer = timer->user_data;
+
+        /* The snapshot would not be drawn before the layer is shown */
+        if (lv_obj_get_screen(&layer->obj) != lv_scr_act() || !lv_obj_is_visible(&layer->obj)) {
+                return;
+        }
+
+        lv_timer_pause(timer);
+        lv_port_snapshot_take(layer);
+}
+
+static void lv_port_snapshot_drop(snapshot_layer_t *layer)
+{
+        /* The children are drawn again until they stop changing, the memory is kept for the next snapshot */
+        lv_obj_clear_flag(&layer->obj, LV_OBJ_FLAG_SNAPSHOT);
+        lv_timer_reset(layer->timer);
+        lv_timer_resume(layer->timer);
+}
+
+static void lv_port_snapshot_take(snapshot_layer_t *layer)
+{
+        lv_obj_t *obj = &layer->obj;
+        lv_cover_check_info_t info;
+        uint32_t size;
+
+        /* The snapshot has no alpha channel, so it must hide everything behind the layer */
+        info.res = LV_COVER_RES_COVER;
+        info.area = &obj->coords;
+        lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+        if (info.res != LV_COVER_RES_COVER || _lv_obj_get_ext_draw_size(obj) > 0) {
+                LV_LOG_WARN("lv_port_snapshot: layer is not opaque");
+                return;
+        }
+
+        size = lv_snapshot_buf_size_needed(obj, LV_IMG_CF_TRUE_COLOR);
+        if (layer->buf && layer->buf_size != size) {
+                lv_port_snapshot_release(layer);
+        }
+        if (layer->buf == NULL) {
+                if (!lv_port_snapshot_alloc(layer, size)) {
+                        return;
+                }
+        } else {
+                /* Blits already queued to the GPU may still read the previous snapshot */
+                lv_port_snapshot_gpu_wait();
+        }
+
+        if (lv_snapshot_take_to_buf(obj, LV_IMG_CF_TRUE_COLOR, &layer->dsc, layer->buf, size) != LV_RES_OK) {
+                lv_port_snapshot_release(layer);
+                return;
+        }
+
+        /* LVGL caches opened images by their descriptor */
+        lv_img_cache_invalidate_src(&layer->dsc);
+        layer->last_use = ++snapshot_use_count;
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_SNAPSHOT);
+}
+
+static bool lv_port_snapshot_alloc(snapshot_layer_t *layer, uint32_t size)
+{
+        int slot;
+        uint8_t *buf;
+
+        if (snapshot_tlsf == NULL || size > LV_PORT_SNAPSHOT_SIZE) {
+                return false;
+        }
+
+        while (true) {
+                for (slot = 0; slot < LV_PORT_SNAPSHOT_LAYER_NUM && snapshot_layers[slot]; slot++);
+                if (slot < LV_PORT_SNAPSHOT_LAYER_NUM) {
+                        break;
+                }
+                if (!lv_port_snapshot_evict(layer)) {
+                        return false;
+                }
+        }
+
+        /* Drop the least recently drawn snapshots until the new one fits */
+        while ((buf = lv_tlsf_malloc(snapshot_tlsf, size)) == NULL) {
+                if (!lv_port_snapshot_evict(layer)) {
+                        return false;
+                }
+        }
+
+        layer->buf = buf;
+        layer->buf_size = size;
+        snapshot_layers[slot] = layer;
+
+        return true;
+}
+
+static void lv_port_snapshot_release(snapshot_layer_t *layer)
+{
+        lv_obj_clear_flag(&layer->obj, LV_OBJ_FLAG_SNAPSHOT);
+
+        /* Blits already queued to the GPU may still read the snapshot */
+        lv_port_snapshot_gpu_wait();
+        lv_img_cache_invalidate_src(&layer->dsc);
+
+        for (int i = 0; i < LV_PORT_SNAPSHOT_LAYER_NUM; i++) {
+                if (snapshot_layers[i] == layer) {
+                        snapshot_layers[i] = NULL;
+                }
+        }
+
+        lv_tlsf_free(snapshot_tlsf, layer->buf);
+        layer->buf = NULL;
+        layer->buf_size = 0;
+}
+
+static bool lv_port_snapshot_evict(const snapshot_layer_t *keep)
+{
+        snapshot_layer_t *lru = NULL;
+
+        for (int i = 0; i < LV_PORT_SNAPSHOT_LAYER_NUM; i++) {
+                snapshot_layer_t *layer = snapshot_layers[i];
+
+                if (layer && layer != keep && (lru == NULL || layer->last_use < lru->last_use)) {
+                        lru = layer;
+                }
+        }
+
+        if (lru == NULL) {
+                return false;
+        }
+
+        /* The layer takes a new snapshot once it is shown again */
+        lv_port_snapshot_release(lru);
+        lv_port_snapshot_drop(lru);
+
+        return true;
+}
+
+static void lv_port_snapshot_gpu_wait(void)
+{
+        lv_disp_t *disp;
+
+        disp = _lv_refr_get_disp_refreshing();
+        if (disp == NULL) {
+                disp = lv_disp_get_default();
+        }
+        if (disp && disp->driver->gpu_wait_cb) {
+                disp->driver->gpu_wait_cb(disp->driver);
+        }
+}
+#endif /* LV_PORT_SNAPSHOT_EN */
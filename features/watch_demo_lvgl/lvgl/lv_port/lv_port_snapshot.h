@@ -0,0 +1,84 @@
+/**
+ ****************************************************************************************
+ *
+ * @file lv_port_snapshot.h
+ *
+ * @brief Layers of static objects drawn from a snapshot
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#ifndef LV_PORT_SNAPSHOT_H_
+#define LV_PORT_SNAPSHOT_H_
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+#include "gdi.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/* Bytes of the GDI GUI heap, placed after the image cache, used to keep the snapshots of layers. A layer of
+ * W x H pixels takes W * H * LV_COLOR_DEPTH / 8 bytes. The least recently drawn snapshots are dropped first.
+ * If 0, the children of layers are drawn every time */
+#ifndef LV_PORT_SNAPSHOT_SIZE
+#define LV_PORT_SNAPSHOT_SIZE                   (0)
+#endif
+
+/* Time (in msec) for which the children of a layer must stay unchanged before a new snapshot is taken */
+#ifndef LV_PORT_SNAPSHOT_DELAY_MS
+#define LV_PORT_SNAPSHOT_DELAY_MS               (500)
+#endif
+
+/* Maximum number of layers with a snapshot at the same time */
+#ifndef LV_PORT_SNAPSHOT_LAYER_NUM
+#define LV_PORT_SNAPSHOT_LAYER_NUM              (4)
+#endif
+
+#define LV_PORT_SNAPSHOT_EN                     (LV_PORT_SNAPSHOT_SIZE > 0 && DLG_LVGL_SNAPSHOT_LAYER && \
+                                                 LV_USE_SNAPSHOT)
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+/* Create a layer for static objects, by default as large as its parent. Once its children have not changed
+ * for LV_PORT_SNAPSHOT_DELAY_MS they are drawn from a snapshot, any change drops the snapshot. Only layers
+ * that fully cover their area with an opaque background get a snapshot */
+lv_obj_t *lv_port_snapshot_layer_create(lv_obj_t *parent);
+
+#if LV_PORT_SNAPSHOT_EN
+/* Reserve the snapshot memory in the GDI GUI heap, must be called after lv_init() */
+void lv_port_snapshot_init(void);
+
+/* Check whether a buffer is a snapshot, which stays valid while GPU operations are queued */
+bool lv_port_snapshot_is_buf(const void *buf);
+
+/* Drop every snapshot, layers take a new one once they are shown again */
+void lv_port_snapshot_flush(void);
+#endif /* LV_PORT_SNAPSHOT_EN */
+
+#endif /* LV_PORT_SNAPSHOT_H_ */
@@ -785,6 +785,15 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if DLG_LVGL_SNAPSHOT_LAYER
+    /*A changed child makes the snapshot of its parents outdated*/
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent) {
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_SNAPSHOT)) lv_event_send(parent, LV_EVENT_REFRESH, (void *)obj);
+        parent = lv_obj_get_parent(parent);
+    }
+#endif
+
     lv_area_t area_tmp;
     lv_area_copy(&area_tmp, area);
     bool visible = lv_obj_area_is_visible(obj, &area_tmp);
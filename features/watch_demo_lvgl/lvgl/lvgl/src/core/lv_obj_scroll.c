@@ -624,6 +624,10 @@ static void scroll_by_raw(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     lv_obj_move_children_by(obj, x, y, true);
     lv_res_t res = lv_event_send(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RES_OK) return;
+#if DLG_LVGL_SCROLL_CB
+    lv_disp_drv_t * driver = lv_obj_get_disp(obj)->driver;
+    if(driver->scroll_cb && driver->scroll_cb(driver, obj, x, y)) return;
+#endif
     lv_obj_invalidate(obj);
 }
 
@@ -148,9 +148,29 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     if(disp->inv_p < LV_INV_BUF_SIZE) {
         lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
     }
-    else {   /*If no place for the area add the screen*/
+    else {
+#if DLG_LVGL_INV_AREA_COST_JOIN
+        /*If no place for the area join it into the saved area which grows the least*/
+        uint16_t best = 0;
+        uint32_t best_growth = UINT32_MAX;
+        lv_area_t joined_area;
+        for(i = 0; i < disp->inv_p; i++) {
+            _lv_area_join(&joined_area, &disp->inv_areas[i], &com_area);
+            uint32_t growth = lv_area_get_size(&joined_area) - lv_area_get_size(&disp->inv_areas[i]);
+            if(growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        _lv_area_join(&disp->inv_areas[best], &disp->inv_areas[best], &com_area);
+        if(disp->driver->rounder_cb) disp->driver->rounder_cb(disp->driver, &disp->inv_areas[best]);
+        lv_timer_resume(disp->refr_timer);
+        return;
+#else
+        /*If no place for the area add the screen*/
         disp->inv_p = 0;
         lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+#endif
     }
     disp->inv_p++;
     lv_timer_resume(disp->refr_timer);
@@ -328,6 +348,57 @@ uint32_t lv_refr_get_fps_avg(void)
  *   STATIC FUNCTIONS
  **********************/
 
+#if DLG_LVGL_INV_AREA_COST_JOIN
+/**
+ * Join the areas by cost. Every area is flushed separately, so flushing two areas costs their
+ * sizes plus the `flush_overhead` of the driver. The pair with the largest saving is joined
+ * until joining does not pay off anymore.
+ * The saved areas are already rounded, so their bounding box is only rounded once it is chosen.
+ */
+static void lv_refr_join_area(void)
+{
+    int32_t overhead = (int32_t)disp_refr->driver->flush_overhead;
+    lv_area_t joined_area;
+
+    while(1) {
+        int32_t best_saving = 0;
+        uint32_t best_in = 0;
+        uint32_t best_from = 0;
+        uint32_t join_in;
+        uint32_t join_from;
+
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            if(disp_refr->inv_area_joined[join_in] != 0) continue;
+
+            int32_t size_in = (int32_t)lv_area_get_size(&disp_refr->inv_areas[join_in]);
+            for(join_from = join_in + 1; join_from < disp_refr->inv_p; join_from++) {
+                if(disp_refr->inv_area_joined[join_from] != 0) continue;
+
+                _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+
+                int32_t saving = size_in + (int32_t)lv_area_get_size(&disp_refr->inv_areas[join_from]) + overhead -
+                                 (int32_t)lv_area_get_size(&joined_area);
+                if(saving > best_saving) {
+                    best_saving = saving;
+                    best_in = join_in;
+                    best_from = join_from;
+                }
+            }
+        }
+
+        if(best_saving == 0) break;
+
+        _lv_area_join(&disp_refr->inv_areas[best_in], &disp_refr->inv_areas[best_in],
+                      &disp_refr->inv_areas[best_from]);
+        if(disp_refr->driver->rounder_cb) {
+            disp_refr->driver->rounder_cb(disp_refr->driver, &disp_refr->inv_areas[best_in]);
+        }
+
+        /*Mark 'join_form' is joined into 'join_in'*/
+        disp_refr->inv_area_joined[best_from] = 1;
+    }
+}
+#else
 /**
  * Join the areas which has got common parts
  */
@@ -364,6 +435,7 @@ static void lv_refr_join_area(void)
         }
     }
 }
+#endif /*DLG_LVGL_INV_AREA_COST_JOIN*/
 
 /**
  * Refresh the joined areas
@@ -711,6 +783,10 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
         /*Create a new 'obj_mask' without 'ext_size' because the children can't be visible there*/
         lv_obj_get_coords(obj, &obj_area);
         union_ok = _lv_area_intersect(&obj_mask, mask_ori_p, &obj_area);
+#if DLG_LVGL_SNAPSHOT_LAYER
+        /*The object has already drawn its children from its snapshot*/
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_SNAPSHOT)) union_ok = false;
+#endif
         if(union_ok != false) {
             lv_area_t mask_child; /*Mask from obj and its child*/
             lv_area_t child_area;
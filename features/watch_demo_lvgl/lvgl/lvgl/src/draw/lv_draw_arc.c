@@ -39,13 +39,13 @@ typedef struct {
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-#if LV_DRAW_COMPLEX
+#if LV_DRAW_COMPLEX && LV_USE_EXTERNAL_RENDERER == 0
     static void draw_quarter_0(quarter_draw_dsc_t * q);
     static void draw_quarter_1(quarter_draw_dsc_t * q);
     static void draw_quarter_2(quarter_draw_dsc_t * q);
     static void draw_quarter_3(quarter_draw_dsc_t * q);
     static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area);
-#endif /*LV_DRAW_COMPLEX*/
+#endif /*LV_DRAW_COMPLEX && LV_USE_EXTERNAL_RENDERER == 0*/
 
 /**********************
  *  STATIC VARIABLES
@@ -67,6 +67,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_arc_dsc_init(lv_draw_arc_dsc_t * dsc)
     dsc->color = lv_color_black();
 }
 
+#if LV_USE_EXTERNAL_RENDERER == 0
 void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uint16_t start_angle, uint16_t end_angle,
                  const lv_area_t * clip_area, const lv_draw_arc_dsc_t * dsc)
 {
@@ -217,6 +218,7 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uin
     LV_UNUSED(dsc);
 #endif /*LV_DRAW_COMPLEX*/
 }
+#endif
 
 void lv_draw_arc_get_area(lv_coord_t x, lv_coord_t y, uint16_t radius,  uint16_t start_angle, uint16_t end_angle,
                           lv_coord_t w, bool rounded, lv_area_t * area)
@@ -314,6 +316,7 @@ void lv_draw_arc_get_area(lv_coord_t x, lv_coord_t y, uint16_t radius,  uint16_t
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+#if LV_USE_EXTERNAL_RENDERER == 0
 
 #if LV_DRAW_COMPLEX
 static void draw_quarter_0(quarter_draw_dsc_t * q)
@@ -567,3 +570,4 @@ static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness
 }
 
 #endif /*LV_DRAW_COMPLEX*/
+#endif
@@ -105,7 +105,7 @@ uint8_t lv_img_cf_get_px_size(lv_img_cf_t cf)
     uint8_t px_size = 0;
 
 #if (DLG_LVGL_CF == 1)
-    switch(cf & ~LV_IMG_CF_RLE_FLAG) {
+    switch(cf & ~LV_IMG_CF_FLAGS) {
 #else
     switch(cf) {
 #endif /* (DLG_LVGL_CF == 1) */
@@ -172,7 +172,7 @@ bool lv_img_cf_use_gpu(lv_img_cf_t cf)
 #if LV_USE_EXTERNAL_RENDERER == 1
         bool use_gpu = false;
 
-        switch (cf & ~LV_IMG_CF_RLE_FLAG) {
+        switch (cf & ~LV_IMG_CF_FLAGS) {
         case LV_IMG_CF_TRUE_COLOR:
 #if LV_COLOR_DEPTH == 32
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
@@ -34,6 +34,7 @@
  *   GLOBAL FUNCTIONS
  **********************/
 
+#if LV_USE_EXTERNAL_RENDERER == 0
 /**
  * Draw a triangle
  * @param points pointer to an array with 3 points
@@ -210,6 +211,7 @@ void lv_draw_polygon(const lv_point_t points[], uint16_t point_cnt, const lv_are
     LV_LOG_WARN("Can't draw polygon with LV_DRAW_COMPLEX == 0");
 #endif /*LV_DRAW_COMPLEX*/
 }
+#endif
 
 /**********************
  *   STATIC FUNCTIONS
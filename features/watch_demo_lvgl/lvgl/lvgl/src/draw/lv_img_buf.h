@@ -124,8 +124,13 @@ enum {
 
 #if (DLG_LVGL_CF == 1)
     LV_IMG_CF_RLE_FLAG = (1 << 5),
+    LV_IMG_CF_NATIVE_ORDER_FLAG = (1 << 6), /**< Sub-byte pixels already stored in GPU bit order*/
 #endif
 };
+
+#if (DLG_LVGL_CF == 1)
+#define LV_IMG_CF_FLAGS         (LV_IMG_CF_RLE_FLAG | LV_IMG_CF_NATIVE_ORDER_FLAG)
+#endif
 typedef uint8_t lv_img_cf_t;
 
 
@@ -141,7 +146,7 @@ typedef struct {
     uint32_t h : 11; /*Height of the image map*/
     uint32_t w : 11; /*Width of the image map*/
 #if (DLG_LVGL_CF == 1)
-    uint32_t reserved : 1; /*Reserved to be used later*/
+    uint32_t native_order : 1; /*Sub-byte pixels stored in GPU bit order*/
     uint32_t rle : 1; /*RLE encoded image*/
 #else
     uint32_t reserved : 2; /*Reserved to be used later*/
@@ -160,7 +165,7 @@ typedef struct {
 
 #if (DLG_LVGL_CF == 1)
     uint32_t rle : 1; /*RLE encoded image*/
-    uint32_t reserved : 1; /*Reserved to be used later*/
+    uint32_t native_order : 1; /*Sub-byte pixels stored in GPU bit order*/
 #else
     uint32_t reserved : 2; /*Reserved to be used later*/
 #endif
@@ -289,6 +289,7 @@ lv_res_t lv_img_decoder_built_in_info(lv_img_decoder_t * decoder, const void * s
         header->cf = ((lv_img_dsc_t *)src)->header.cf;
 #if DLG_LVGL_CF == 1
         header->rle = ((lv_img_dsc_t *)src)->header.rle;
+        header->native_order = ((lv_img_dsc_t *)src)->header.native_order;
 #endif
     }
     else if(src_type == LV_IMG_SRC_FILE) {
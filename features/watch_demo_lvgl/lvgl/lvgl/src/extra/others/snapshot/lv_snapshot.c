@@ -46,6 +46,9 @@
 uint32_t lv_snapshot_buf_size_needed(lv_obj_t * obj, lv_img_cf_t cf)
 {
     switch(cf) {
+#if DLG_LVGL_SNAPSHOT_LAYER
+        case LV_IMG_CF_TRUE_COLOR:
+#endif
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
         case LV_IMG_CF_ALPHA_1BIT:
         case LV_IMG_CF_ALPHA_2BIT:
@@ -85,6 +88,9 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
     LV_ASSERT(buf);
 
     switch(cf) {
+#if DLG_LVGL_SNAPSHOT_LAYER
+        case LV_IMG_CF_TRUE_COLOR:
+#endif
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
         case LV_IMG_CF_ALPHA_1BIT:
         case LV_IMG_CF_ALPHA_2BIT:
@@ -125,6 +131,10 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
     driver.draw_buf = &draw_buf;
     driver.hor_res = w;
     driver.ver_res = h;
+#if DLG_LVGL_SNAPSHOT_LAYER
+    /*True color is the native format of the draw buffer, opaque objects are drawn without alpha*/
+    if(cf != LV_IMG_CF_TRUE_COLOR)
+#endif
     lv_disp_drv_use_generic_set_px_cb(&driver, cf);
 
     disp = lv_disp_drv_register(&driver);
@@ -146,6 +156,13 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
 
     disp->inv_p = 0;
 
+#if DLG_LVGL_SNAPSHOT_LAYER
+    /*The children are positioned in screen coordinates, move them together with obj*/
+    lv_coord_t dx = ext_size - obj->coords.x1;
+    lv_coord_t dy = ext_size - obj->coords.y1;
+    lv_obj_move_children_by(obj, dx, dy, false);
+#endif
+
     obj->coords.x2 = w - ext_size - 1;
     obj->coords.x1 = ext_size;
     obj->coords.y2 = h - ext_size - 1;
@@ -153,9 +170,18 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
 
     lv_obj_invalidate(obj);
 
+#if DLG_LVGL_SNAPSHOT_LAYER
+    /*The snapshot display must not stay the refreshing one after it is removed*/
+    lv_disp_t * disp_refr_old = _lv_refr_get_disp_refreshing();
+#endif
+
     /*Don't call lv_refr_now to avoid animation disruption */
     _lv_disp_refr_timer(disp->refr_timer);
 
+#if DLG_LVGL_SNAPSHOT_LAYER
+    _lv_refr_set_disp_refreshing(disp_refr_old);
+#endif
+
     /*Restore obj original parameters and clean up*/
     obj->parent = parent_old;
     screen->spec_attr->child_cnt = 0;
@@ -164,6 +190,9 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
     lv_disp_remove(disp);
 
     lv_area_copy(&obj->coords, &coords_bkp);
+#if DLG_LVGL_SNAPSHOT_LAYER
+    lv_obj_move_children_by(obj, -dx, -dy, false);
+#endif
 
     dsc->data = buf;
     dsc->header.w = lv_area_get_width(&draw_buf.area);
@@ -302,6 +302,7 @@ static void refr_img(lv_obj_t * obj)
         imgbtn->act_cf = header.cf;
 #if DLG_LVGL_CF == 1
         imgbtn->act_cf |= header.rle ? LV_IMG_CF_RLE_FLAG : 0;
+        imgbtn->act_cf |= header.native_order ? LV_IMG_CF_NATIVE_ORDER_FLAG : 0;
 #endif
         lv_obj_refresh_self_size(obj);
         lv_obj_set_height(obj, header.h); /*Keep the user defined width*/
@@ -141,8 +141,6 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
     const lv_area_t * disp_area = &draw_buf->area;
     lv_color_t * disp_buf = draw_buf->buf_act;
 
-    if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
-
     /*Get clipped fill area which is the real draw area.
      *It is always the same or inside `fill_area`*/
     lv_area_t draw_area;
@@ -152,6 +150,10 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
      *Make it relative to `disp_area` to simplify the drawing to `disp_buf`*/
     lv_area_move(&draw_area, -disp_area->x1, -disp_area->y1);
 
+    /*Wait only if the GPU is still drawing where this fill goes*/
+    if(disp->driver->gpu_wait_area_cb) disp->driver->gpu_wait_area_cb(disp->driver, disp_buf, &draw_area);
+    else if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
+
     /*Round the values in the mask if anti-aliasing is disabled*/
     if(mask && disp->driver->antialiasing == 0) {
         int32_t mask_w = lv_area_get_width(&draw_area);
@@ -210,8 +212,6 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
     const lv_area_t * disp_area = &draw_buf->area;
     lv_color_t * disp_buf = draw_buf->buf_act;
 
-    if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
-
     /*Now `draw_area` has absolute coordinates.
      *Make it relative to `disp_area` to simplify draw to `disp_buf`*/
     draw_area.x1 -= disp_area->x1;
@@ -219,6 +219,10 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
     draw_area.x2 -= disp_area->x1;
     draw_area.y2 -= disp_area->y1;
 
+    /*Wait only if the GPU is still drawing where this map goes*/
+    if(disp->driver->gpu_wait_area_cb) disp->driver->gpu_wait_area_cb(disp->driver, disp_buf, &draw_area);
+    else if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
+
     /*Round the values in the mask if anti-aliasing is disabled*/
     if(mask && disp->driver->antialiasing == 0) {
         int32_t mask_w = lv_area_get_width(&draw_area);
@@ -340,7 +344,8 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
             dsc.recolor = color;
 
             if (disp->driver->gpu_config_blit_cb(disp->driver, &dsc, LV_IMG_CF_TRUE_COLOR, LV_IMG_CF_ALPHA_8BIT, true, false, true, true)) {
-                if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
+                if(disp->driver->gpu_wait_area_cb) disp->driver->gpu_wait_area_cb(disp->driver, disp_buf, draw_area);
+                else if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
                 disp->driver->gpu_blit_cb(disp->driver, disp_buf, draw_area, disp_w, (lv_color_t *)mask, draw_area, opa);
                 return;
             }
@@ -136,7 +136,8 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
 
         lv_draw_map(coords, &mask_com, cdsc->dec_dsc.img_data, draw_dsc,
 #if (DLG_LVGL_CF == 1)
-                cdsc->dec_dsc.header.cf | (cdsc->dec_dsc.header.rle ? LV_IMG_CF_RLE_FLAG : 0),
+                cdsc->dec_dsc.header.cf | (cdsc->dec_dsc.header.rle ? LV_IMG_CF_RLE_FLAG : 0) |
+                (cdsc->dec_dsc.header.native_order ? LV_IMG_CF_NATIVE_ORDER_FLAG : 0),
 #endif /* DLG_LVGL_CF */
                 chroma_keyed, alpha_byte);
     }
@@ -179,7 +180,8 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
 
             lv_draw_map(&line, &mask_line, buf, draw_dsc,
 #if (DLG_LVGL_CF == 1)
-                cdsc->dec_dsc.header.cf | (cdsc->dec_dsc.header.rle ? LV_IMG_CF_RLE_FLAG : 0),
+                cdsc->dec_dsc.header.cf | (cdsc->dec_dsc.header.rle ? LV_IMG_CF_RLE_FLAG : 0) |
+                (cdsc->dec_dsc.header.native_order ? LV_IMG_CF_NATIVE_ORDER_FLAG : 0),
 #endif /* DLG_LVGL_CF */
                 chroma_keyed, alpha_byte);
             line.y1++;
@@ -241,7 +243,8 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
             lv_area_copy(&map_area_tmp, map_area);
             lv_area_move(&map_area_tmp, -disp_area->x1, -disp_area->y1);
 
-            if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
+            if(disp->driver->gpu_wait_area_cb) disp->driver->gpu_wait_area_cb(disp->driver, disp_buf, &draw_area);
+            else if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
 
             disp->driver->gpu_blit_cb(disp->driver, disp_buf, &draw_area, lv_area_get_width(disp_area),
                                       (lv_color_t *)map_p, &map_area_tmp, draw_dsc->opa);
@@ -261,7 +264,7 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
 
 
             /* Size calculation */
-            lv_img_cf_t bmp_cf = cf;
+            lv_img_cf_t bmp_cf = cf & ~LV_IMG_CF_NATIVE_ORDER_FLAG;
             bool rle_img = !!(bmp_cf & LV_IMG_CF_RLE_FLAG);
             bool idx_img = ((bmp_cf == LV_IMG_CF_INDEXED_1BIT) ||
                             (bmp_cf == LV_IMG_CF_INDEXED_2BIT) ||
@@ -43,6 +43,9 @@ typedef uint8_t cmd_state_t;
 LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
                                                      const lv_area_t * clip_area,
                                                      const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+static bool draw_letter_gpu(lv_coord_t pos_x, lv_coord_t pos_y, const lv_font_t * font_p, uint32_t letter,
+                            lv_font_glyph_dsc_t * g, const lv_area_t * clip_area, const uint8_t * map_p, lv_color_t color,
+                            lv_opa_t opa, lv_blend_mode_t blend_mode);
 
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
 static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g, const lv_area_t * clip_area,
@@ -137,11 +140,51 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_letter(const lv_point_t * pos_p, const lv_are
         LV_LOG_WARN("Can't draw sub-pixel rendered letter because LV_USE_FONT_SUBPX == 0 in lv_conf.h");
 #endif
     }
-    else {
+    else if(!draw_letter_gpu(pos_x, pos_y, font_p, letter, &g, clip_area, map_p, color, opa, blend_mode)) {
         draw_letter_normal(pos_x, pos_y, &g, clip_area, map_p, color, opa, blend_mode);
     }
 }
 
+/**
+ * Let the GPU draw a letter, e.g. out of a glyph cache
+ * @return true: the letter is drawn, false: it has to be drawn by the CPU
+ */
+static bool draw_letter_gpu(lv_coord_t pos_x, lv_coord_t pos_y, const lv_font_t * font_p, uint32_t letter,
+                            lv_font_glyph_dsc_t * g, const lv_area_t * clip_area, const uint8_t * map_p, lv_color_t color,
+                            lv_opa_t opa, lv_blend_mode_t blend_mode)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
+    const lv_area_t * disp_area = &draw_buf->area;
+
+    if(disp->driver->gpu_draw_letter_cb == NULL || disp->driver->set_px_cb) return false;
+
+    lv_area_t letter_area;
+    letter_area.x1 = pos_x;
+    letter_area.y1 = pos_y;
+    letter_area.x2 = pos_x + g->box_w - 1;
+    letter_area.y2 = pos_y + g->box_h - 1;
+
+    lv_area_t draw_area;
+    if(!_lv_area_intersect(&draw_area, &letter_area, clip_area)) return true;
+
+#if LV_DRAW_COMPLEX
+    /*Masks are applied by the CPU*/
+    if(lv_draw_mask_is_any(&draw_area)) return false;
+#endif
+
+    /*Make the areas relative to `disp_area`*/
+    lv_area_move(&letter_area, -disp_area->x1, -disp_area->y1);
+    lv_area_move(&draw_area, -disp_area->x1, -disp_area->y1);
+
+    lv_color_t * disp_buf = draw_buf->buf_act;
+    if(disp->driver->gpu_wait_area_cb) disp->driver->gpu_wait_area_cb(disp->driver, disp_buf, &draw_area);
+    else if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
+
+    return disp->driver->gpu_draw_letter_cb(disp->driver, disp_buf, &draw_area, lv_area_get_width(disp_area), font_p,
+                                            letter, g, map_p, &letter_area, color, opa, blend_mode);
+}
+
 LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
                                                      const lv_area_t * clip_area,
                                                      const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
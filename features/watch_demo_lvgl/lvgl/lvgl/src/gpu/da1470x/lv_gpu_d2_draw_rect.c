@@ -50,6 +50,8 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
 LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords,  uint16_t * sh_buf, lv_coord_t s,
                                                          lv_coord_t r);
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+static bool draw_shadow_gpu(const lv_area_t * clip, const lv_area_t * shadow_area, const lv_area_t * bg_area,
+                            lv_coord_t r_bg, lv_coord_t r, const lv_opa_t * corner, const lv_draw_rect_dsc_t * dsc);
 #endif
 
 void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_area, const lv_area_t * inner_area,
@@ -58,6 +60,11 @@ void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_ar
 static void draw_border_simple(const lv_area_t * clip, const lv_area_t * outer_area, const lv_area_t * inner_area,
                                lv_color_t color, lv_opa_t opa);
 
+static bool draw_rect_gpu(const lv_area_t * clip_area, const lv_area_t * outer_area, lv_coord_t rout,
+                          const lv_area_t * inner_area, lv_coord_t rin, lv_color_t color, lv_color_t grad_color,
+                          lv_grad_dir_t grad_dir, uint8_t main_stop, uint8_t grad_stop, lv_opa_t opa,
+                          lv_blend_mode_t blend_mode);
+
 #if LV_DRAW_COMPLEX
     LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t * dsc, lv_coord_t s, lv_coord_t i);
 #endif
@@ -87,6 +94,7 @@ LV_ATTRIBUTE_FAST_MEM lv_img_cf_t _get_cf(const lv_draw_rect_dsc_t * dsc)
             lv_img_dsc_t* lv_img_dsc = (lv_img_dsc_t*) dsc->bg_img_src;
             lv_img_cf_t cf = lv_img_dsc->header.cf;
             cf |= lv_img_dsc->header.rle ? LV_IMG_CF_RLE_FLAG : 0;
+            cf |= lv_img_dsc->header.native_order ? LV_IMG_CF_NATIVE_ORDER_FLAG : 0;
             return cf;
     }
     return LV_IMG_CF_UNKNOWN;
@@ -164,6 +172,12 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
     int32_t short_side = LV_MIN(coords_w, coords_h);
     int32_t rout = LV_MIN(dsc->radius, short_side >> 1);
 
+    /*Without other masks the GPU can draw the rounded corners and the gradient*/
+    if(!mask_any && draw_rect_gpu(clip_area, &coords_bg, rout, NULL, 0, dsc->bg_color, dsc->bg_grad_color, grad_dir,
+                                  dsc->bg_main_color_stop, dsc->bg_grad_color_stop, opa, dsc->blend_mode)) {
+        return;
+    }
+
     /*Add a radius mask if there is radius*/
     int32_t draw_area_w = lv_area_get_width(&draw_area);
     int16_t mask_rout_id = LV_MASK_ID_INV;
@@ -494,6 +508,12 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
     /*Get how many pixels are affected by the blur on the corners*/
     int32_t corner_size = dsc->shadow_width  + r_sh;
 
+    /*The GPU can't mask the shadow under the background, it has to be covered by an opaque one.
+     *The corner is cached by shadow width and radius, which is only enough if the core is not smaller than it*/
+    bool gpu_en = dsc->bg_opa >= LV_OPA_COVER && lv_area_get_width(&core_area) >= corner_size &&
+                  lv_area_get_height(&core_area) >= corner_size;
+    if(gpu_en && draw_shadow_gpu(clip, &shadow_area, &bg_area, r_bg, r_sh, NULL, dsc)) return;
+
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
@@ -519,6 +539,12 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
     shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
 #endif
 
+    /*Give the new corner to the GPU which can keep it for the next shadows of the same size*/
+    if(gpu_en && draw_shadow_gpu(clip, &shadow_area, &bg_area, r_bg, r_sh, sh_buf, dsc)) {
+        lv_mem_buf_release(sh_buf);
+        return;
+    }
+
     /*Skip a lot of masking if the background will cover the shadow that would be masked out*/
     bool mask_any = lv_draw_mask_is_any(&shadow_area);
     bool simple = true;
@@ -1106,6 +1132,11 @@ void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_ar
         return;
     }
 
+    if(draw_rect_gpu(clip_area, outer_area, rout, inner_area, rin, color, color, LV_GRAD_DIR_NONE, 0, 0, opa,
+                     blend_mode)) {
+        return;
+    }
+
 #if LV_DRAW_COMPLEX
     /*Get clipped draw area which is the real draw area.
      *It is always the same or inside `coords`*/
@@ -1356,4 +1387,91 @@ static void draw_border_simple(const lv_area_t * clip, const lv_area_t * outer_a
 
 }
 
+/**
+ * Let the GPU draw a rectangle with rounded corners, or the frame around `inner_area` if it is set
+ * @return true: the rectangle is drawn, false: it has to be drawn by the CPU
+ */
+static bool draw_rect_gpu(const lv_area_t * clip_area, const lv_area_t * outer_area, lv_coord_t rout,
+                          const lv_area_t * inner_area, lv_coord_t rin, lv_color_t color, lv_color_t grad_color,
+                          lv_grad_dir_t grad_dir, uint8_t main_stop, uint8_t grad_stop, lv_opa_t opa,
+                          lv_blend_mode_t blend_mode)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
+    const lv_area_t * disp_area = &draw_buf->area;
+
+    if(disp->driver->gpu_draw_rect_cb == NULL || disp->driver->set_px_cb) return false;
+
+    lv_area_t draw_area;
+    if(!_lv_area_intersect(&draw_area, outer_area, clip_area)) return true;
+
+#if LV_DRAW_COMPLEX
+    /*Masks are applied by the CPU*/
+    if(lv_draw_mask_is_any(&draw_area)) return false;
+#endif
+
+    /*Make the areas relative to `disp_area`*/
+    lv_area_t outer_area_tmp;
+    lv_area_copy(&outer_area_tmp, outer_area);
+    lv_area_move(&outer_area_tmp, -disp_area->x1, -disp_area->y1);
+    lv_area_move(&draw_area, -disp_area->x1, -disp_area->y1);
+
+    lv_area_t inner_area_tmp;
+    if(inner_area) {
+        lv_area_copy(&inner_area_tmp, inner_area);
+        lv_area_move(&inner_area_tmp, -disp_area->x1, -disp_area->y1);
+    }
+
+    lv_color_t * disp_buf = draw_buf->buf_act;
+    if(disp->driver->gpu_wait_area_cb) disp->driver->gpu_wait_area_cb(disp->driver, disp_buf, &draw_area);
+    else if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
+
+    return disp->driver->gpu_draw_rect_cb(disp->driver, disp_buf, &draw_area, lv_area_get_width(disp_area),
+                                          &outer_area_tmp, rout, inner_area ? &inner_area_tmp : NULL, rin,
+                                          color, grad_color, grad_dir, main_stop, grad_stop, opa, blend_mode);
+}
+
+#if LV_DRAW_COMPLEX
+/**
+ * Let the GPU draw a shadow out of its blurred corner, parts inside `bg_area` may be skipped
+ * @param corner the blurred corner or NULL to use only a corner cached by the GPU driver
+ * @return true: the shadow is drawn, false: it has to be drawn by the CPU
+ */
+static bool draw_shadow_gpu(const lv_area_t * clip, const lv_area_t * shadow_area, const lv_area_t * bg_area,
+                            lv_coord_t r_bg, lv_coord_t r, const lv_opa_t * corner, const lv_draw_rect_dsc_t * dsc)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
+    const lv_area_t * disp_area = &draw_buf->area;
+
+    if(disp->driver->gpu_draw_shadow_cb == NULL || disp->driver->set_px_cb) return false;
+
+    lv_area_t draw_area;
+    if(!_lv_area_intersect(&draw_area, shadow_area, clip)) return true;
+
+    /*Masks are applied by the CPU*/
+    if(lv_draw_mask_is_any(shadow_area)) return false;
+
+    /*Make the areas relative to `disp_area`*/
+    lv_area_t shadow_area_tmp;
+    lv_area_copy(&shadow_area_tmp, shadow_area);
+    lv_area_move(&shadow_area_tmp, -disp_area->x1, -disp_area->y1);
+    lv_area_t bg_area_tmp;
+    lv_area_copy(&bg_area_tmp, bg_area);
+    lv_area_move(&bg_area_tmp, -disp_area->x1, -disp_area->y1);
+    lv_area_move(&draw_area, -disp_area->x1, -disp_area->y1);
+
+    lv_color_t * disp_buf = draw_buf->buf_act;
+    if(disp->driver->gpu_wait_area_cb) disp->driver->gpu_wait_area_cb(disp->driver, disp_buf, &draw_area);
+    else if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
+
+    lv_opa_t opa = dsc->shadow_opa;
+    if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
+
+    return disp->driver->gpu_draw_shadow_cb(disp->driver, disp_buf, &draw_area, lv_area_get_width(disp_area),
+                                            &shadow_area_tmp, &bg_area_tmp, r_bg, dsc->shadow_width, r, corner,
+                                            dsc->shadow_color, opa, dsc->blend_mode);
+}
+#endif /*LV_DRAW_COMPLEX*/
+
 #endif /* DLG_LVGL_USE_GPU_DA1470X */
@@ -25,6 +25,9 @@ extern "C" {
 #include "../misc/lv_ll.h"
 #include "../misc/lv_timer.h"
 #include "../draw/lv_draw_img.h"
+#if DLG_LVGL_USE_GPU_DA1470X
+#include "../font/lv_font.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -100,6 +103,12 @@ typedef struct _lv_disp_drv_t {
 
     uint32_t dpi : 10;              /** DPI (dot per inch) of the display. Default value is `LV_DPI_DEF`.*/
 
+#if DLG_LVGL_INV_AREA_COST_JOIN
+    /** Fixed cost of flushing one more area, in pixels. Used to decide whether invalidated areas
+     * are joined (0: join only if the joined area is smaller than the two areas)*/
+    uint32_t flush_overhead;
+#endif
+
     /** MANDATORY: Write the internal buffer (draw_buf) to the display. 'lv_disp_flush_ready()' has to be
      * called when finished*/
     void (*flush_cb)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
@@ -123,12 +132,24 @@ typedef struct _lv_disp_drv_t {
      * User can execute very simple tasks here or yield the task*/
     void (*wait_cb)(struct _lv_disp_drv_t * disp_drv);
 
+#if DLG_LVGL_SCROLL_CB
+    /** OPTIONAL: Called when `obj` has been scrolled by `x`, `y` and its children were moved.
+     * Return true if the driver invalidated what is needed, false to invalidate the whole object*/
+    bool (*scroll_cb)(struct _lv_disp_drv_t * disp_drv, struct _lv_obj_t * obj, lv_coord_t x, lv_coord_t y);
+#endif
+
     /** OPTIONAL: Called when lvgl needs any CPU cache that affects rendering to be cleaned*/
     void (*clean_dcache_cb)(struct _lv_disp_drv_t * disp_drv);
 
     /** OPTIONAL: called to wait while the gpu is working*/
     void (*gpu_wait_cb)(struct _lv_disp_drv_t * disp_drv);
 
+#if DLG_LVGL_USE_GPU_DA1470X
+    /** OPTIONAL: called to wait while the gpu is working on `area` of `dest_buf`.
+     * Used instead of `gpu_wait_cb` before drawing to a buffer if set*/
+    void (*gpu_wait_area_cb)(struct _lv_disp_drv_t * disp_drv, const lv_color_t * dest_buf, const lv_area_t * area);
+#endif
+
     /** OPTIONAL: called when driver parameters are updated */
     void (*drv_update_cb)(struct _lv_disp_drv_t * disp_drv);
 
@@ -151,6 +172,52 @@ typedef struct _lv_disp_drv_t {
     /** OPTIONAL: Configure BLIT operation (GPU only)*/
     bool (*gpu_config_blit_cb)(struct _lv_disp_drv_t * disp_drv, const lv_draw_img_dsc_t * draw_dsc, lv_img_cf_t dst_cf,
                                lv_img_cf_t src_cf, bool alpha_en, bool color_key_en, bool blend_en, bool colorize_en);
+
+    /** OPTIONAL: Draw the `dest_area` part of a letter whose glyph lies at `letter_area`, both relative to
+     * `dest_buf` (GPU only). Return false to draw the letter with the CPU*/
+    bool (*gpu_draw_letter_cb)(struct _lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, const lv_area_t * dest_area,
+                               lv_coord_t dest_pitch, const lv_font_t * font, uint32_t letter, const lv_font_glyph_dsc_t * g,
+                               const uint8_t * map_p, const lv_area_t * letter_area, lv_color_t color, lv_opa_t opa,
+                               lv_blend_mode_t blend_mode);
+
+    /** OPTIONAL: Draw the `dest_area` part of a rectangle with `rout` corner radius, all areas relative to
+     * `dest_buf` (GPU only). If `inner_area` is set only the frame around it with `rin` corner radius is drawn.
+     * A gradient goes from `color` to `grad_color` between the `main_stop` and `grad_stop` (0..255) of `outer_area`.
+     * Return false to draw the rectangle with the CPU*/
+    bool (*gpu_draw_rect_cb)(struct _lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, const lv_area_t * dest_area,
+                             lv_coord_t dest_pitch, const lv_area_t * outer_area, lv_coord_t rout,
+                             const lv_area_t * inner_area, lv_coord_t rin, lv_color_t color, lv_color_t grad_color,
+                             lv_grad_dir_t grad_dir, uint8_t main_stop, uint8_t grad_stop, lv_opa_t opa,
+                             lv_blend_mode_t blend_mode);
+
+    /** OPTIONAL: Draw the `dest_area` part of an arc around `center` with the outer `radius` from `start_angle`
+     * to `end_angle` (degrees, clockwise), coordinates relative to `dest_buf` (GPU only).
+     * Return false to draw the arc with the CPU*/
+    bool (*gpu_draw_arc_cb)(struct _lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, const lv_area_t * dest_area,
+                            lv_coord_t dest_pitch, const lv_point_t * center, uint16_t radius, uint16_t start_angle,
+                            uint16_t end_angle, lv_coord_t width, bool rounded, lv_color_t color, lv_opa_t opa,
+                            lv_blend_mode_t blend_mode);
+
+    /** OPTIONAL: Draw the `dest_area` part of a line with flat ends, coordinates relative to `dest_buf` (GPU only).
+     * Return false to draw the line with the CPU*/
+    bool (*gpu_draw_line_cb)(struct _lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, const lv_area_t * dest_area,
+                             lv_coord_t dest_pitch, const lv_point_t * point1, const lv_point_t * point2,
+                             lv_coord_t width, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+
+    /** OPTIONAL: Fill the `dest_area` part of a polygon, coordinates relative to `dest_buf` (GPU only).
+     * Return false to draw the polygon with the CPU*/
+    bool (*gpu_draw_polygon_cb)(struct _lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                lv_coord_t dest_pitch, const lv_point_t * points, uint16_t point_cnt,
+                                lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+
+    /** OPTIONAL: Draw the `dest_area` part of a shadow out of its blurred top right `corner` ((sw + r)^2 A8 pixels),
+     * skipping the parts inside `bg_area` with `r_bg` radius, all areas relative to `dest_buf` (GPU only).
+     * If `corner` is NULL only a corner cached by the driver can be used.
+     * Return false to draw the shadow with the CPU*/
+    bool (*gpu_draw_shadow_cb)(struct _lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, const lv_area_t * dest_area,
+                               lv_coord_t dest_pitch, const lv_area_t * shadow_area, const lv_area_t * bg_area,
+                               lv_coord_t r_bg, lv_coord_t sw, lv_coord_t r, const lv_opa_t * corner,
+                               lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
 #endif
     /** On CHROMA_KEYED images this color will be transparent.
      * `LV_COLOR_CHROMA_KEY` by default. (lv_conf.h)*/
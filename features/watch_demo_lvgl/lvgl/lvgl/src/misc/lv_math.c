@@ -33,6 +33,69 @@ static const int16_t sin0_90_table[] = {
     32269, 32364, 32448, 32523, 32587, 32642, 32687, 32722, 32747, 32762, 32767
 };
 
+#if DLG_LVGL_USE_GPU_DA1470X
+/*sin(0..90) in 0.1 degree steps*/
+static const int16_t sin0_90_fine_table[] = {
+    0,     57,    114,   172,   229,   286,   343,   400,   457,   515,   572,   629,   686,   743,   801,   858,
+    915,   972,   1029,  1086,  1144,  1201,  1258,  1315,  1372,  1429,  1486,  1544,  1601,  1658,  1715,  1772,
+    1829,  1886,  1943,  2000,  2057,  2115,  2172,  2229,  2286,  2343,  2400,  2457,  2514,  2571,  2628,  2685,
+    2742,  2799,  2856,  2913,  2970,  3027,  3084,  3141,  3197,  3254,  3311,  3368,  3425,  3482,  3539,  3596,
+    3653,  3709,  3766,  3823,  3880,  3937,  3993,  4050,  4107,  4164,  4220,  4277,  4334,  4390,  4447,  4504,
+    4560,  4617,  4674,  4730,  4787,  4843,  4900,  4956,  5013,  5069,  5126,  5182,  5239,  5295,  5352,  5408,
+    5465,  5521,  5577,  5634,  5690,  5746,  5803,  5859,  5915,  5971,  6028,  6084,  6140,  6196,  6252,  6308,
+    6364,  6421,  6477,  6533,  6589,  6645,  6701,  6757,  6813,  6869,  6924,  6980,  7036,  7092,  7148,  7204,
+    7259,  7315,  7371,  7427,  7482,  7538,  7594,  7649,  7705,  7760,  7816,  7872,  7927,  7983,  8038,  8093,
+    8149,  8204,  8260,  8315,  8370,  8425,  8481,  8536,  8591,  8646,  8701,  8757,  8812,  8867,  8922,  8977,
+    9032,  9087,  9142,  9197,  9251,  9306,  9361,  9416,  9471,  9525,  9580,  9635,  9689,  9744,  9799,  9853,
+    9908,  9962,  10017, 10071, 10126, 10180, 10234, 10289, 10343, 10397, 10451, 10506, 10560, 10614, 10668, 10722,
+    10776, 10830, 10884, 10938, 10992, 11046, 11099, 11153, 11207, 11261, 11314, 11368, 11422, 11475, 11529, 11582,
+    11636, 11689, 11743, 11796, 11849, 11903, 11956, 12009, 12062, 12115, 12169, 12222, 12275, 12328, 12381, 12434,
+    12487, 12539, 12592, 12645, 12698, 12750, 12803, 12856, 12908, 12961, 13013, 13066, 13118, 13171, 13223, 13275,
+    13328, 13380, 13432, 13484, 13536, 13588, 13640, 13692, 13744, 13796, 13848, 13900, 13952, 14003, 14055, 14107,
+    14158, 14210, 14261, 14313, 14364, 14415, 14467, 14518, 14569, 14621, 14672, 14723, 14774, 14825, 14876, 14927,
+    14978, 15029, 15079, 15130, 15181, 15231, 15282, 15333, 15383, 15434, 15484, 15534, 15585, 15635, 15685, 15735,
+    15786, 15836, 15886, 15936, 15986, 16036, 16085, 16135, 16185, 16235, 16284, 16334, 16383, 16433, 16482, 16532,
+    16581, 16631, 16680, 16729, 16778, 16827, 16876, 16925, 16974, 17023, 17072, 17121, 17169, 17218, 17267, 17315,
+    17364, 17412, 17461, 17509, 17557, 17606, 17654, 17702, 17750, 17798, 17846, 17894, 17942, 17990, 18038, 18085,
+    18133, 18181, 18228, 18276, 18323, 18370, 18418, 18465, 18512, 18559, 18607, 18654, 18701, 18748, 18794, 18841,
+    18888, 18935, 18981, 19028, 19074, 19121, 19167, 19214, 19260, 19306, 19352, 19398, 19445, 19491, 19537, 19582,
+    19628, 19674, 19720, 19765, 19811, 19856, 19902, 19947, 19993, 20038, 20083, 20128, 20173, 20218, 20263, 20308,
+    20353, 20398, 20443, 20487, 20532, 20576, 20621, 20665, 20710, 20754, 20798, 20842, 20886, 20931, 20974, 21018,
+    21062, 21106, 21150, 21193, 21237, 21280, 21324, 21367, 21411, 21454, 21497, 21540, 21583, 21626, 21669, 21712,
+    21755, 21798, 21840, 21883, 21925, 21968, 22010, 22053, 22095, 22137, 22179, 22221, 22263, 22305, 22347, 22389,
+    22431, 22472, 22514, 22555, 22597, 22638, 22679, 22721, 22762, 22803, 22844, 22885, 22926, 22967, 23007, 23048,
+    23089, 23129, 23170, 23210, 23251, 23291, 23331, 23371, 23411, 23451, 23491, 23531, 23571, 23610, 23650, 23689,
+    23729, 23768, 23808, 23847, 23886, 23925, 23964, 24003, 24042, 24081, 24120, 24158, 24197, 24235, 24274, 24312,
+    24351, 24389, 24427, 24465, 24503, 24541, 24579, 24617, 24654, 24692, 24730, 24767, 24804, 24842, 24879, 24916,
+    24953, 24990, 25027, 25064, 25101, 25138, 25174, 25211, 25247, 25284, 25320, 25356, 25393, 25429, 25465, 25501,
+    25537, 25572, 25608, 25644, 25679, 25715, 25750, 25785, 25821, 25856, 25891, 25926, 25961, 25996, 26031, 26065,
+    26100, 26134, 26169, 26203, 26238, 26272, 26306, 26340, 26374, 26408, 26442, 26475, 26509, 26543, 26576, 26610,
+    26643, 26676, 26709, 26742, 26775, 26808, 26841, 26874, 26907, 26939, 26972, 27004, 27036, 27069, 27101, 27133,
+    27165, 27197, 27229, 27261, 27292, 27324, 27355, 27387, 27418, 27450, 27481, 27512, 27543, 27574, 27605, 27635,
+    27666, 27697, 27727, 27758, 27788, 27818, 27848, 27879, 27909, 27938, 27968, 27998, 28028, 28057, 28087, 28116,
+    28146, 28175, 28204, 28233, 28262, 28291, 28320, 28348, 28377, 28406, 28434, 28462, 28491, 28519, 28547, 28575,
+    28603, 28631, 28659, 28686, 28714, 28741, 28769, 28796, 28823, 28851, 28878, 28905, 28932, 28958, 28985, 29012,
+    29038, 29065, 29091, 29117, 29144, 29170, 29196, 29222, 29247, 29273, 29299, 29324, 29350, 29375, 29400, 29426,
+    29451, 29476, 29501, 29526, 29550, 29575, 29600, 29624, 29648, 29673, 29697, 29721, 29745, 29769, 29793, 29817,
+    29840, 29864, 29887, 29911, 29934, 29957, 29980, 30004, 30026, 30049, 30072, 30095, 30117, 30140, 30162, 30184,
+    30207, 30229, 30251, 30273, 30295, 30316, 30338, 30360, 30381, 30402, 30424, 30445, 30466, 30487, 30508, 30529,
+    30549, 30570, 30591, 30611, 30631, 30652, 30672, 30692, 30712, 30732, 30752, 30771, 30791, 30810, 30830, 30849,
+    30868, 30888, 30907, 30926, 30944, 30963, 30982, 31000, 31019, 31037, 31056, 31074, 31092, 31110, 31128, 31146,
+    31163, 31181, 31198, 31216, 31233, 31250, 31268, 31285, 31302, 31318, 31335, 31352, 31368, 31385, 31401, 31418,
+    31434, 31450, 31466, 31482, 31498, 31513, 31529, 31545, 31560, 31575, 31591, 31606, 31621, 31636, 31650, 31665,
+    31680, 31694, 31709, 31723, 31738, 31752, 31766, 31780, 31794, 31807, 31821, 31835, 31848, 31862, 31875, 31888,
+    31901, 31914, 31927, 31940, 31953, 31965, 31978, 31990, 32003, 32015, 32027, 32039, 32051, 32063, 32075, 32086,
+    32098, 32109, 32121, 32132, 32143, 32154, 32165, 32176, 32187, 32197, 32208, 32218, 32229, 32239, 32249, 32259,
+    32269, 32279, 32289, 32299, 32308, 32318, 32327, 32336, 32345, 32355, 32364, 32372, 32381, 32390, 32399, 32407,
+    32415, 32424, 32432, 32440, 32448, 32456, 32464, 32472, 32479, 32487, 32494, 32501, 32509, 32516, 32523, 32530,
+    32537, 32543, 32550, 32556, 32563, 32569, 32575, 32581, 32587, 32593, 32599, 32605, 32611, 32616, 32622, 32627,
+    32632, 32637, 32642, 32647, 32652, 32657, 32661, 32666, 32670, 32675, 32679, 32683, 32687, 32691, 32695, 32699,
+    32702, 32706, 32709, 32713, 32716, 32719, 32722, 32725, 32728, 32731, 32733, 32736, 32738, 32741, 32743, 32745,
+    32747, 32749, 32751, 32753, 32754, 32756, 32757, 32759, 32760, 32761, 32762, 32763, 32764, 32765, 32765, 32766,
+    32766, 32767, 32767, 32767, 32767
+};
+#endif /* DLG_LVGL_USE_GPU_DA1470X */
+
 /**********************
  *      MACROS
  **********************/
@@ -72,6 +135,25 @@ LV_ATTRIBUTE_FAST_MEM int16_t lv_trigo_sin(int16_t angle)
     return ret;
 }
 
+#if DLG_LVGL_USE_GPU_DA1470X
+/**
+ * Return with sinus of an angle given in 0.1 degree units, the resolution of image rotation
+ * @param angle angle in 0.1 degree units
+ * @return sinus of 'angle'. sin(-900) = -32767, sin(900) = 32767
+ */
+LV_ATTRIBUTE_FAST_MEM int16_t lv_trigo_sin_fine(int16_t angle)
+{
+    angle = angle % 3600;
+
+    if(angle < 0) angle = 3600 + angle;
+
+    if(angle < 900) return sin0_90_fine_table[angle];
+    else if(angle < 1800) return sin0_90_fine_table[1800 - angle];
+    else if(angle < 2700) return -sin0_90_fine_table[angle - 1800];
+    else return -sin0_90_fine_table[3600 - angle];
+}
+#endif /* DLG_LVGL_USE_GPU_DA1470X */
+
 /**
  * Calculate a value of a Cubic Bezier function.
  * @param t time in range of [0..LV_BEZIER_VAL_MAX]
@@ -0,0 +1,568 @@
+/**
+ ****************************************************************************************
+ *
+ * @file d2_mock.c
+ *
+ * @brief Host mock of the D/AVE2D driver
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * The GPU is modeled as a FIFO of display lists that is executed only when the CPU waits for it, or when
+ * the test calls d2_mock_gpu_step(). This is the slowest GPU possible: any CPU access that is not ordered
+ * properly against the GPU shows up as a pending area or an error. Like the driver, d2_executerenderbuffer()
+ * first waits for the display list that the GPU is still executing.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "dave_driver.h"
+
+#define BUFFER_NUM              8
+#define BUFFER_OPS_MAX          1024
+#define TRACE_MAX               8192
+#define QUEUE_MAX               BUFFER_NUM
+
+typedef enum {
+        BUFFER_FREE,
+        BUFFER_IDLE,            /* allocated, nothing recorded or already executed */
+        BUFFER_RECORDING,       /* selected for writing */
+        BUFFER_QUEUED,          /* submitted, not executed yet */
+} buffer_state;
+
+typedef struct {
+        const void *fb;
+        int x1, y1, x2, y2;
+        int frame;
+} mock_op;
+
+typedef struct {
+        buffer_state state;
+        int op_count;
+        mock_op ops[BUFFER_OPS_MAX];
+} mock_buffer;
+
+static int device_tag;
+static bool device_open;
+static mock_buffer buffers[BUFFER_NUM];
+static mock_buffer *recording;
+static int queue[QUEUE_MAX];
+static int queue_count;
+static int frame;
+static d2_mock_counters counters;
+static d2_mock_event trace[TRACE_MAX];
+static int trace_count;
+static char last_error[128];
+
+/* Current drawing state, in pixels */
+static const void *fb;
+static int fb_w, fb_h;
+static int clip_x1, clip_y1, clip_x2, clip_y2;
+static d2_color colors[2];
+static d2_u32 fillmode;
+
+static void mock_error(const char *func, const char *msg)
+{
+        counters.errors++;
+        snprintf(last_error, sizeof(last_error), "%s: %s", func, msg);
+}
+
+static bool check_handle(d2_device *handle, const char *func)
+{
+        if (!device_open || handle != &device_tag) {
+                mock_error(func, "device is not open");
+                return false;
+        }
+        return true;
+}
+
+static int buffer_index(d2_renderbuffer *buffer)
+{
+        mock_buffer *b = buffer;
+
+        if (b < buffers || b >= buffers + BUFFER_NUM || b->state == BUFFER_FREE) {
+                return -1;
+        }
+        return (int)(b - buffers);
+}
+
+static void trace_add(d2_mock_event_type type, int index)
+{
+        const mock_buffer *b = &buffers[index];
+
+        if (trace_count == TRACE_MAX) {
+                return;
+        }
+        trace[trace_count].type = type;
+        trace[trace_count].buffer = index;
+        trace[trace_count].frame = b->op_count ? b->ops[0].frame : -1;
+        trace[trace_count].last_frame = b->op_count ? b->ops[b->op_count - 1].frame : -1;
+        trace_count++;
+}
+
+static void add_op(d2_device *handle, const char *func, int x1, int y1, int x2, int y2)
+{
+        mock_op *op;
+
+        if (!check_handle(handle, func)) {
+                return;
+        }
+        if (recording == NULL) {
+                mock_error(func, "no render buffer selected");
+                return;
+        }
+        if (fb == NULL) {
+                mock_error(func, "no framebuffer set");
+                return;
+        }
+        if (recording->op_count == BUFFER_OPS_MAX) {
+                mock_error(func, "render buffer full");
+                return;
+        }
+
+        op = &recording->ops[recording->op_count++];
+        op->fb = fb;
+        op->x1 = x1 > clip_x1 ? x1 : clip_x1;
+        op->y1 = y1 > clip_y1 ? y1 : clip_y1;
+        op->x2 = x2 < clip_x2 ? x2 : clip_x2;
+        op->y2 = y2 < clip_y2 ? y2 : clip_y2;
+        op->frame = frame;
+        counters.operations++;
+}
+
+/* Operations whose extent is not computed write anywhere in the clip rectangle */
+static void add_clip_op(d2_device *handle, const char *func)
+{
+        add_op(handle, func, clip_x1, clip_y1, clip_x2, clip_y2);
+}
+
+static void gpu_drain(void)
+{
+        while (d2_mock_gpu_step()) {
+        }
+}
+
+void d2_mock_reset(void)
+{
+        memset(buffers, 0, sizeof(buffers));
+        memset(&counters, 0, sizeof(counters));
+        device_open = false;
+        recording = NULL;
+        queue_count = 0;
+        trace_count = 0;
+        frame = 0;
+        fb = NULL;
+        last_error[0] = '\0';
+}
+
+void d2_mock_set_frame(int f)
+{
+        frame = f;
+}
+
+bool d2_mock_gpu_step(void)
+{
+        int index;
+
+        if (queue_count == 0) {
+                return false;
+        }
+
+        index = queue[0];
+        memmove(&queue[0], &queue[1], (queue_count - 1) * sizeof(queue[0]));
+        queue_count--;
+
+        trace_add(D2_MOCK_EXECUTE, index);
+        buffers[index].state = BUFFER_IDLE;
+
+        return true;
+}
+
+bool d2_mock_area_pending(const void *area_fb, int x1, int y1, int x2, int y2)
+{
+        for (int i = 0; i < BUFFER_NUM; i++) {
+                const mock_buffer *b = &buffers[i];
+
+                if (b->state != BUFFER_RECORDING && b->state != BUFFER_QUEUED) {
+                        continue;
+                }
+                for (int j = 0; j < b->op_count; j++) {
+                        const mock_op *op = &b->ops[j];
+
+                        if (op->fb == area_fb && op->x1 <= x2 && op->x2 >= x1 && op->y1 <= y2 && op->y2 >= y1) {
+                                return true;
+                        }
+                }
+        }
+        return false;
+}
+
+const d2_mock_counters *d2_mock_get_counters(void)
+{
+        return &counters;
+}
+
+const d2_mock_event *d2_mock_get_trace(int *count)
+{
+        *count = trace_count;
+        return trace;
+}
+
+const char *d2_mock_last_error(void)
+{
+        return last_error;
+}
+
+/*
+ * Device
+ */
+d2_device *d2_opendevice(d2_u32 flags)
+{
+        counters.opendevice++;
+        if (device_open) {
+                mock_error(__func__, "device already open");
+                return NULL;
+        }
+        device_open = true;
+        recording = NULL;
+        fb = NULL;
+
+        return &device_tag;
+}
+
+d2_s32 d2_closedevice(d2_device *handle)
+{
+        counters.closedevice++;
+        if (!check_handle(handle, __func__)) {
+                return D2_OK;
+        }
+        if (queue_count) {
+                mock_error(__func__, "device closed while the GPU executes");
+                gpu_drain();
+        }
+        for (int i = 0; i < BUFFER_NUM; i++) {
+                if (buffers[i].state != BUFFER_FREE) {
+                        mock_error(__func__, "render buffer not freed");
+                        buffers[i].state = BUFFER_FREE;
+                }
+        }
+        device_open = false;
+        recording = NULL;
+
+        return D2_OK;
+}
+
+d2_s32 d2_inithw(d2_device *handle, d2_u32 flags)
+{
+        counters.inithw++;
+        check_handle(handle, __func__);
+        return D2_OK;
+}
+
+d2_s32 d2_setdlistblocksize(d2_device *handle, d2_u32 size)
+{
+        check_handle(handle, __func__);
+        return D2_OK;
+}
+
+d1_device *d2_level1interface(d2_device *handle)
+{
+        return check_handle(handle, __func__) ? &device_tag : NULL;
+}
+
+const char *d2_geterrorstring(d2_device *handle)
+{
+        return "mock error";
+}
+
+void *d1_maptovidmem(d1_device *handle, void *mem)
+{
+        return mem;
+}
+
+d2_slong d1_deviceclkfreq(d1_device *handle, d2_u32 index)
+{
+        return 96000000;
+}
+
+/*
+ * Render buffers
+ */
+d2_renderbuffer *d2_newrenderbuffer(d2_device *handle, d2_u32 initialsize, d2_u32 stepsize)
+{
+        counters.newrenderbuffer++;
+        if (!check_handle(handle, __func__)) {
+                return NULL;
+        }
+        for (int i = 0; i < BUFFER_NUM; i++) {
+                if (buffers[i].state == BUFFER_FREE) {
+                        buffers[i].state = BUFFER_IDLE;
+                        buffers[i].op_count = 0;
+                        return &buffers[i];
+                }
+        }
+        return NULL;
+}
+
+d2_s32 d2_freerenderbuffer(d2_device *handle, d2_renderbuffer *buffer)
+{
+        int index = buffer_index(buffer);
+
+        counters.freerenderbuffer++;
+        if (!check_handle(handle, __func__) || index < 0) {
+                mock_error(__func__, "invalid render buffer");
+                return D2_OK;
+        }
+        if (buffers[index].state == BUFFER_QUEUED) {
+                mock_error(__func__, "render buffer freed while the GPU executes it");
+                gpu_drain();
+        }
+        if (recording == &buffers[index]) {
+                recording = NULL;
+        }
+        buffers[index].state = BUFFER_FREE;
+
+        return D2_OK;
+}
+
+d2_s32 d2_selectrenderbuffer(d2_device *handle, d2_renderbuffer *buffer)
+{
+        int index = buffer_index(buffer);
+
+        counters.selectrenderbuffer++;
+        if (!check_handle(handle, __func__) || index < 0) {
+                mock_error(__func__, "invalid render buffer");
+                return D2_OK;
+        }
+        if (buffers[index].state == BUFFER_QUEUED) {
+                mock_error(__func__, "render buffer selected while the GPU executes it");
+                gpu_drain();
+        }
+        if (recording && recording != &buffers[index] && recording->op_count) {
+                mock_error(__func__, "operations of the previous render buffer are not submitted");
+        }
+        if (recording && recording != &buffers[index]) {
+                recording->state = BUFFER_IDLE;
+        }
+        buffers[index].state = BUFFER_RECORDING;
+        buffers[index].op_count = 0;
+        recording = &buffers[index];
+
+        return D2_OK;
+}
+
+d2_s32 d2_executerenderbuffer(d2_device *handle, d2_renderbuffer *buffer, d2_u32 flags)
+{
+        int index = buffer_index(buffer);
+
+        counters.executerenderbuffer++;
+        if (!check_handle(handle, __func__) || index < 0) {
+                mock_error(__func__, "invalid render buffer");
+                return D2_OK;
+        }
+        if (buffers[index].state == BUFFER_QUEUED) {
+                mock_error(__func__, "render buffer submitted twice");
+                return D2_OK;
+        }
+
+        /* The GPU executes one display list at a time */
+        gpu_drain();
+
+        trace_add(D2_MOCK_SUBMIT, index);
+        if (recording == &buffers[index]) {
+                recording = NULL;
+        }
+        buffers[index].state = BUFFER_QUEUED;
+        queue[queue_count++] = index;
+
+        return D2_OK;
+}
+
+d2_s32 d2_flushframe(d2_device *handle)
+{
+        counters.flushframe++;
+        if (!check_handle(handle, __func__)) {
+                return D2_OK;
+        }
+        if (recording && recording->op_count) {
+                mock_error(__func__, "operations of the selected render buffer are not submitted");
+        }
+        if (trace_count < TRACE_MAX) {
+                trace[trace_count].type = D2_MOCK_WAIT;
+                trace[trace_count].buffer = -1;
+                trace[trace_count].frame = frame;
+                trace[trace_count].last_frame = frame;
+                trace_count++;
+        }
+        gpu_drain();
+
+        return D2_OK;
+}
+
+/*
+ * State
+ */
+d2_s32 d2_framebuffer(d2_device *handle, void *ptr, d2_s32 pitch, d2_u32 width, d2_u32 height, d2_s32 format)
+{
+        counters.framebuffer++;
+        if (!check_handle(handle, __func__)) {
+                return D2_OK;
+        }
+        fb = ptr;
+        fb_w = (int)width;
+        fb_h = (int)height;
+
+        /* The driver resets the clip rectangle to the new framebuffer */
+        clip_x1 = 0;
+        clip_y1 = 0;
+        clip_x2 = fb_w - 1;
+        clip_y2 = fb_h - 1;
+
+        return D2_OK;
+}
+
+d2_s32 d2_cliprect(d2_device *handle, d2_border xmin, d2_border ymin, d2_border xmax, d2_border ymax)
+{
+        counters.cliprect++;
+        if (!check_handle(handle, __func__)) {
+                return D2_OK;
+        }
+        clip_x1 = xmin > 0 ? xmin : 0;
+        clip_y1 = ymin > 0 ? ymin : 0;
+        clip_x2 = xmax < fb_w - 1 ? xmax : fb_w - 1;
+        clip_y2 = ymax < fb_h - 1 ? ymax : fb_h - 1;
+
+        return D2_OK;
+}
+
+d2_s32 d2_setcolor(d2_device *handle, d2_u32 index, d2_color color)
+{
+        if (index < 2) {
+                colors[index] = color;
+        }
+        return D2_OK;
+}
+
+d2_color d2_getcolor(d2_device *handle, d2_u32 index)
+{
+        return index < 2 ? colors[index] : 0;
+}
+
+d2_s32 d2_setfillmode(d2_device *handle, d2_u32 mode)
+{
+        fillmode = mode;
+        return D2_OK;
+}
+
+d2_u32 d2_getfillmode(d2_device *handle)
+{
+        return fillmode;
+}
+
+d2_s32 d2_setblendmode(d2_device *handle, d2_u32 srcfactor, d2_u32 dstfactor) { return D2_OK; }
+d2_s32 d2_setalphablendmode(d2_device *handle, d2_u32 srcfactor, d2_u32 dstfactor) { return D2_OK; }
+d2_s32 d2_setalpha(d2_device *handle, d2_alpha alpha) { return D2_OK; }
+d2_s32 d2_setalphamode(d2_device *handle, d2_u32 mode) { return D2_OK; }
+d2_s32 d2_setalphagradient(d2_device *handle, d2_u32 index, d2_point x, d2_point y, d2_point dx, d2_point dy)
+{
+        return D2_OK;
+}
+d2_s32 d2_setcolorkey(d2_device *handle, d2_s32 enable, d2_color color) { return D2_OK; }
+d2_s32 d2_settexture(d2_device *handle, void *ptr, d2_s32 pitch, d2_s32 width, d2_s32 height, d2_u32 format)
+{
+        return D2_OK;
+}
+d2_s32 d2_settexturemode(d2_device *handle, d2_u32 mode) { return D2_OK; }
+d2_s32 d2_settextureoperation(d2_device *handle, d2_u8 amode, d2_u8 rmode, d2_u8 gmode, d2_u8 bmode)
+{
+        return D2_OK;
+}
+d2_s32 d2_settexopparam(d2_device *handle, d2_u32 index, d2_u32 p1, d2_u32 p2) { return D2_OK; }
+d2_s32 d2_settexelcenter(d2_device *handle, d2_point x, d2_point y) { return D2_OK; }
+d2_s32 d2_settexturemapping(d2_device *handle, d2_point x, d2_point y, d2_s32 u0, d2_s32 v0, d2_s32 dxu,
+        d2_s32 dyu, d2_s32 dxv, d2_s32 dyv)
+{
+        return D2_OK;
+}
+d2_s32 d2_settexclut(d2_device *handle, d2_color *clut) { return D2_OK; }
+d2_s32 d2_writetexclut_direct(d2_device *handle, const d2_color *data, d2_u32 start_index, d2_u32 length)
+{
+        return D2_OK;
+}
+d2_s32 d2_setblitsrc(d2_device *handle, void *ptr, d2_s32 pitch, d2_s32 width, d2_s32 height, d2_u32 format)
+{
+        return D2_OK;
+}
+d2_s32 d2_setperfcountevent(d2_device *handle, d2_u32 index, d2_u32 event) { return D2_OK; }
+d2_s32 d2_setperfcountvalue(d2_device *handle, d2_u32 index, d2_slong value) { return D2_OK; }
+d2_slong d2_getperfcountvalue(d2_device *handle, d2_u32 index) { return 0; }
+
+/*
+ * Drawing
+ */
+d2_s32 d2_renderbox(d2_device *handle, d2_point x, d2_point y, d2_width w, d2_width h)
+{
+        add_op(handle, __func__, D2_INT4(x), D2_INT4(y), D2_INT4(x + w) - 1, D2_INT4(y + h) - 1);
+        return D2_OK;
+}
+
+d2_s32 d2_renderline(d2_device *handle, d2_point x1, d2_point y1, d2_point x2, d2_point y2, d2_width w,
+        d2_u32 flags)
+{
+        add_clip_op(handle, __func__);
+        return D2_OK;
+}
+
+d2_s32 d2_rendercircle(d2_device *handle, d2_point x, d2_point y, d2_width r, d2_width w)
+{
+        add_clip_op(handle, __func__);
+        return D2_OK;
+}
+
+d2_s32 d2_renderwedge(d2_device *handle, d2_point x, d2_point y, d2_width r, d2_width w, d2_s32 nx1, d2_s32 ny1,
+        d2_s32 nx2, d2_s32 ny2, d2_u32 flags)
+{
+        add_clip_op(handle, __func__);
+        return D2_OK;
+}
+
+d2_s32 d2_rendertri(d2_device *handle, d2_point x1, d2_point y1, d2_point x2, d2_point y2, d2_point x3,
+        d2_point y3, d2_u32 flags)
+{
+        add_clip_op(handle, __func__);
+        return D2_OK;
+}
+
+d2_s32 d2_renderquad(d2_device *handle, d2_point x1, d2_point y1, d2_point x2, d2_point y2, d2_point x3,
+        d2_point y3, d2_point x4, d2_point y4, d2_u32 flags)
+{
+        add_clip_op(handle, __func__);
+        return D2_OK;
+}
+
+d2_s32 d2_blitcopy(d2_device *handle, d2_s32 srcwidth, d2_s32 srcheight, d2_s32 srcx, d2_s32 srcy,
+        d2_width dstwidth, d2_width dstheight, d2_point dstx, d2_point dsty, d2_u32 flags)
+{
+        add_op(handle, __func__, D2_INT4(dstx), D2_INT4(dsty), D2_INT4(dstx + dstwidth) - 1,
+                D2_INT4(dsty + dstheight) - 1);
+        return D2_OK;
+}
@@ -0,0 +1,234 @@
+/**
+ ****************************************************************************************
+ *
+ * @file dave_driver.h
+ *
+ * @brief Host mock of the D/AVE2D driver API used by the GPU port
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Stands in for the SDK dave_driver.h when lv_port_gpu.c is built on the host. Only the declarations used by
+ * the port are provided. Drawing calls do not render anything: d2_mock.c records them per render buffer, together
+ * with the area they write, and executes render buffers in the order they are submitted, like the hardware.
+ */
+#ifndef DAVE_DRIVER_H_
+#define DAVE_DRIVER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef int8_t d2_s8;
+typedef uint8_t d2_u8;
+typedef int16_t d2_s16;
+typedef uint16_t d2_u16;
+typedef int32_t d2_s32;
+typedef uint32_t d2_u32;
+typedef long d2_slong;
+
+typedef d2_u32 d2_color;
+typedef d2_u8 d2_alpha;
+typedef d2_s16 d2_point;
+typedef d2_s16 d2_width;
+typedef d2_s16 d2_border;
+
+typedef void d1_device;
+typedef void d2_device;
+typedef void d2_renderbuffer;
+
+#define D2_OK                   (0)
+#define D2_NOMEMORY             (1)
+
+#define D2_FIX4(x)              ((x) << 4)
+#define D2_INT4(x)              ((x) >> 4)
+#define D2_FIX16(x)             ((x) << 16)
+
+#define D1_DAVE2D               (1)
+
+/* Color modes */
+enum {
+        d2_mode_alpha8          = 0x0000,
+        d2_mode_rgb565          = 0x0001,
+        d2_mode_argb8888        = 0x0002,
+        d2_mode_rgb888          = 0x0010,
+        d2_mode_argb4444        = 0x0003,
+        d2_mode_rgba8888        = 0x0004,
+        d2_mode_rgba4444        = 0x0005,
+        d2_mode_argb1555        = 0x0006,
+        d2_mode_rgba5551        = 0x0007,
+        d2_mode_ai44            = 0x0008,
+        d2_mode_i8              = 0x0009,
+        d2_mode_i4              = 0x000a,
+        d2_mode_i2              = 0x000b,
+        d2_mode_i1              = 0x000c,
+        d2_mode_alpha4          = 0x000d,
+        d2_mode_alpha2          = 0x000e,
+        d2_mode_alpha1          = 0x000f,
+        d2_mode_rle             = 0x1000,
+        d2_mode_clut            = 0x2000,
+};
+
+/* Blend factors */
+enum {
+        d2_bm_zero              = 0,
+        d2_bm_one               = 1,
+        d2_bm_alpha             = 2,
+        d2_bm_one_minus_alpha   = 3,
+};
+
+/* Blit flags */
+enum {
+        d2_bf_filter            = 0x0001,
+        d2_bf_wrap              = 0x0002,
+        d2_bf_mirroru           = 0x0004,
+        d2_bf_mirrorv           = 0x0008,
+        d2_bf_usealpha          = 0x0010,
+        d2_bf_colorize2         = 0x0020,
+};
+
+/* Fill, alpha and texture operation modes */
+enum {
+        d2_fm_color             = 0,
+        d2_fm_texture           = 1,
+        d2_am_constant          = 0,
+        d2_am_gradient1         = 1,
+        d2_to_one               = 0,
+        d2_to_copy              = 1,
+        d2_to_blend             = 2,
+        d2_cc_red               = 1,
+        d2_cc_green             = 2,
+        d2_cc_blue              = 3,
+        d2_pc_davecycles        = 0,
+};
+
+/* Edge and wedge flags */
+enum {
+        d2_edge0_shared         = 0x0001,
+        d2_edge2_shared         = 0x0004,
+        d2_wf_concave           = 0x0010,
+};
+
+d2_device *d2_opendevice(d2_u32 flags);
+d2_s32 d2_closedevice(d2_device *handle);
+d2_s32 d2_inithw(d2_device *handle, d2_u32 flags);
+d2_s32 d2_setdlistblocksize(d2_device *handle, d2_u32 size);
+d1_device *d2_level1interface(d2_device *handle);
+const char *d2_geterrorstring(d2_device *handle);
+void *d1_maptovidmem(d1_device *handle, void *mem);
+d2_slong d1_deviceclkfreq(d1_device *handle, d2_u32 index);
+
+d2_renderbuffer *d2_newrenderbuffer(d2_device *handle, d2_u32 initialsize, d2_u32 stepsize);
+d2_s32 d2_freerenderbuffer(d2_device *handle, d2_renderbuffer *buffer);
+d2_s32 d2_selectrenderbuffer(d2_device *handle, d2_renderbuffer *buffer);
+d2_s32 d2_executerenderbuffer(d2_device *handle, d2_renderbuffer *buffer, d2_u32 flags);
+d2_s32 d2_flushframe(d2_device *handle);
+
+d2_s32 d2_framebuffer(d2_device *handle, void *ptr, d2_s32 pitch, d2_u32 width, d2_u32 height, d2_s32 format);
+d2_s32 d2_cliprect(d2_device *handle, d2_border xmin, d2_border ymin, d2_border xmax, d2_border ymax);
+d2_s32 d2_setblendmode(d2_device *handle, d2_u32 srcfactor, d2_u32 dstfactor);
+d2_s32 d2_setalphablendmode(d2_device *handle, d2_u32 srcfactor, d2_u32 dstfactor);
+d2_s32 d2_setalpha(d2_device *handle, d2_alpha alpha);
+d2_s32 d2_setalphamode(d2_device *handle, d2_u32 mode);
+d2_s32 d2_setalphagradient(d2_device *handle, d2_u32 index, d2_point x, d2_point y, d2_point dx, d2_point dy);
+d2_s32 d2_setcolor(d2_device *handle, d2_u32 index, d2_color color);
+d2_color d2_getcolor(d2_device *handle, d2_u32 index);
+d2_s32 d2_setcolorkey(d2_device *handle, d2_s32 enable, d2_color color);
+d2_s32 d2_setfillmode(d2_device *handle, d2_u32 mode);
+d2_u32 d2_getfillmode(d2_device *handle);
+d2_s32 d2_settexture(d2_device *handle, void *ptr, d2_s32 pitch, d2_s32 width, d2_s32 height, d2_u32 format);
+d2_s32 d2_settexturemode(d2_device *handle, d2_u32 mode);
+d2_s32 d2_settextureoperation(d2_device *handle, d2_u8 amode, d2_u8 rmode, d2_u8 gmode, d2_u8 bmode);
+d2_s32 d2_settexopparam(d2_device *handle, d2_u32 index, d2_u32 p1, d2_u32 p2);
+d2_s32 d2_settexelcenter(d2_device *handle, d2_point x, d2_point y);
+d2_s32 d2_settexturemapping(d2_device *handle, d2_point x, d2_point y, d2_s32 u0, d2_s32 v0, d2_s32 dxu,
+        d2_s32 dyu, d2_s32 dxv, d2_s32 dyv);
+d2_s32 d2_settexclut(d2_device *handle, d2_color *clut);
+d2_s32 d2_writetexclut_direct(d2_device *handle, const d2_color *data, d2_u32 start_index, d2_u32 length);
+d2_s32 d2_setblitsrc(d2_device *handle, void *ptr, d2_s32 pitch, d2_s32 width, d2_s32 height, d2_u32 format);
+d2_s32 d2_setperfcountevent(d2_device *handle, d2_u32 index, d2_u32 event);
+d2_s32 d2_setperfcountvalue(d2_device *handle, d2_u32 index, d2_slong value);
+d2_slong d2_getperfcountvalue(d2_device *handle, d2_u32 index);
+
+d2_s32 d2_renderbox(d2_device *handle, d2_point x, d2_point y, d2_width w, d2_width h);
+d2_s32 d2_renderline(d2_device *handle, d2_point x1, d2_point y1, d2_point x2, d2_point y2, d2_width w,
+        d2_u32 flags);
+d2_s32 d2_rendercircle(d2_device *handle, d2_point x, d2_point y, d2_width r, d2_width w);
+d2_s32 d2_renderwedge(d2_device *handle, d2_point x, d2_point y, d2_width r, d2_width w, d2_s32 nx1, d2_s32 ny1,
+        d2_s32 nx2, d2_s32 ny2, d2_u32 flags);
+d2_s32 d2_rendertri(d2_device *handle, d2_point x1, d2_point y1, d2_point x2, d2_point y2, d2_point x3,
+        d2_point y3, d2_u32 flags);
+d2_s32 d2_renderquad(d2_device *handle, d2_point x1, d2_point y1, d2_point x2, d2_point y2, d2_point x3,
+        d2_point y3, d2_point x4, d2_point y4, d2_u32 flags);
+d2_s32 d2_blitcopy(d2_device *handle, d2_s32 srcwidth, d2_s32 srcheight, d2_s32 srcx, d2_s32 srcy,
+        d2_width dstwidth, d2_width dstheight, d2_point dstx, d2_point dsty, d2_u32 flags);
+
+/*
+ * Mock control and inspection
+ */
+
+/* One entry of the trace */
+typedef enum {
+        D2_MOCK_SUBMIT,         /* d2_executerenderbuffer(): a display list is queued to the GPU */
+        D2_MOCK_EXECUTE,        /* the GPU has executed a display list */
+        D2_MOCK_WAIT,           /* d2_flushframe(): the CPU waits for the GPU */
+} d2_mock_event_type;
+
+typedef struct {
+        d2_mock_event_type type;
+        int buffer;             /* index of the render buffer, in order of creation */
+        int frame;              /* frame of the first operation of the display list, -1 if empty */
+        int last_frame;         /* frame of the last operation of the display list, -1 if empty */
+} d2_mock_event;
+
+typedef struct {
+        int opendevice;
+        int closedevice;
+        int inithw;
+        int newrenderbuffer;
+        int freerenderbuffer;
+        int selectrenderbuffer;
+        int executerenderbuffer;
+        int flushframe;
+        int framebuffer;
+        int cliprect;
+        int operations;         /* drawing operations recorded */
+        int errors;             /* calls not allowed in the current state, see d2_mock_last_error() */
+} d2_mock_counters;
+
+/* Reset the counters, the trace and the GPU model; the device must be closed */
+void d2_mock_reset(void);
+
+/* Tag the next drawing operations with a frame number */
+void d2_mock_set_frame(int frame);
+
+/* Let the GPU execute the oldest queued display list, return false if nothing was queued */
+bool d2_mock_gpu_step(void);
+
+/* Return whether an operation writing into the given pixels of fb is recorded but not executed yet */
+bool d2_mock_area_pending(const void *fb, int x1, int y1, int x2, int y2);
+
+const d2_mock_counters *d2_mock_get_counters(void);
+const d2_mock_event *d2_mock_get_trace(int *count);
+const char *d2_mock_last_error(void);
+
+#endif /* DAVE_DRIVER_H_ */
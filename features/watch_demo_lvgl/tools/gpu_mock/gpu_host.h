@@ -0,0 +1,63 @@
+/**
+ ****************************************************************************************
+ *
+ * @file gpu_host.h
+ *
+ * @brief SDK definitions needed to build lv_port_gpu.c on the host
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Included by the host tests before lv_port_gpu.c. The frame buffer is ARGB8888, as LV_COLOR_DEPTH in the
+ * lv_conf.h next to this file. The content of gdi.h is skipped, the GPU port does not use it. The glyph atlas
+ * and the shadow cache are disabled unless their size is set before, so that their sources are not needed.
+ */
+#ifndef GPU_HOST_H_
+#define GPU_HOST_H_
+
+#define GDI_H_
+#define PRIVILEGED_DATA
+#define INITIALISED_PRIVILEGED_DATA
+#define ORIGINAL                        0
+#define SCENARIO                        1
+#define CF_NATIVE_RGB565                1
+#define CF_NATIVE_ARGB8888              2
+#define GDI_FB_COLOR_FORMAT             CF_NATIVE_ARGB8888
+#define GDI_ARGB8888_ALPHA_POS          24
+#define GDI_ARGB8888_RED_POS            16
+#define GDI_ARGB8888_GREEN_POS          8
+#define GDI_ARGB8888_BLUE_POS           0
+#define GDI_F_COLOR_POS(f, c)           GDI_ ## f ## _ ## c ## _POS
+#define MEMORY_SYSRAM_BASE              0
+#define MEMORY_SYSRAM_END               0
+#define MIN(a, b)                       ((a) < (b) ? (a) : (b))
+#define MAX(a, b)                       ((a) > (b) ? (a) : (b))
+
+#ifndef LV_PORT_SHADOW_CACHE_SIZE
+#define LV_PORT_SHADOW_CACHE_SIZE       0
+#endif
+#ifndef LV_PORT_GLYPH_ATLAS_PAGE_NUM
+#define LV_PORT_GLYPH_ATLAS_PAGE_NUM    0
+#endif
+
+#endif /* GPU_HOST_H_ */
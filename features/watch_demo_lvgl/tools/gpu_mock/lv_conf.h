@@ -0,0 +1,53 @@
+/**
+ ****************************************************************************************
+ *
+ * @file lv_conf.h
+ *
+ * @brief LVGL configuration of the host tests of the GPU port
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * The GPU settings of ui/lv_conf.h, on a 32-bit frame buffer unless LV_COLOR_DEPTH is given. Everything else
+ * keeps the LVGL default, so that no SDK header is needed.
+ */
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#include <stdint.h>
+
+#ifndef LV_COLOR_DEPTH
+#define LV_COLOR_DEPTH                          32
+#endif
+
+#define DLG_LVGL_CF                             1
+#define DLG_LVGL_CF_SUB_BYTE_SWAP               0
+
+#define LV_USE_EXTERNAL_RENDERER                1
+
+#define DLG_LVGL_USE_GPU_DA1470X                1
+#define DLG_LVGL_GPU_DA1470X_INCLUDE_PATH       "dave_driver.h"
+#define DLG_LVGL_GPU_BLIT_MASK_BUFFER_SIZE      (20 * 1024)
+#define DLG_LVGL_GPU_BLIT_MASK_SIZE_LIMIT       2000
+
+#endif /* LV_CONF_H */
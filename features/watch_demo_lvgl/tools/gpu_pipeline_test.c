@@ -0,0 +1,239 @@
+/**
+ ****************************************************************************************
+ *
+ * @file gpu_pipeline_test.c
+ *
+ * @brief Host check of the ordering of the GPU display lists and of the waits for pending areas
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run on the host, from the tools folder:
+ *      gcc -O2 -DLV_CONF_INCLUDE_SIMPLE -DLV_LVGL_H_INCLUDE_SIMPLE -Wno-pointer-to-int-cast -Igpu_mock -I../gdi/inc \
+ *              -I../lvgl/lvgl -I../lvgl/lv_port -o gpu_pipeline_test gpu_pipeline_test.c gpu_mock/d2_mock.c \
+ *              $(find ../lvgl/lvgl/src -name '*.c') -lm && ./gpu_pipeline_test
+ *
+ * lv_port_gpu.c is built with LV_PORT_GPU_PIPELINE against the D/AVE2D mock of gpu_mock/, which traces when
+ * display lists are submitted, executed and waited for. Frames are drawn into two buffers in turn, as random
+ * GPU fills mixed with CPU writes. Before each CPU write lv_port_gpu_wait_area() is called, like LVGL does
+ * through `gpu_wait_area_cb`, and the written area must then have no GPU operation left in any display list.
+ * The GPU executes a display list only when the CPU waits or at random points of the frame.
+ *
+ * The trace must show the display lists executed in the order they were submitted, with the operations of a
+ * frame never executed before those of an earlier frame. Some CPU writes must also have been done while the GPU
+ * still had other areas pending, otherwise nothing was overlapped.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "gpu_host.h"
+#define LV_PORT_GPU_PIPELINE            1
+#include "lv_port_gpu.c"
+
+#define RES_X                   64
+#define RES_Y                   64
+#define FRAMES                  200
+#define OPS_PER_FRAME           60
+#define AREA_MAX                16
+/* One operation in CPU_WRITE_RATE is a CPU write, one in GPU_STEP_RATE lets the GPU execute a display list */
+#define CPU_WRITE_RATE          4
+#define GPU_STEP_RATE           8
+
+static lv_color_t frame_buf[2][RES_X * RES_Y];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static uint32_t seed = 1;
+static int cpu_writes, cpu_writes_overlapped, cpu_writes_waited;
+static int failures;
+
+#define CHECK(cond)                                                                     \
+        do {                                                                            \
+                if (!(cond)) {                                                          \
+                        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+                        failures++;                                                     \
+                }                                                                       \
+        } while (0)
+
+static uint32_t rand_next(uint32_t range)
+{
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) % range;
+}
+
+static void rand_area(lv_area_t *area)
+{
+        area->x1 = rand_next(RES_X - AREA_MAX);
+        area->y1 = rand_next(RES_Y - AREA_MAX);
+        area->x2 = area->x1 + rand_next(AREA_MAX);
+        area->y2 = area->y1 + rand_next(AREA_MAX);
+}
+
+static int wait_count(void)
+{
+        int count, waits = 0;
+        const d2_mock_event *trace = d2_mock_get_trace(&count);
+
+        for (int i = 0; i < count; i++) {
+                waits += trace[i].type == D2_MOCK_WAIT;
+        }
+        return waits;
+}
+
+/* A CPU write is only allowed once no display list writes into the area anymore */
+static void cpu_write(lv_color_t *buf, const lv_area_t *area)
+{
+        bool pending = d2_mock_area_pending(buf, 0, 0, RES_X - 1, RES_Y - 1);
+        int waits = wait_count();
+
+        lv_port_gpu_wait_area(&disp_drv, buf, area);
+
+        CHECK(!d2_mock_area_pending(buf, area->x1, area->y1, area->x2, area->y2));
+        cpu_writes++;
+        if (wait_count() != waits) {
+                cpu_writes_waited++;
+        } else if (pending) {
+                cpu_writes_overlapped++;
+        }
+
+        for (int y = area->y1; y <= area->y2; y++) {
+                lv_color_fill(&buf[y * RES_X + area->x1], lv_color_white(), lv_area_get_width(area));
+        }
+}
+
+static void draw_frame(int frame)
+{
+        lv_color_t *buf = frame_buf[frame % 2];
+
+        d2_mock_set_frame(frame);
+        draw_buf.buf_act = buf;
+
+        for (int i = 0; i < OPS_PER_FRAME; i++) {
+                lv_area_t area;
+
+                rand_area(&area);
+                if (rand_next(CPU_WRITE_RATE) == 0) {
+                        cpu_write(buf, &area);
+                } else {
+                        lv_port_gpu_fill(&disp_drv, buf, RES_X, &area, lv_color_hex(0x102030 * i), LV_OPA_COVER);
+                }
+                if (rand_next(GPU_STEP_RATE) == 0) {
+                        d2_mock_gpu_step();
+                }
+        }
+
+        /* Refresh end: LVGL waits for the GPU, then flushes the frame */
+        lv_port_gpu_wait(&disp_drv);
+        CHECK(!d2_mock_area_pending(buf, 0, 0, RES_X - 1, RES_Y - 1));
+        lv_port_gpu_flush();
+}
+
+/* The GPU must execute the display lists in order, so frames complete in order */
+static void test_trace(void)
+{
+        int count, submitted = 0, executed = 0, last_frame = -1;
+        int submit_order[FRAMES * OPS_PER_FRAME];
+        const d2_mock_event *trace = d2_mock_get_trace(&count);
+
+        for (int i = 0; i < count; i++) {
+                const d2_mock_event *event = &trace[i];
+
+                if (event->type == D2_MOCK_SUBMIT) {
+                        submit_order[submitted++] = event->buffer;
+                } else if (event->type == D2_MOCK_EXECUTE) {
+                        CHECK(executed < submitted && event->buffer == submit_order[executed]);
+                        executed++;
+                        if (event->frame >= 0) {
+                                CHECK(event->frame >= last_frame);
+                                last_frame = event->last_frame;
+                        }
+                }
+        }
+
+        CHECK(count < 8192);
+        CHECK(submitted == executed);
+        CHECK(last_frame == FRAMES - 1);
+}
+
+/* A write into an area drawn by the GPU waits, a write next to it does not */
+static void test_pending_area(void)
+{
+        lv_color_t *buf = frame_buf[0];
+        const lv_area_t gpu_area = { 0, 0, 15, 15 };
+        const lv_area_t near_area = { 16, 0, 31, 15 };
+        const lv_area_t overlap_area = { 15, 15, 20, 20 };
+        int waits;
+
+        d2_mock_set_frame(FRAMES);
+        draw_buf.buf_act = buf;
+
+        lv_port_gpu_fill(&disp_drv, buf, RES_X, &gpu_area, lv_color_black(), LV_OPA_COVER);
+        waits = wait_count();
+        lv_port_gpu_wait_area(&disp_drv, buf, &near_area);
+        CHECK(wait_count() == waits);
+        CHECK(d2_mock_area_pending(buf, gpu_area.x1, gpu_area.y1, gpu_area.x2, gpu_area.y2));
+
+        /* Same area of the other buffer */
+        lv_port_gpu_wait_area(&disp_drv, frame_buf[1], &gpu_area);
+        CHECK(wait_count() == waits);
+
+        lv_port_gpu_wait_area(&disp_drv, buf, &overlap_area);
+        CHECK(wait_count() == waits + 1);
+        CHECK(!d2_mock_area_pending(buf, 0, 0, RES_X - 1, RES_Y - 1));
+
+        lv_port_gpu_wait(&disp_drv);
+        lv_port_gpu_flush();
+}
+
+int main(void)
+{
+        const d2_mock_counters *counters = d2_mock_get_counters();
+
+        lv_disp_draw_buf_init(&draw_buf, frame_buf[0], frame_buf[1], RES_X * RES_Y);
+        lv_disp_drv_init(&disp_drv);
+        disp_drv.hor_res = RES_X;
+        disp_drv.ver_res = RES_Y;
+        disp_drv.draw_buf = &draw_buf;
+        draw_buf.area.x2 = RES_X - 1;
+        draw_buf.area.y2 = RES_Y - 1;
+
+        d2_mock_reset();
+        lv_port_gpu_init();
+
+        for (int frame = 0; frame < FRAMES; frame++) {
+                draw_frame(frame);
+        }
+        test_trace();
+        test_pending_area();
+
+        CHECK(cpu_writes_overlapped > 0);
+        CHECK(counters->errors == 0);
+        if (counters->errors) {
+                printf("Last driver error: %s\n", d2_mock_last_error());
+        }
+
+        printf("%d frames, %d display lists, %d CPU writes: %d waited, %d overlapped GPU work, %s\n", FRAMES,
+                counters->executerenderbuffer, cpu_writes, cpu_writes_waited, cpu_writes_overlapped,
+                failures ? "FAILED" : "passed");
+
+        return failures ? 1 : 0;
+}
@@ -0,0 +1,170 @@
+/**
+ ****************************************************************************************
+ *
+ * @file gpu_session_test.c
+ *
+ * @brief Host check that the D/AVE2D device stays open across frames and is released when idle
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run on the host, from the tools folder:
+ *      gcc -O2 -DLV_CONF_INCLUDE_SIMPLE -DLV_LVGL_H_INCLUDE_SIMPLE -Wno-pointer-to-int-cast -Igpu_mock -I../gdi/inc \
+ *              -I../lvgl/lvgl -I../lvgl/lv_port -o gpu_session_test gpu_session_test.c gpu_mock/d2_mock.c \
+ *              $(find ../lvgl/lvgl/src -name '*.c') -lm && ./gpu_session_test
+ *
+ * lv_port_gpu.c is built with the LVGL configuration of gpu_mock/ against its D/AVE2D mock, which counts the
+ * driver calls. Frames are drawn as LVGL does: GPU fills, lv_port_gpu_wait() from the wait callback, then
+ * lv_port_gpu_flush() from the flush callback. Between frames the GUI task loop of MainTask.c is replayed with
+ * the time returned by lv_task_handler(). The device must be opened once for all frames, closed once when the
+ * GUI becomes idle, and opened again by the next frame. The mock also reports any driver call made in a wrong
+ * state, such as closing the device while the GPU still executes a display list.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "gpu_host.h"
+#include "lv_port_gpu.c"
+
+#define RES_X                   64
+#define RES_Y                   64
+#define FRAMES                  50
+#define FILLS_PER_FRAME         20
+#define FRAME_SLEEP_MS          16
+#define IDLE_SLEEP_MS           500
+
+static lv_color_t frame_buf[RES_X * RES_Y];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static int failures;
+
+#define CHECK(cond)                                                                     \
+        do {                                                                            \
+                if (!(cond)) {                                                          \
+                        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+                        failures++;                                                     \
+                }                                                                       \
+        } while (0)
+
+/* Draw one frame the way LVGL calls the port */
+static void refresh(int frame)
+{
+        d2_mock_set_frame(frame);
+
+        for (int i = 0; i < FILLS_PER_FRAME; i++) {
+                lv_area_t area = { i, i, i + 8, i + 8 };
+
+                lv_port_gpu_fill(&disp_drv, frame_buf, RES_X, &area, lv_color_hex(0x102030 * i), LV_OPA_COVER);
+        }
+
+        lv_port_gpu_wait(&disp_drv);
+        lv_port_gpu_flush();
+}
+
+/* GPU part of the loop of GUIThread() in MainTask.c */
+static void gui_task_cycle(uint32_t sleep_time)
+{
+        if (sleep_time >= LV_PORT_GPU_RELEASE_IDLE_MS) {
+                lv_port_gpu_release();
+        }
+}
+
+static void test_frames(void)
+{
+        const d2_mock_counters *counters = d2_mock_get_counters();
+
+        for (int frame = 0; frame < FRAMES; frame++) {
+                refresh(frame);
+                gui_task_cycle(FRAME_SLEEP_MS);
+        }
+
+        CHECK(counters->opendevice == 1);
+        CHECK(counters->inithw == 1);
+        CHECK(counters->newrenderbuffer == LV_PORT_GPU_RENDERBUFFER_NUM);
+        CHECK(counters->closedevice == 0);
+        CHECK(counters->freerenderbuffer == 0);
+        CHECK(counters->operations == FRAMES * FILLS_PER_FRAME);
+        CHECK(counters->flushframe >= FRAMES);
+}
+
+static void test_idle(void)
+{
+        const d2_mock_counters *counters = d2_mock_get_counters();
+
+        /* Idle period right after a frame: the session is released once */
+        gui_task_cycle(IDLE_SLEEP_MS);
+        gui_task_cycle(IDLE_SLEEP_MS);
+        gui_task_cycle(LV_NO_TIMER_READY);
+
+        CHECK(counters->closedevice == 1);
+        CHECK(counters->freerenderbuffer == LV_PORT_GPU_RENDERBUFFER_NUM);
+        CHECK(d2_handle == NULL);
+
+        /* The next frame opens the device again */
+        refresh(FRAMES);
+        gui_task_cycle(FRAME_SLEEP_MS);
+
+        CHECK(counters->opendevice == 2);
+        CHECK(counters->closedevice == 1);
+
+        /* Operations still queued when the GUI becomes idle are completed before the device is closed */
+        d2_mock_set_frame(FRAMES + 1);
+        for (int i = 0; i < LV_PORT_GPU_BATCH_SIZE + 1; i++) {
+                lv_area_t area = { 0, i, RES_X - 1, i };
+
+                lv_port_gpu_fill(&disp_drv, frame_buf, RES_X, &area, lv_color_black(), LV_OPA_COVER);
+        }
+        gui_task_cycle(IDLE_SLEEP_MS);
+
+        CHECK(counters->closedevice == 2);
+        CHECK(!d2_mock_area_pending(frame_buf, 0, 0, RES_X - 1, RES_Y - 1));
+}
+
+int main(void)
+{
+        const d2_mock_counters *counters = d2_mock_get_counters();
+
+        lv_disp_draw_buf_init(&draw_buf, frame_buf, NULL, RES_X * RES_Y);
+        lv_disp_drv_init(&disp_drv);
+        disp_drv.hor_res = RES_X;
+        disp_drv.ver_res = RES_Y;
+        disp_drv.draw_buf = &draw_buf;
+        draw_buf.area.x2 = RES_X - 1;
+        draw_buf.area.y2 = RES_Y - 1;
+
+        d2_mock_reset();
+        lv_port_gpu_init();
+
+        test_frames();
+        test_idle();
+
+        CHECK(counters->errors == 0);
+        if (counters->errors) {
+                printf("Last driver error: %s\n", d2_mock_last_error());
+        }
+
+        printf("%d frames, %d device opens, %d closes, %s\n", FRAMES + 1, counters->opendevice,
+                counters->closedevice, failures ? "FAILED" : "passed");
+
+        return failures ? 1 : 0;
+}
@@ -0,0 +1,388 @@
+/**
+ ****************************************************************************************
+ *
+ * @file gpu_shapes_test.c
+ *
+ * @brief Host check of the GPU arcs, lines and polygons against the LVGL software renderer
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run on the host, from the tools folder:
+ *      gcc -O2 -DLV_CONF_SKIP -DLV_COLOR_DEPTH=32 -DLV_LVGL_H_INCLUDE_SIMPLE -I../lvgl/lvgl -I../lvgl/lv_port \
+ *              -o gpu_shapes_test gpu_shapes_test.c $(find ../lvgl/lvgl/src -name '*.c') -lm && ./gpu_shapes_test
+ *
+ * LVGL is built with its default configuration, so lv_draw_arc(), lv_draw_line() and lv_draw_polygon() are the
+ * generic CPU versions. Each shape is drawn white on black by them and, from the geometry of
+ * lv_port_gpu_shape.h, by a model of the D/AVE2D primitives that samples every pixel on a 16x16 grid. The
+ * hardware itself is not modeled: the check catches wrong angles, radii, offsets and windings, not
+ * differences of the GPU anti-aliasing.
+ *
+ * A shape passes when both cover the same area within AREA_TOLERANCE, and no pixel is covered by one and
+ * missed by the other (coverage differing by more than PIXEL_TOLERANCE). The centers of both shapes must also be
+ * within CENTER_TOLERANCE, which catches shapes off by half a pixel.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl.h"
+#include "lv_port_gpu_shape.h"
+
+#define SIZE                    160
+#define SUBSAMPLES              16
+#define AREA_TOLERANCE          0.04
+#define PIXEL_TOLERANCE         192
+#define CENTER_TOLERANCE        0.2
+#define FAN_MAX                 8
+
+typedef enum {
+        PRIM_CIRCLE,
+        PRIM_WEDGE,
+        PRIM_LINE,
+        PRIM_TRIANGLE,
+} prim_type;
+
+/* A D/AVE2D primitive in pixels */
+typedef struct {
+        prim_type type;
+        double x[3], y[3];
+        double r, w;
+        double nx1, ny1, nx2, ny2;
+        bool concave;
+} prim;
+
+static lv_color_t frame[SIZE * SIZE];
+static uint8_t cpu_cov[SIZE * SIZE];
+static uint8_t gpu_cov[SIZE * SIZE];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static const lv_area_t clip = { 0, 0, SIZE - 1, SIZE - 1 };
+static int failures;
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+        LV_UNUSED(area);
+        LV_UNUSED(color_p);
+        lv_disp_flush_ready(drv);
+}
+
+static void display_init(void)
+{
+        lv_disp_t *disp;
+
+        lv_init();
+        lv_disp_draw_buf_init(&draw_buf, frame, NULL, SIZE * SIZE);
+        lv_disp_drv_init(&disp_drv);
+        disp_drv.hor_res = SIZE;
+        disp_drv.ver_res = SIZE;
+        disp_drv.draw_buf = &draw_buf;
+        disp_drv.flush_cb = flush_cb;
+        disp = lv_disp_drv_register(&disp_drv);
+
+        /* Draw straight into the frame as during a full refresh */
+        _lv_refr_set_disp_refreshing(disp);
+        draw_buf.area = clip;
+        draw_buf.buf_act = frame;
+}
+
+static void cpu_begin(void)
+{
+        for (int i = 0; i < SIZE * SIZE; i++) {
+                frame[i] = lv_color_black();
+        }
+}
+
+static void cpu_end(void)
+{
+        for (int i = 0; i < SIZE * SIZE; i++) {
+                cpu_cov[i] = frame[i].ch.green;
+        }
+}
+
+static bool prim_covers(const prim *p, double x, double y)
+{
+        switch (p->type) {
+        case PRIM_CIRCLE: {
+                double d = hypot(x - p->x[0], y - p->y[0]);
+
+                return p->w == 0 ? d <= p->r : fabs(d - p->r) <= p->w / 2;
+        }
+        case PRIM_WEDGE: {
+                double dx = x - p->x[0], dy = y - p->y[0];
+                bool h1 = dx * p->nx1 + dy * p->ny1 >= 0;
+                bool h2 = dx * p->nx2 + dy * p->ny2 >= 0;
+
+                if (fabs(hypot(dx, dy) - p->r) > p->w / 2) {
+                        return false;
+                }
+                return p->concave ? h1 || h2 : h1 && h2;
+        }
+        case PRIM_LINE: {
+                double lx = p->x[1] - p->x[0], ly = p->y[1] - p->y[0];
+                double len = hypot(lx, ly);
+                double t = ((x - p->x[0]) * lx + (y - p->y[0]) * ly) / len;
+                double n = ((x - p->x[0]) * ly - (y - p->y[0]) * lx) / len;
+
+                return t >= 0 && t <= len && fabs(n) <= p->w / 2;
+        }
+        case PRIM_TRIANGLE: {
+                double c[3];
+
+                for (int i = 0; i < 3; i++) {
+                        int j = (i + 1) % 3;
+
+                        c[i] = (p->x[j] - p->x[i]) * (y - p->y[i]) - (p->y[j] - p->y[i]) * (x - p->x[i]);
+                }
+                return (c[0] >= 0 && c[1] >= 0 && c[2] >= 0) || (c[0] <= 0 && c[1] <= 0 && c[2] <= 0);
+        }
+        }
+
+        return false;
+}
+
+/* Blend white primitives over the model frame as one anti-aliased shape, like the GPU draws a single primitive or
+ * primitives whose shared edges are not anti-aliased */
+static void gpu_render(const prim *p, int count)
+{
+        for (int y = 0; y < SIZE; y++) {
+                for (int x = 0; x < SIZE; x++) {
+                        int hits = 0;
+
+                        for (int sy = 0; sy < SUBSAMPLES; sy++) {
+                                for (int sx = 0; sx < SUBSAMPLES; sx++) {
+                                        for (int i = 0; i < count; i++) {
+                                                if (prim_covers(&p[i], x + (sx + 0.5) / SUBSAMPLES,
+                                                                y + (sy + 0.5) / SUBSAMPLES)) {
+                                                        hits++;
+                                                        break;
+                                                }
+                                        }
+                                }
+                        }
+                        if (hits) {
+                                int a = hits * 255 / (SUBSAMPLES * SUBSAMPLES);
+                                uint8_t *dst = &gpu_cov[y * SIZE + x];
+
+                                *dst = a + *dst * (255 - a) / 255;
+                        }
+                }
+        }
+}
+
+static void compare(const char *name)
+{
+        double cpu_area = 0, gpu_area = 0;
+        double cpu_x = 0, cpu_y = 0, gpu_x = 0, gpu_y = 0;
+        int bad = 0, bad_x = 0, bad_y = 0, max_diff = 0;
+        double area_error, center_error;
+
+        for (int i = 0; i < SIZE * SIZE; i++) {
+                int x = i % SIZE, y = i / SIZE;
+                int diff = abs(cpu_cov[i] - gpu_cov[i]);
+
+                cpu_area += cpu_cov[i] / 255.0;
+                gpu_area += gpu_cov[i] / 255.0;
+                cpu_x += x * cpu_cov[i] / 255.0;
+                cpu_y += y * cpu_cov[i] / 255.0;
+                gpu_x += x * gpu_cov[i] / 255.0;
+                gpu_y += y * gpu_cov[i] / 255.0;
+                if (diff > max_diff) {
+                        max_diff = diff;
+                }
+                if (diff > PIXEL_TOLERANCE && bad++ == 0) {
+                        bad_x = x;
+                        bad_y = y;
+                }
+        }
+
+        area_error = fabs(gpu_area - cpu_area);
+        center_error = cpu_area && gpu_area ? hypot(gpu_x / gpu_area - cpu_x / cpu_area,
+                                                    gpu_y / gpu_area - cpu_y / cpu_area) : 0;
+        if (bad || area_error > AREA_TOLERANCE * cpu_area || center_error > CENTER_TOLERANCE) {
+                printf("%-40s FAILED: area %.1f%%, center %.2f px, %d pixels differ (first at %d,%d)\n", name,
+                        100 * area_error / cpu_area, center_error, bad, bad_x, bad_y);
+                failures++;
+        } else {
+                printf("%-40s area %4.1f%%, center %.2f px, max pixel difference %3d\n", name,
+                        100 * area_error / cpu_area, center_error, max_diff);
+        }
+}
+
+static void test_arc(lv_coord_t cx, lv_coord_t cy, uint16_t radius, uint16_t start_angle, uint16_t end_angle,
+        lv_coord_t width, bool rounded)
+{
+        lv_draw_arc_dsc_t dsc;
+        lv_port_gpu_arc_shape arc;
+        lv_point_t center = { cx, cy };
+        char name[64];
+
+        lv_draw_arc_dsc_init(&dsc);
+        dsc.color = lv_color_white();
+        dsc.width = width;
+        dsc.rounded = rounded;
+
+        cpu_begin();
+        lv_draw_arc(cx, cy, radius, start_angle, end_angle, &clip, &dsc);
+        cpu_end();
+
+        /* The caller clamps the width like lv_draw_arc() */
+        lv_port_gpu_arc_shape_get(&arc, &center, radius, start_angle, end_angle, LV_MIN(width, radius));
+        memset(gpu_cov, 0, sizeof(gpu_cov));
+        if (arc.ring) {
+                prim p = { .type = PRIM_CIRCLE, .x = { arc.cx / 16.0 }, .y = { arc.cy / 16.0 }, .r = arc.r / 16.0,
+                           .w = arc.w / 16.0 };
+
+                gpu_render(&p, 1);
+        } else {
+                prim p = { .type = PRIM_WEDGE, .x = { arc.cx / 16.0 }, .y = { arc.cy / 16.0 }, .r = arc.r / 16.0,
+                           .w = arc.w / 16.0, .nx1 = arc.nx1, .ny1 = arc.ny1, .nx2 = arc.nx2, .ny2 = arc.ny2,
+                           .concave = arc.concave };
+
+                gpu_render(&p, 1);
+                for (int i = 0; rounded && i < 2; i++) {
+                        prim cap = { .type = PRIM_CIRCLE, .x = { arc.cap_x[i] / 16.0 },
+                                     .y = { arc.cap_y[i] / 16.0 }, .r = arc.w / 2 / 16.0 };
+
+                        gpu_render(&cap, 1);
+                }
+        }
+
+        snprintf(name, sizeof(name), "arc r%d w%d %d..%d%s", radius, width, start_angle, end_angle,
+                rounded ? " rounded" : "");
+        compare(name);
+}
+
+static void test_line(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2, lv_coord_t width)
+{
+        lv_draw_line_dsc_t dsc;
+        lv_port_gpu_line_shape line;
+        lv_point_t p1 = { x1, y1 }, p2 = { x2, y2 };
+        char name[64];
+
+        lv_draw_line_dsc_init(&dsc);
+        dsc.color = lv_color_white();
+        dsc.width = width;
+
+        cpu_begin();
+        lv_draw_line(&p1, &p2, &clip, &dsc);
+        cpu_end();
+
+        lv_port_gpu_line_shape_get(&line, &p1, &p2, width);
+        memset(gpu_cov, 0, sizeof(gpu_cov));
+        prim p = { .type = PRIM_LINE, .x = { line.x1 / 16.0, line.x2 / 16.0 }, .y = { line.y1 / 16.0, line.y2 / 16.0 },
+                   .w = line.w / 16.0 };
+        gpu_render(&p, 1);
+
+        snprintf(name, sizeof(name), "line %d,%d-%d,%d w%d", x1, y1, x2, y2, width);
+        compare(name);
+}
+
+static void test_polygon(const char *name, const lv_point_t *points, uint16_t point_cnt, int convexity)
+{
+        lv_draw_rect_dsc_t dsc;
+        prim fan[FAN_MAX];
+        lv_point_t max;
+
+        if (lv_port_gpu_polygon_convexity(points, point_cnt) != convexity) {
+                printf("%-40s FAILED: convexity is %d instead of %d\n", name,
+                        lv_port_gpu_polygon_convexity(points, point_cnt), convexity);
+                failures++;
+                return;
+        }
+        if (convexity <= 0) {
+                printf("%-40s left to the CPU\n", name);
+                return;
+        }
+
+        lv_draw_rect_dsc_init(&dsc);
+        dsc.bg_color = lv_color_white();
+
+        cpu_begin();
+        lv_draw_polygon(points, point_cnt, &clip, &dsc);
+        cpu_end();
+
+        /* The same triangle fan as lv_port_gpu_draw_polygon() */
+        lv_port_gpu_polygon_max_get(points, point_cnt, &max);
+        for (uint16_t i = 1; i + 1 < point_cnt; i++) {
+                prim *p = &fan[i - 1];
+                int32_t x, y;
+
+                memset(p, 0, sizeof(*p));
+                p->type = PRIM_TRIANGLE;
+                for (int j = 0; j < 3; j++) {
+                        lv_port_gpu_polygon_point_get(points, point_cnt, j ? i + j - 1 : 0, &max, &x, &y);
+                        p->x[j] = x / 16.0;
+                        p->y[j] = y / 16.0;
+                }
+        }
+        memset(gpu_cov, 0, sizeof(gpu_cov));
+        gpu_render(fan, point_cnt - 2);
+
+        compare(name);
+}
+
+int main(void)
+{
+        static const lv_point_t triangle_cw[] = { { 20, 20 }, { 140, 50 }, { 60, 130 } };
+        static const lv_point_t triangle_ccw[] = { { 20, 20 }, { 60, 130 }, { 140, 50 } };
+        static const lv_point_t pentagon[] = { { 80, 15 }, { 145, 62 }, { 120, 140 }, { 40, 140 }, { 15, 62 } };
+        static const lv_point_t box[] = { { 30, 40 }, { 130, 40 }, { 130, 120 }, { 30, 120 } };
+        static const lv_point_t needle[] = { { 78, 80 }, { 80, 10 }, { 82, 80 }, { 80, 90 } };
+        static const lv_point_t concave[] = { { 20, 20 }, { 140, 20 }, { 80, 60 }, { 140, 140 }, { 20, 140 } };
+        static const lv_point_t collinear[] = { { 20, 20 }, { 80, 80 }, { 140, 140 } };
+
+        display_init();
+
+        test_arc(80, 80, 70, 0, 360, 10, false);
+        test_arc(80, 80, 70, 0, 90, 10, false);
+        test_arc(80, 80, 70, 45, 300, 10, false);
+        test_arc(80, 80, 70, 270, 30, 16, false);
+        test_arc(80, 80, 70, 350, 10, 8, false);
+        test_arc(80, 80, 70, 10, 190, 8, false);
+        test_arc(80, 80, 50, 135, 45, 20, false);
+        test_arc(80, 80, 40, 20, 160, 40, false);
+        test_arc(80, 80, 70, 120, 400, 12, false);
+        test_arc(80, 80, 70, 30, 150, 14, true);
+        test_arc(80, 80, 60, 200, 100, 20, true);
+
+        test_line(10, 20, 150, 60, 1);
+        test_line(10, 20, 150, 60, 4);
+        test_line(150, 60, 10, 20, 4);
+        test_line(20, 150, 60, 10, 7);
+        test_line(30, 30, 130, 130, 10);
+        test_line(140, 20, 20, 140, 3);
+        test_line(15, 80, 145, 90, 12);
+
+        test_polygon("triangle clockwise", triangle_cw, 3, 1);
+        test_polygon("triangle counter-clockwise", triangle_ccw, 3, 1);
+        test_polygon("pentagon", pentagon, 5, 1);
+        test_polygon("needle", needle, 4, 1);
+        test_polygon("box", box, 4, 1);
+        test_polygon("concave", concave, 5, -1);
+        test_polygon("collinear", collinear, 3, 0);
+
+        printf("%s\n", failures ? "FAILED" : "passed");
+
+        return failures ? 1 : 0;
+}
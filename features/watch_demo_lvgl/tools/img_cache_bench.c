@@ -0,0 +1,208 @@
+/**
+ ****************************************************************************************
+ *
+ * @file img_cache_bench.c
+ *
+ * @brief Host benchmark of the RLE decoder of the image cache over the packed bitmaps
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run on the host, from the tools folder:
+ *      python res_pack_build.py -o pack.bin ../ui/demo/resources/resources.manifest
+ *      gcc -O2 -DLV_CONF_INCLUDE_SIMPLE -DLV_LVGL_H_INCLUDE_SIMPLE -DLV_COLOR_DEPTH=16 -Igpu_mock -I../gdi/inc \
+ *              -I../lvgl/lvgl -I../lvgl/lv_port -I../ui/demo/resources -o img_cache_bench img_cache_bench.c \
+ *              ../ui/demo/resources/res_pack.c gpu_mock/d2_mock.c $(find ../lvgl/lvgl/src -name '*.c') -lm
+ *      ./img_cache_bench pack.bin
+ *
+ * Every RLE bitmap of the pack is decoded by lv_port_img_cache_decode(), the decoder that fills the image cache,
+ * and the result is checked for size. For each bitmap the flash saved by RLE is printed next to the time of one
+ * decode, and the decode time next to a plain copy of the decoded bitmap, the cost of reading it uncompressed.
+ * LV_COLOR_DEPTH must match the --color-depth of the pack. The times are on the host: they compare the
+ * bitmaps and the two reads with each other, not the cycles of the M33 reading from QSPI flash.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "res_pack.h"
+
+/* SDK definitions used by lv_port_img_cache.c. The content of gdi.h is skipped, the cache only needs a heap */
+#define GDI_H_
+#define PRIVILEGED_DATA
+#define GDI_GUI_HEAP_SIZE               (64 * 1024)
+
+static uint8_t gui_heap[GDI_GUI_HEAP_SIZE];
+
+static void *gdi_get_gui_heap_addr(void)
+{
+        return gui_heap;
+}
+
+#include "lv_port_img_cache.c"
+
+/* Each bitmap is decoded until this much time has passed */
+#define MIN_TIME_NS             (50 * 1000 * 1000)
+
+static int failures;
+
+#define CHECK(cond)                                                                     \
+        do {                                                                            \
+                if (!(cond)) {                                                          \
+                        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+                        failures++;                                                     \
+                }                                                                       \
+        } while (0)
+
+static uint8_t *load_file(const char *path, long *size)
+{
+        FILE *f = fopen(path, "rb");
+        uint8_t *data;
+
+        if (f == NULL) {
+                return NULL;
+        }
+        fseek(f, 0, SEEK_END);
+        *size = ftell(f);
+        rewind(f);
+        data = malloc(*size);
+        if (data && fread(data, 1, *size, f) != (size_t)*size) {
+                free(data);
+                data = NULL;
+        }
+        fclose(f);
+
+        return data;
+}
+
+static double now_ns(void)
+{
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Time of one decode of img into dst, in ns */
+static double time_decode(const lv_img_dsc_t *img, uint8_t *dst, uint32_t size)
+{
+        double start = now_ns(), elapsed;
+        long rounds = 0;
+
+        do {
+                if (!lv_port_img_cache_decode(img, dst, size)) {
+                        return -1;
+                }
+                rounds++;
+                elapsed = now_ns() - start;
+        } while (elapsed < MIN_TIME_NS);
+
+        return elapsed / rounds;
+}
+
+/* Time of one copy of size bytes, in ns */
+static double time_copy(uint8_t *dst, const uint8_t *src, uint32_t size)
+{
+        double start = now_ns(), elapsed;
+        long rounds = 0;
+
+        do {
+                lv_memcpy(dst, src, size);
+                /* Keep the copies from being merged */
+                __asm__ volatile("" : : "r"(dst) : "memory");
+                rounds++;
+                elapsed = now_ns() - start;
+        } while (elapsed < MIN_TIME_NS);
+
+        return elapsed / rounds;
+}
+
+int main(int argc, char *argv[])
+{
+        uint8_t *data;
+        long size;
+        res_pack_t pack;
+        uint32_t total_raw = 0, total_rle = 0;
+        double total_decode = 0, total_copy = 0;
+        int count = 0;
+
+        if (argc != 2) {
+                printf("Usage: %s <pack.bin>\n", argv[0]);
+                return 2;
+        }
+
+        data = load_file(argv[1], &size);
+        if (data == NULL || !res_pack_open(&pack, data)) {
+                printf("Cannot read %s\n", argv[1]);
+                return 2;
+        }
+
+        printf("%-10s %6s %10s %10s %7s %12s %12s %8s\n", "hash", "size", "decoded", "stored", "ratio",
+                "decode [us]", "copy [us]", "MB/s");
+
+        for (int i = 0; i < pack.header->entry_count; i++) {
+                const res_pack_entry_t *entry = &pack.index[i];
+                lv_img_dsc_t img;
+                uint32_t decoded_size;
+                uint8_t *dst;
+                double decode_ns, copy_ns;
+
+                memcpy(&img.header, &entry->format, sizeof(img.header));
+                if (!img.header.rle) {
+                        continue;
+                }
+                img.data = res_pack_data(&pack, entry);
+                img.data_size = entry->size;
+                decoded_size = img.header.w * img.header.h * lv_img_cf_get_px_size(img.header.cf) / 8;
+
+                dst = malloc(decoded_size);
+                decode_ns = time_decode(&img, dst, decoded_size);
+                CHECK(decode_ns >= 0);
+                copy_ns = time_copy(dst, img.data, LV_MIN(decoded_size, entry->size));
+                /* Uncompressed, the bitmap is read once from flash at its full size */
+                copy_ns = copy_ns * decoded_size / LV_MIN(decoded_size, entry->size);
+                free(dst);
+
+                printf("0x%08x %3dx%-3d %10u %10u %6.1f%% %12.1f %12.1f %8.1f\n", entry->name_hash,
+                        img.header.w, img.header.h, decoded_size, entry->size, 100.0 * entry->size / decoded_size,
+                        decode_ns / 1000, copy_ns / 1000, decoded_size / decode_ns * 1000);
+
+                total_raw += decoded_size;
+                total_rle += entry->size;
+                total_decode += decode_ns;
+                total_copy += copy_ns;
+                count++;
+        }
+
+        CHECK(count > 0);
+        if (count) {
+                printf("%d RLE bitmaps: %u bytes of flash saved (%.1f%%), decoded in %.1f us at %.1f MB/s, "
+                        "%.1fx the time of a copy\n", count, total_raw - total_rle,
+                        100.0 * (total_raw - total_rle) / total_raw, total_decode / 1000,
+                        total_raw / total_decode * 1000, total_decode / total_copy);
+        }
+        printf("%s\n", failures ? "FAILED" : "passed");
+        free(data);
+
+        return failures ? 1 : 0;
+}
@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+#
+# Replays invalidated area traces through the LVGL area handling of the watch
+# demo and compares the legacy join (overlapping areas only) with the cost based
+# join of DLG_LVGL_INV_AREA_COST_JOIN for a range of flush overheads.
+#
+# A trace holds one refresh period per line, every area is given as
+# 'x1,y1,x2,y2' in layer coordinates and areas are separated by spaces. Lines
+# starting with '#' are ignored. Without a trace file the rotating hands of the
+# watch face are simulated.
+#
+# Usage: inv_area_sim.py [--res W H] [--align N] [--overhead PX [PX ...]] [trace]
+#
+
+import argparse
+import math
+import sys
+
+LV_INV_BUF_SIZE = 32
+
+
+def size(a):
+        return (a[2] - a[0] + 1) * (a[3] - a[1] + 1)
+
+
+def join(a, b):
+        return (min(a[0], b[0]), min(a[1], b[1]), max(a[2], b[2]), max(a[3], b[3]))
+
+
+def is_in(a, holder):
+        return a[0] >= holder[0] and a[1] >= holder[1] and a[2] <= holder[2] and a[3] <= holder[3]
+
+
+def is_on(a, b):
+        return not (a[0] > b[2] or b[0] > a[2] or a[1] > b[3] or b[1] > a[3])
+
+
+class Display:
+        def __init__(self, res, align):
+                self.res = res
+                self.align = align
+
+        def rounder(self, a):
+                """ Start and size of the area are multiples of 'align', as the panel requires """
+                x1 = a[0] - a[0] % self.align
+                y1 = a[1] - a[1] % self.align
+                x2 = a[2] + (self.align - 1 - (a[2] - x1) % self.align)
+                y2 = a[3] + (self.align - 1 - (a[3] - y1) % self.align)
+                return (x1, y1, min(x2, self.res[0] - 1), min(y2, self.res[1] - 1))
+
+        def invalidate(self, areas, a, cost_join):
+                """ Mirrors _lv_inv_area() """
+                a = (max(a[0], 0), max(a[1], 0), min(a[2], self.res[0] - 1), min(a[3], self.res[1] - 1))
+                if a[0] > a[2] or a[1] > a[3]:
+                        return
+                a = self.rounder(a)
+                if any(is_in(a, saved) for saved in areas):
+                        return
+                if len(areas) < LV_INV_BUF_SIZE:
+                        areas.append(a)
+                elif cost_join:
+                        best = min(range(len(areas)), key=lambda i: size(join(areas[i], a)) - size(areas[i]))
+                        areas[best] = self.rounder(join(areas[best], a))
+                else:
+                        areas[:] = [(0, 0, self.res[0] - 1, self.res[1] - 1)]
+
+        def join_legacy(self, areas):
+                """ Mirrors the original lv_refr_join_area() """
+                joined = [False] * len(areas)
+                for i in range(len(areas)):
+                        if joined[i]:
+                                continue
+                        for j in range(len(areas)):
+                                if joined[j] or i == j or not is_on(areas[i], areas[j]):
+                                        continue
+                                u = join(areas[i], areas[j])
+                                if size(u) < size(areas[i]) + size(areas[j]):
+                                        areas[i] = u
+                                        joined[j] = True
+                return [a for a, j in zip(areas, joined) if not j]
+
+        def join_cost(self, areas, overhead):
+                """ Mirrors lv_refr_join_area() with DLG_LVGL_INV_AREA_COST_JOIN """
+                areas = list(areas)
+                while True:
+                        best = (0, None, None)
+                        for i in range(len(areas)):
+                                for j in range(i + 1, len(areas)):
+                                        saving = size(areas[i]) + size(areas[j]) + overhead - \
+                                                size(join(areas[i], areas[j]))
+                                        if saving > best[0]:
+                                                best = (saving, i, j)
+                        if best[1] is None:
+                                return areas
+                        areas[best[1]] = self.rounder(join(areas[best[1]], areas[best[2]]))
+                        del areas[best[2]]
+
+
+def parse_trace(f):
+        for line in f:
+                line = line.strip()
+                if not line or line.startswith('#'):
+                        continue
+                yield [tuple(int(v) for v in a.split(',')) for a in line.split()]
+
+
+def hand_area(center, w, h, angle):
+        """ Bounding box of a hand of w x h pixels rotated around the middle of its bottom edge """
+        rad = math.radians(angle)
+        xs, ys = [], []
+        for x, y in ((-w / 2, 0), (w / 2, 0), (-w / 2, -h), (w / 2, -h)):
+                xs.append(center[0] + x * math.cos(rad) - y * math.sin(rad))
+                ys.append(center[1] + x * math.sin(rad) + y * math.cos(rad))
+        return (math.floor(min(xs)) - 1, math.floor(min(ys)) - 1, math.ceil(max(xs)) + 1, math.ceil(max(ys)) + 1)
+
+
+def watch_face_trace(res, seconds, steps):
+        """ The watch face updates the second hand 'steps' times per second and the
+        minute and hour hands once per second, see lv_DrawClock() """
+        center = (res[0] // 2, res[1] // 2)
+        hands = ((16, 111, 1 / 120), (8, 155, 1 / 10), (4, 143, 6))
+        prev = None
+        for n in range(seconds * steps):
+                t = n / steps
+                cur = [hand_area(center, w, h, round(t * speed * 10 if i == 2 else int(t) * speed * 10) / 10)
+                       for i, (w, h, speed) in enumerate(hands)]
+                if prev:
+                        yield [a for p, c in zip(prev, cur) if p != c for a in (p, c)]
+                prev = cur
+
+
+def simulate(disp, frames, overhead, cost_join):
+        flushes = 0
+        pixels = 0
+        for frame in frames:
+                areas = []
+                for a in frame:
+                        disp.invalidate(areas, a, cost_join)
+                if cost_join:
+                        areas = disp.join_cost(areas, overhead)
+                else:
+                        areas = disp.join_legacy(areas)
+                flushes += len(areas)
+                pixels += sum(size(a) for a in areas)
+        return flushes, pixels
+
+
+def main():
+        parser = argparse.ArgumentParser(description='Compare invalidated area joins on a trace')
+        parser.add_argument('trace', nargs='?', help='trace file, the watch face is simulated if omitted')
+        parser.add_argument('--res', nargs=2, type=int, default=(390, 390), metavar=('W', 'H'))
+        parser.add_argument('--align', type=int, default=2, help='panel alignment of partial updates')
+        parser.add_argument('--overhead', nargs='+', type=int, default=(0, 390, 1560, 3900),
+                            help='flush overheads in pixels to evaluate')
+        parser.add_argument('--seconds', type=int, default=60, help='simulated watch face seconds')
+        parser.add_argument('--steps', type=int, default=12, help='second hand updates per second')
+        args = parser.parse_args()
+
+        disp = Display(tuple(args.res), args.align)
+        if args.trace:
+                with open(args.trace) as f:
+                        frames = list(parse_trace(f))
+        else:
+                frames = list(watch_face_trace(disp.res, args.seconds, args.steps))
+
+        print('{} frames'.format(len(frames)))
+        print('{:>10} {:>10} {:>10} {:>12} {:>14}'.format('join', 'overhead', 'flushes', 'pixels', 'cost'))
+        for overhead in args.overhead:
+                for name, cost_join in (('legacy', False), ('cost', True)):
+                        flushes, pixels = simulate(disp, frames, overhead, cost_join)
+                        print('{:>10} {:>10} {:>10} {:>12} {:>14}'.format(name, overhead, flushes, pixels,
+                                                                          pixels + flushes * overhead))
+        return 0
+
+
+if __name__ == '__main__':
+        sys.exit(main())
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+#
+# Converts the sub-byte pixel data of an LVGL binary image (*.bin) from the
+# LVGL bit order (first pixel in the most significant bits) to the D/AVE2D
+# bit order (first pixel in the least significant bits) and sets the
+# native_order bit of the image header. Images converted this way are blitted
+# without the runtime reordering pass of lv_port_gpu.c when
+# LV_PORT_DISP_GPU_SUB_BYTE_SWAP is enabled.
+#
+# Usage: lv_img_native_order.py <input.bin> <output.bin>
+#
+
+import struct
+import sys
+
+# lv_img_cf_t values of the supported formats: (bpp, palette entries)
+CF_SUB_BYTE = {
+        7:  (1, 2),     # LV_IMG_CF_INDEXED_1BIT
+        8:  (2, 4),     # LV_IMG_CF_INDEXED_2BIT
+        9:  (4, 16),    # LV_IMG_CF_INDEXED_4BIT
+        11: (1, 0),     # LV_IMG_CF_ALPHA_1BIT
+        12: (2, 0),     # LV_IMG_CF_ALPHA_2BIT
+        13: (4, 0),     # LV_IMG_CF_ALPHA_4BIT
+}
+
+HEADER_RLE_BIT = 1 << 8
+HEADER_NATIVE_ORDER_BIT = 1 << 9
+
+
+def reverse_pixels(byte, bpp):
+        mask = (1 << bpp) - 1
+        out = 0
+        for i in range(0, 8, bpp):
+                out |= ((byte >> i) & mask) << (8 - bpp - i)
+        return out
+
+
+def convert(data):
+        header, = struct.unpack_from('<I', data)
+        cf = header & 0x1F
+
+        if cf not in CF_SUB_BYTE:
+                raise ValueError('color format %d is not a sub-byte format' % cf)
+        if header & HEADER_RLE_BIT:
+                raise ValueError('RLE encoded images are not supported')
+        if header & HEADER_NATIVE_ORDER_BIT:
+                return data
+
+        bpp, palette_len = CF_SUB_BYTE[cf]
+        w = (header >> 10) & 0x7FF
+        h = (header >> 21) & 0x7FF
+        start = 4 + palette_len * 4
+        end = start + ((w * bpp + 7) // 8) * h
+
+        if len(data) < end:
+                raise ValueError('image data is truncated')
+
+        table = bytes(reverse_pixels(b, bpp) for b in range(256))
+        pixels = data[start:end].translate(table)
+
+        return struct.pack('<I', header | HEADER_NATIVE_ORDER_BIT) + data[4:start] + pixels + data[end:]
+
+
+def main(argv):
+        if len(argv) != 3:
+                sys.stderr.write('Usage: %s <input.bin> <output.bin>\n' % argv[0])
+                return 1
+
+        with open(argv[1], 'rb') as f:
+                data = f.read()
+
+        try:
+                data = convert(data)
+        except ValueError as e:
+                sys.stderr.write('%s: %s\n' % (argv[1], e))
+                return 1
+
+        with open(argv[2], 'wb') as f:
+                f.write(data)
+
+        return 0
+
+
+if __name__ == '__main__':
+        sys.exit(main(sys.argv))
@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+#
+# Builds a resource pack (see ui/demo/resources/res_pack.h) out of LVGL binary
+# images listed in a manifest. The data of every entry is aligned so that XIP
+# reads of a bitmap start on a QSPI cache line, and entries of the same group
+# are stored contiguously in manifest order.
+#
+# Entries whose format carries the ':rle' suffix are stored compressed in the
+# D/AVE2D RLE format if that makes them smaller. The GPU reads them directly.
+#
+# Usage: res_pack_build.py [--align N] [--color-depth 16|32] [--stats] -o <pack.bin> <manifest>
+#
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+RES_PACK_MAGIC = 0x50524457
+RES_PACK_VERSION = 1
+HEADER_FORMAT = '<IHHHHIIIII'
+ENTRY_FORMAT = '<IIIIIHH'
+
+LV_IMG_HEADER_SIZE = 4
+HEADER_RLE_BIT = 1 << 8
+
+# lv_img_cf_t values, the format given in the manifest overrides the one of the image header
+FORMATS = {
+        'TRUE_COLOR': 4, 'TRUE_COLOR_ALPHA': 5, 'TRUE_COLOR_CHROMA_KEYED': 6,
+        'INDEXED_1BIT': 7, 'INDEXED_2BIT': 8, 'INDEXED_4BIT': 9, 'INDEXED_8BIT': 10,
+        'ALPHA_1BIT': 11, 'ALPHA_2BIT': 12, 'ALPHA_4BIT': 13, 'ALPHA_8BIT': 14,
+        'AI44': 23, 'ARGB8888': 24, 'ARGB4444': 25, 'ARGB1555': 26,
+        'RGBA8888': 27, 'RGBA4444': 28, 'RGBA5551': 29, 'RGB888': 30, 'RGB565': 31,
+}
+
+
+def fnv1a(name):
+        h = 0x811C9DC5
+        for c in name.encode('ascii'):
+                h = ((h ^ c) * 0x01000193) & 0xFFFFFFFF
+        return h
+
+
+def bits_per_pixel(cf, color_depth):
+        """Returns (bits per pixel, palette bytes) of an lv_img_cf_t value."""
+        true_color = {
+                4: color_depth,                 # LV_IMG_CF_TRUE_COLOR
+                5: color_depth + 8 if color_depth != 32 else 32,        # LV_IMG_CF_TRUE_COLOR_ALPHA
+                6: color_depth,                 # LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED
+                23: 8,                          # LV_IMG_CF_AI44
+                24: 32, 25: 16, 26: 16,         # LV_IMG_CF_ARGB8888/4444/1555
+                27: 32, 28: 16, 29: 16,         # LV_IMG_CF_RGBA8888/4444/5551
+                30: 24, 31: 16,                 # LV_IMG_CF_RGB888/565
+        }
+        if cf in true_color:
+                return true_color[cf], 64 if cf == 23 else 0
+        if 7 <= cf <= 10:                       # LV_IMG_CF_INDEXED_xBIT
+                bpp = (1, 2, 4, 8)[cf - 7]
+                return bpp, 4 << bpp
+        if 11 <= cf <= 14:                      # LV_IMG_CF_ALPHA_xBIT
+                return (1, 2, 4, 8)[cf - 11], 0
+        raise ValueError('unsupported color format %d' % cf)
+
+
+def rle_encode(data, px_size):
+        """Encodes pixels into D/AVE2D RLE packets. A packet header holds the pixel count - 1 in its
+        lower 7 bits and has the MSB set if the pixel following it is repeated. Packets are not
+        split at line ends."""
+        pixels = [data[i:i + px_size] for i in range(0, len(data), px_size)]
+        out = bytearray()
+        literal = []
+        i = 0
+
+        def flush_literal():
+                while literal:
+                        chunk = literal[:128]
+                        del literal[:128]
+                        out.append(len(chunk) - 1)
+                        out.extend(b''.join(chunk))
+
+        while i < len(pixels):
+                run = 1
+                while i + run < len(pixels) and run < 128 and pixels[i + run] == pixels[i]:
+                        run += 1
+                if run > 1:
+                        flush_literal()
+                        out.append(0x80 | (run - 1))
+                        out.extend(pixels[i])
+                else:
+                        literal.append(pixels[i])
+                i += run
+        flush_literal()
+
+        return bytes(out)
+
+
+def load_image(path, offset, size, cf, color_depth):
+        with open(path, 'rb') as f:
+                f.seek(offset)
+                header_raw = f.read(LV_IMG_HEADER_SIZE)
+                if len(header_raw) != LV_IMG_HEADER_SIZE:
+                        raise ValueError('%s@0x%x: no image header' % (path, offset))
+                header, = struct.unpack('<I', header_raw)
+                header = (header & ~0x1F) | cf
+
+                if size is None:
+                        if header & HEADER_RLE_BIT:
+                                raise ValueError('%s@0x%x: the size of RLE images must be given' % (path, offset))
+                        w = (header >> 10) & 0x7FF
+                        h = (header >> 21) & 0x7FF
+                        bpp, palette = bits_per_pixel(cf, color_depth)
+                        size = palette + ((w * bpp + 7) // 8) * h
+                        header &= ~HEADER_RLE_BIT
+                else:
+                        size -= LV_IMG_HEADER_SIZE
+
+                data = f.read(size)
+                if len(data) != size:
+                        raise ValueError('%s@0x%x: image data is truncated' % (path, offset))
+
+        return header, data
+
+
+def parse_manifest(path):
+        entries = []
+        base = os.path.dirname(path)
+
+        with open(path) as f:
+                for line_no, line in enumerate(f, 1):
+                        line = line.split('#', 1)[0].strip()
+                        if not line:
+                                continue
+                        fields = line.split()
+                        if len(fields) != 4:
+                                raise ValueError('%s:%d: expected <group> <name> <format> <file>' % (path, line_no))
+                        group, name, fmt, src = fields
+                        rle = fmt.endswith(':rle')
+                        if rle:
+                                fmt = fmt[:-len(':rle')]
+                        if fmt not in FORMATS:
+                                raise ValueError('%s:%d: unknown format %s' % (path, line_no, fmt))
+                        offset, size = 0, None
+                        if '@' in src:
+                                src, loc = src.split('@', 1)
+                                if '+' in loc:
+                                        loc, size = loc.split('+', 1)
+                                        size = int(size, 0)
+                                offset = int(loc, 0)
+                        entries.append((group, name, FORMATS[fmt], rle, os.path.join(base, src), offset, size))
+
+        return entries
+
+
+def build(entries, alignment, color_depth):
+        groups = []
+        resources = []
+        hashes = {}
+
+        for group, name, cf, rle, src, offset, size in entries:
+                h = fnv1a(name)
+                if h in hashes:
+                        raise ValueError('name hash of %s collides with %s' % (name, hashes[h]))
+                hashes[h] = name
+                if group not in groups:
+                        groups.append(group)
+                header, data = load_image(src, offset, size, cf, color_depth)
+                raw_size = len(data)
+                if rle and not header & HEADER_RLE_BIT:
+                        bpp, palette = bits_per_pixel(cf, color_depth)
+                        if bpp < 8 or palette:
+                                raise ValueError('%s: RLE needs a format of 8 bits per pixel or more' % name)
+                        encoded = rle_encode(data, bpp // 8)
+                        if len(encoded) < len(data):
+                                header |= HEADER_RLE_BIT
+                                data = encoded
+                resources.append((groups.index(group), name, h, header, data, raw_size))
+
+        # Keep the data of a screen together, in manifest order within a group
+        resources.sort(key=lambda r: r[0])
+
+        header_size = struct.calcsize(HEADER_FORMAT)
+        entry_size = struct.calcsize(ENTRY_FORMAT)
+        index_offset = header_size
+        data_offset = index_offset + entry_size * len(resources)
+        data_offset = (data_offset + alignment - 1) // alignment * alignment
+
+        data = bytearray()
+        index = []
+        for group, name, h, header, payload, raw_size in resources:
+                pad = -(data_offset + len(data)) % alignment
+                data += b'\xff' * pad
+                offset = data_offset + len(data)
+                data += payload
+                index.append((h, offset, len(payload), zlib.crc32(payload), header, group, 0))
+
+        index.sort(key=lambda e: e[0])
+        index_raw = b''.join(struct.pack(ENTRY_FORMAT, *e) for e in index)
+
+        total_size = data_offset + len(data)
+        pack = bytearray(struct.pack(HEADER_FORMAT, RES_PACK_MAGIC, RES_PACK_VERSION, len(index),
+                                     entry_size, alignment, index_offset, data_offset, total_size,
+                                     zlib.crc32(index_raw), 0))
+        pack += index_raw
+        pack += b'\xff' * (data_offset - len(pack))
+        pack += data
+
+        return pack, resources, groups
+
+
+def main(argv):
+        parser = argparse.ArgumentParser(description='Build a watch demo resource pack')
+        parser.add_argument('manifest')
+        parser.add_argument('-o', '--output', required=True)
+        parser.add_argument('--align', type=int, default=32,
+                            help='data alignment in bytes, a multiple of the QSPI cache line (default: 32)')
+        parser.add_argument('--stats', action='store_true',
+                            help='print the stored size and compression ratio of every entry')
+        parser.add_argument('--color-depth', type=int, default=16, choices=(16, 32),
+                            help='LV_COLOR_DEPTH used for LV_IMG_CF_TRUE_COLOR images (default: 16)')
+        args = parser.parse_args(argv[1:])
+
+        if args.align < 4 or args.align & (args.align - 1):
+                sys.stderr.write('alignment must be a power of two, at least 4\n')
+                return 1
+
+        try:
+                pack, resources, groups = build(parse_manifest(args.manifest), args.align, args.color_depth)
+        except (ValueError, OSError) as e:
+                sys.stderr.write('%s\n' % e)
+                return 1
+
+        with open(args.output, 'wb') as f:
+                f.write(pack)
+
+        if args.stats:
+                for group, name, h, header, payload, raw_size in resources:
+                        print('%-10s %-24s %8d -> %8d bytes (%5.1f%%)%s' % (groups[group], name, raw_size, len(payload),
+                              100.0 * len(payload) / raw_size, ' rle' if header & HEADER_RLE_BIT else ''))
+
+        print('%s: %d resources in %d groups, %d bytes' % (args.output, len(resources), len(groups), len(pack)))
+
+        return 0
+
+
+if __name__ == '__main__':
+        sys.exit(main(sys.argv))
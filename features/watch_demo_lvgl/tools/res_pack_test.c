@@ -0,0 +1,285 @@
+/**
+ ****************************************************************************************
+ *
+ * @file res_pack_test.c
+ *
+ * @brief Host test of the resource pack lookups against a pack built by res_pack_build.py
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run on the host, from the tools folder:
+ *      python res_pack_build.py -o pack.bin ../ui/demo/resources/resources.manifest
+ *      gcc -Wall -Wextra -O2 -I../ui/demo/resources -o res_pack_test res_pack_test.c ../ui/demo/resources/res_pack.c
+ *      ./res_pack_test pack.bin ../ui/demo/resources/resources.manifest ../ui/demo/resources/Resources.c
+ *
+ * Every resource of the manifest must be found with a valid CRC and aligned data, the data of a group must
+ * be contiguous, and every bitmap that Resources.c looks up must be in the manifest. Unknown names must not
+ * be found, and a damaged header, index or bitmap must be rejected.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "res_pack.h"
+
+#define NAME_MAX_LEN            64
+#define NAMES_MAX               64
+
+typedef struct {
+        char group[NAME_MAX_LEN];
+        char name[NAME_MAX_LEN];
+} manifest_entry;
+
+static manifest_entry manifest[NAMES_MAX];
+static int manifest_count;
+static int failures;
+
+#define CHECK(cond)                                                                     \
+        do {                                                                            \
+                if (!(cond)) {                                                          \
+                        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+                        failures++;                                                     \
+                }                                                                       \
+        } while (0)
+
+static uint8_t *load_file(const char *path, long *size)
+{
+        FILE *f = fopen(path, "rb");
+        uint8_t *data;
+
+        if (f == NULL) {
+                return NULL;
+        }
+        fseek(f, 0, SEEK_END);
+        *size = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        data = malloc(*size);
+        if (data && fread(data, 1, *size, f) != (size_t)*size) {
+                free(data);
+                data = NULL;
+        }
+        fclose(f);
+
+        return data;
+}
+
+static bool load_manifest(const char *path)
+{
+        FILE *f = fopen(path, "r");
+        char line[256];
+
+        if (f == NULL) {
+                return false;
+        }
+        while (fgets(line, sizeof(line), f) && manifest_count < NAMES_MAX) {
+                char *comment = strchr(line, '#');
+
+                if (comment) {
+                        *comment = '\0';
+                }
+                if (sscanf(line, "%63s %63s", manifest[manifest_count].group, manifest[manifest_count].name) == 2) {
+                        manifest_count++;
+                }
+        }
+        fclose(f);
+
+        return manifest_count > 0;
+}
+
+static int manifest_find(const char *name)
+{
+        for (int i = 0; i < manifest_count; i++) {
+                if (strcmp(manifest[i].name, name) == 0) {
+                        return i;
+                }
+        }
+
+        return -1;
+}
+
+static void test_lookups(const res_pack_t *pack)
+{
+        const res_pack_header_t *header = pack->header;
+        int group_last_entry[NAMES_MAX];
+
+        CHECK(header->entry_count == manifest_count);
+
+        for (int i = 0; i < manifest_count; i++) {
+                const res_pack_entry_t *entry = res_pack_find(pack, manifest[i].name);
+
+                if (entry == NULL) {
+                        printf("%s: not found\n", manifest[i].name);
+                        failures++;
+                        continue;
+                }
+                CHECK(entry->name_hash == res_pack_hash(manifest[i].name));
+                CHECK(entry->offset >= header->data_offset);
+                CHECK(entry->offset % header->alignment == 0);
+                CHECK(entry->offset + entry->size <= header->size);
+                CHECK(res_pack_data(pack, entry) == pack->base + entry->offset);
+                if (!res_pack_verify(pack, entry)) {
+                        printf("%s: CRC mismatch\n", manifest[i].name);
+                        failures++;
+                }
+        }
+
+        /* Walk the data in pack order, a group must not resume once another one started */
+        for (int i = 0; i < NAMES_MAX; i++) {
+                group_last_entry[i] = -1;
+        }
+        for (uint32_t offset = header->data_offset, previous = 0; ; ) {
+                const res_pack_entry_t *next = NULL;
+
+                for (int i = 0; i < header->entry_count; i++) {
+                        const res_pack_entry_t *entry = &pack->index[i];
+
+                        if (entry->offset >= offset && (next == NULL || entry->offset < next->offset)) {
+                                next = entry;
+                        }
+                }
+                if (next == NULL) {
+                        break;
+                }
+                CHECK(next->group < NAMES_MAX);
+                if (next->group < NAMES_MAX) {
+                        CHECK(group_last_entry[next->group] == -1 || next->group == previous);
+                        group_last_entry[next->group] = next - pack->index;
+                        previous = next->group;
+                }
+                offset = next->offset + next->size;
+                if (next->size == 0) {
+                        offset++;
+                }
+        }
+
+        CHECK(res_pack_find(pack, "") == NULL);
+        CHECK(res_pack_find(pack, "no_such_bitmap") == NULL);
+        CHECK(res_pack_find(pack, "Clock_bg") == NULL);
+}
+
+static void test_firmware_names(const char *path)
+{
+        FILE *f = fopen(path, "r");
+        char line[256];
+        int count = 0;
+
+        CHECK(f != NULL);
+        if (f == NULL) {
+                return;
+        }
+        /* Entries of resource_table[] look like: { "clock_bg", &clock_bg }, */
+        while (fgets(line, sizeof(line), f)) {
+                char name[NAME_MAX_LEN];
+
+                if (sscanf(line, " { \"%63[^\"]\"", name) == 1) {
+                        count++;
+                        if (manifest_find(name) < 0) {
+                                printf("%s: used by Resources.c but not in the manifest\n", name);
+                                failures++;
+                        }
+                }
+        }
+        fclose(f);
+
+        CHECK(count > 0);
+}
+
+static void test_damaged(const uint8_t *data, long size)
+{
+        uint8_t *copy = malloc(size);
+        const res_pack_header_t *header = (const res_pack_header_t *)data;
+        res_pack_header_t *copy_header = (res_pack_header_t *)copy;
+        res_pack_t pack;
+
+        /* Magic, version, index CRC and index bounds are checked when the pack is opened */
+        memcpy(copy, data, size);
+        copy_header->magic ^= 1;
+        CHECK(!res_pack_open(&pack, copy));
+        CHECK(res_pack_find(&pack, manifest[0].name) == NULL);
+
+        memcpy(copy, data, size);
+        copy_header->version++;
+        CHECK(!res_pack_open(&pack, copy));
+
+        memcpy(copy, data, size);
+        copy_header->entry_size--;
+        CHECK(!res_pack_open(&pack, copy));
+
+        memcpy(copy, data, size);
+        copy_header->size = header->index_offset;
+        CHECK(!res_pack_open(&pack, copy));
+
+        memcpy(copy, data, size);
+        copy[header->index_offset + sizeof(res_pack_entry_t) / 2] ^= 0x40;
+        CHECK(!res_pack_open(&pack, copy));
+
+        /* A damaged bitmap fails only its own CRC */
+        memcpy(copy, data, size);
+        CHECK(res_pack_open(&pack, copy));
+        if (pack.header) {
+                const res_pack_entry_t *damaged = res_pack_find(&pack, manifest[0].name);
+
+                CHECK(damaged != NULL);
+                if (damaged) {
+                        copy[damaged->offset + damaged->size / 2] ^= 0x01;
+                        for (int i = 0; i < pack.header->entry_count; i++) {
+                                const res_pack_entry_t *entry = &pack.index[i];
+
+                                CHECK(res_pack_verify(&pack, entry) == (entry != damaged));
+                        }
+                }
+        }
+
+        free(copy);
+}
+
+int main(int argc, char *argv[])
+{
+        uint8_t *data;
+        long size;
+        res_pack_t pack;
+
+        if (argc != 4) {
+                printf("Usage: %s <pack.bin> <resources.manifest> <Resources.c>\n", argv[0]);
+                return 2;
+        }
+
+        data = load_file(argv[1], &size);
+        if (data == NULL || (size_t)size < sizeof(res_pack_header_t) || !load_manifest(argv[2])) {
+                printf("Cannot read %s or %s\n", argv[1], argv[2]);
+                return 2;
+        }
+
+        CHECK(res_pack_open(&pack, data));
+        if (pack.header) {
+                CHECK(pack.header->size == (uint32_t)size);
+                test_lookups(&pack);
+        }
+        test_firmware_names(argv[3]);
+        test_damaged(data, size);
+
+        printf("%d resources, %s\n", manifest_count, failures ? "FAILED" : "passed");
+        free(data);
+
+        return failures ? 1 : 0;
+}
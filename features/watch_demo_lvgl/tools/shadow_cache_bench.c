@@ -0,0 +1,205 @@
+/**
+ ****************************************************************************************
+ *
+ * @file shadow_cache_bench.c
+ *
+ * @brief Host benchmark of the CPU time of shadows drawn with and without the shadow cache
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run on the host, from the tools folder:
+ *      gcc -O2 -DLV_CONF_INCLUDE_SIMPLE -DLV_LVGL_H_INCLUDE_SIMPLE -Wno-pointer-to-int-cast -Igpu_mock -I../gdi/inc \
+ *              -I../lvgl/lvgl -I../lvgl/lv_port -o shadow_cache_bench shadow_cache_bench.c gpu_mock/d2_mock.c \
+ *              $(find ../lvgl/lvgl/src -name '*.c') -lm && ./shadow_cache_bench
+ *
+ * Rectangles with a shadow are drawn by lv_draw_rect() with the GPU callbacks of lv_port_disp.c, once with
+ * lv_port_shadow_cache_draw() as shadow callback and once without it, where LVGL blurs every corner and blends
+ * the shadow with the CPU. The process time per object is printed for both. The GPU is the D/AVE2D mock of
+ * gpu_mock/, which records the operations without drawing them, so the time is the CPU part only: with the cache
+ * the blend is left to the GPU. Every shadow must be drawn from the cache, which blurs each corner size once.
+ * The times are measured on the host, not on the DA1470x.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define LV_PORT_SHADOW_CACHE_SIZE       (4 * 1024)
+
+#include "gpu_host.h"
+#include "lv_port_gpu.c"
+#include "lv_port_shadow_cache.c"
+
+#define RES_X                   390
+#define RES_Y                   390
+#define FRAMES                  100
+#define OBJECTS_PER_FRAME       12
+
+/* Shadows of cards, buttons and list items. The corners take 2.5 KB together, so all of them stay cached */
+static const struct {
+        lv_coord_t w;
+        lv_coord_t h;
+        lv_coord_t radius;
+        lv_coord_t shadow_width;
+        lv_coord_t shadow_ofs_y;
+} styles[] = {
+        { 160, 100, 20, 20, 6 },
+        { 120,  48, 10, 15, 4 },
+        { 300,  60,  8, 10, 2 },
+};
+
+#define STYLE_NUM               (sizeof(styles) / sizeof(styles[0]))
+
+static lv_color_t frame_buf[RES_X * RES_Y];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static const lv_area_t clip = { 0, 0, RES_X - 1, RES_Y - 1 };
+static int shadows_cached;
+static int corners_blurred;
+static int failures;
+
+#define CHECK(cond)                                                                     \
+        do {                                                                            \
+                if (!(cond)) {                                                          \
+                        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+                        failures++;                                                     \
+                }                                                                       \
+        } while (0)
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+        LV_UNUSED(area);
+        LV_UNUSED(color_p);
+        lv_disp_flush_ready(drv);
+}
+
+/* lv_port_shadow_cache_draw(), counting the shadows it draws and the corners LVGL blurs for it */
+static bool draw_shadow_cb(lv_disp_drv_t *drv, lv_color_t *dst, const lv_area_t *dst_area, lv_coord_t dst_pitch,
+        const lv_area_t *shadow_area, const lv_area_t *bg_area, lv_coord_t r_bg, lv_coord_t sw, lv_coord_t r,
+        const lv_opa_t *corner, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
+{
+        bool drawn = lv_port_shadow_cache_draw(drv, dst, dst_area, dst_pitch, shadow_area, bg_area, r_bg, sw, r,
+                corner, color, opa, blend_mode);
+
+        if (corner) {
+                corners_blurred++;
+        }
+        if (drawn) {
+                shadows_cached++;
+        }
+
+        return drawn;
+}
+
+static void display_init(void)
+{
+        lv_disp_t *disp;
+
+        lv_init();
+        lv_disp_draw_buf_init(&draw_buf, frame_buf, NULL, RES_X * RES_Y);
+        lv_disp_drv_init(&disp_drv);
+        disp_drv.hor_res = RES_X;
+        disp_drv.ver_res = RES_Y;
+        disp_drv.draw_buf = &draw_buf;
+        disp_drv.flush_cb = flush_cb;
+        disp_drv.gpu_fill_cb = lv_port_gpu_fill;
+        disp_drv.gpu_blit_cb = lv_port_gpu_blit;
+        disp_drv.gpu_blit_with_mask_cb = lv_port_gpu_blit_with_mask;
+        disp_drv.gpu_config_blit_cb = lv_port_gpu_config_blit;
+        disp_drv.gpu_draw_rect_cb = lv_port_gpu_draw_rect;
+        disp_drv.gpu_wait_cb = lv_port_gpu_wait;
+        disp = lv_disp_drv_register(&disp_drv);
+
+        d2_mock_reset();
+        lv_port_gpu_init();
+
+        /* Draw straight into the frame as during a full refresh */
+        _lv_refr_set_disp_refreshing(disp);
+        draw_buf.area = clip;
+        draw_buf.buf_act = frame_buf;
+}
+
+/* Draw all frames and return the process time per object, in us */
+static double draw_frames(void)
+{
+        struct timespec start, end;
+        lv_draw_rect_dsc_t dsc;
+        int n = 0;
+
+        lv_draw_rect_dsc_init(&dsc);
+        dsc.bg_color = lv_color_white();
+        dsc.shadow_color = lv_color_black();
+        dsc.shadow_opa = LV_OPA_50;
+
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &start);
+        for (int frame = 0; frame < FRAMES; frame++) {
+                d2_mock_set_frame(frame);
+
+                for (int i = 0; i < OBJECTS_PER_FRAME; i++, n++) {
+                        int s = n % STYLE_NUM;
+                        lv_coord_t x = 30 + (n * 37) % (RES_X - 60 - styles[s].w);
+                        lv_coord_t y = 30 + (n * 53) % (RES_Y - 60 - styles[s].h);
+                        lv_area_t coords = { x, y, x + styles[s].w - 1, y + styles[s].h - 1 };
+
+                        dsc.radius = styles[s].radius;
+                        dsc.shadow_width = styles[s].shadow_width;
+                        dsc.shadow_ofs_y = styles[s].shadow_ofs_y;
+                        lv_draw_rect(&coords, &clip, &dsc);
+                }
+
+                lv_port_gpu_wait(&disp_drv);
+                lv_port_gpu_flush();
+        }
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &end);
+
+        return ((end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3) / n;
+}
+
+int main(void)
+{
+        const d2_mock_counters *counters = d2_mock_get_counters();
+        double cpu_us, cache_us;
+
+        display_init();
+
+        /* LVGL blurs and blends every shadow */
+        disp_drv.gpu_draw_shadow_cb = NULL;
+        cpu_us = draw_frames();
+
+        disp_drv.gpu_draw_shadow_cb = draw_shadow_cb;
+        cache_us = draw_frames();
+
+        /* Each corner size is blurred once, the shadows are then drawn from the cache */
+        CHECK(corners_blurred == STYLE_NUM);
+        CHECK(shadows_cached == FRAMES * OBJECTS_PER_FRAME);
+        CHECK(counters->errors == 0);
+        if (counters->errors) {
+                printf("Last driver error: %s\n", d2_mock_last_error());
+        }
+
+        printf("%d shadowed objects: %.1f us each without the shadow cache, %.1f us with it (%.1fx), "
+                "%d corners blurred, %s\n", FRAMES * OBJECTS_PER_FRAME, cpu_us, cache_us, cpu_us / cache_us,
+                corners_blurred, failures ? "FAILED" : "passed");
+
+        return failures ? 1 : 0;
+}
@@ -0,0 +1,214 @@
+/**
+ ****************************************************************************************
+ *
+ * @file trigo_fine_test.c
+ *
+ * @brief Host check of the fixed-point sine table used by rotated image blits
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+
+/*
+ * Build and run on the host, from the tools folder:
+ *      gcc -O2 -DLV_CONF_INCLUDE_SIMPLE -DLV_LVGL_H_INCLUDE_SIMPLE -Wno-pointer-to-int-cast -Igpu_mock -I../gdi/inc \
+ *              -I../lvgl/lvgl -I../lvgl/lv_port -o trigo_fine_test trigo_fine_test.c gpu_mock/d2_mock.c \
+ *              $(find ../lvgl/lvgl/src -name '*.c') -lm && ./trigo_fine_test
+ *
+ * lv_trigo_sin_fine() and lv_trigo_cos_fine() must be within SIN_TOLERANCE of sinf() and cosf() in Q15 for
+ * every angle of 0..3599 (0.1 degree), and wrap around for angles out of that range. The corners of rotated
+ * image blits, computed by lv_port_gpu_rotate_point() in D2_FIX4, must be within CORNER_TOLERANCE of the exact
+ * rotation for image sizes up to the display and pivots at the center or a corner. The rotation set up of a
+ * blit is then timed for the float path it replaced (cosf(), sinf() and float rotation) and the table path.
+ * The timing is on the host: it shows the ratio, not the cycles of the M33.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "gpu_host.h"
+#include "lv_port_gpu.c"
+
+#define Q15                     32767
+#define SIN_TOLERANCE           1       /* Q15 LSB */
+#define CORNER_TOLERANCE        1       /* D2_FIX4 unit, 1/16 pixel */
+#define TIMING_ROUNDS           200
+
+typedef struct {
+        int w, h;
+} image_size;
+
+static const image_size sizes[] = { { 16, 16 }, { 100, 40 }, { 240, 240 }, { 390, 390 } };
+static int failures;
+
+#define CHECK(cond)                                                                     \
+        do {                                                                            \
+                if (!(cond)) {                                                          \
+                        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+                        failures++;                                                     \
+                }                                                                       \
+        } while (0)
+
+/* The rotation of lv_port_gpu_blit_internal() before the sine table */
+static void rotate_point_float(int *x, int *y, float cos_angle, float sin_angle, int pivot_x, int pivot_y)
+{
+        float fx, fy;
+
+        *x -= pivot_x;
+        *y -= pivot_y;
+
+        fx = ((float)*x) / 16.0f;
+        fy = ((float)*y) / 16.0f;
+
+        *x = (int)(((fx * cos_angle) - (fy * sin_angle)) * 16.0f);
+        *y = (int)(((fx * sin_angle) + (fy * cos_angle)) * 16.0f);
+
+        *x += pivot_x;
+        *y += pivot_y;
+}
+
+static double angle_rad(int angle)
+{
+        return angle / 10.0 * M_PI / 180.0;
+}
+
+static void test_table(void)
+{
+        int max_sin = 0, max_cos = 0;
+
+        for (int angle = 0; angle < 3600; angle++) {
+                int ref_sin = (int)lrintf(sinf((float)angle_rad(angle)) * Q15);
+                int ref_cos = (int)lrintf(cosf((float)angle_rad(angle)) * Q15);
+                int err_sin = abs(lv_trigo_sin_fine(angle) - ref_sin);
+                int err_cos = abs(lv_trigo_cos_fine(angle) - ref_cos);
+
+                max_sin = MAX(max_sin, err_sin);
+                max_cos = MAX(max_cos, err_cos);
+
+                CHECK(lv_trigo_sin_fine(angle - 3600) == lv_trigo_sin_fine(angle));
+                CHECK(lv_trigo_sin_fine(angle + 3600) == lv_trigo_sin_fine(angle));
+        }
+
+        CHECK(max_sin <= SIN_TOLERANCE);
+        CHECK(max_cos <= SIN_TOLERANCE);
+        printf("sin/cos: max error %d/%d LSB of Q15 over 0..3599\n", max_sin, max_cos);
+}
+
+/* Largest distance of the 4 corners from the exact rotation, in D2_FIX4 units */
+static double corner_error(const image_size *size, int pivot_x, int pivot_y, int angle, bool table)
+{
+        const int cx[4] = { 0, size->w, size->w, 0 };
+        const int cy[4] = { 0, 0, size->h, size->h };
+        double s = sin(angle_rad(angle)), c = cos(angle_rad(angle));
+        double max_err = 0;
+
+        for (int i = 0; i < 4; i++) {
+                int x = D2_FIX4(cx[i]), y = D2_FIX4(cy[i]);
+                double dx = x - pivot_x, dy = y - pivot_y;
+                double ref_x = dx * c - dy * s + pivot_x;
+                double ref_y = dx * s + dy * c + pivot_y;
+
+                if (table) {
+                        lv_port_gpu_rotate_point(&x, &y, lv_trigo_cos_fine(angle), lv_trigo_sin_fine(angle),
+                                pivot_x, pivot_y);
+                } else {
+                        rotate_point_float(&x, &y, cosf((float)angle_rad(angle)), sinf((float)angle_rad(angle)),
+                                pivot_x, pivot_y);
+                }
+                max_err = fmax(max_err, fmax(fabs(x - ref_x), fabs(y - ref_y)));
+        }
+
+        return max_err;
+}
+
+static void test_corners(void)
+{
+        double max_table = 0, max_float = 0;
+
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+                /* Pivots as computed in lv_port_gpu_blit_internal() at zoom 256 */
+                const int pivots[2][2] = {
+                        { (sizes[i].w / 2 * LV_IMG_ZOOM_NONE) >> 4, (sizes[i].h / 2 * LV_IMG_ZOOM_NONE) >> 4 },
+                        { 0, 0 },
+                };
+
+                for (int p = 0; p < 2; p++) {
+                        for (int angle = 0; angle < 3600; angle++) {
+                                max_table = fmax(max_table,
+                                        corner_error(&sizes[i], pivots[p][0], pivots[p][1], angle, true));
+                                max_float = fmax(max_float,
+                                        corner_error(&sizes[i], pivots[p][0], pivots[p][1], angle, false));
+                        }
+                }
+        }
+
+        CHECK(max_table <= CORNER_TOLERANCE);
+        printf("blit corners: max error %.2f/16 pixel with the table, %.2f/16 pixel with the float path\n",
+                max_table, max_float);
+}
+
+static void test_timing(void)
+{
+        volatile int sink = 0;
+        clock_t start;
+        double float_ns, table_ns;
+        const int pivot = D2_FIX4(195);
+
+        start = clock();
+        for (int round = 0; round < TIMING_ROUNDS; round++) {
+                for (int angle = 0; angle < 3600; angle++) {
+                        float a = ((float)angle / 10) * M_PI / 180;
+                        float cos_angle = cosf(a), sin_angle = sinf(a);
+                        int x = D2_FIX4(390), y = D2_FIX4(390);
+
+                        rotate_point_float(&x, &y, cos_angle, sin_angle, pivot, pivot);
+                        sink += x + y + (int)(cos_angle * 65536.0f) + (int)(sin_angle * 65536.0f);
+                }
+        }
+        float_ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / (TIMING_ROUNDS * 3600);
+
+        start = clock();
+        for (int round = 0; round < TIMING_ROUNDS; round++) {
+                for (int angle = 0; angle < 3600; angle++) {
+                        int32_t cos_angle = lv_trigo_cos_fine(angle), sin_angle = lv_trigo_sin_fine(angle);
+                        int x = D2_FIX4(390), y = D2_FIX4(390);
+
+                        lv_port_gpu_rotate_point(&x, &y, cos_angle, sin_angle, pivot, pivot);
+                        sink += x + y + cos_angle * (1 << (16 - LV_TRIGO_SHIFT)) +
+                                sin_angle * (1 << (16 - LV_TRIGO_SHIFT));
+                }
+        }
+        table_ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / (TIMING_ROUNDS * 3600);
+
+        printf("rotation set up: %.1f ns with the float path, %.1f ns with the table (host)\n", float_ns, table_ns);
+}
+
+int main(void)
+{
+        test_table();
+        test_corners();
+        test_timing();
+
+        printf("%s\n", failures ? "FAILED" : "passed");
+
+        return failures ? 1 : 0;
+}
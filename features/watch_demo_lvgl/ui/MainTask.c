@@ -32,6 +32,7 @@
 #include "gdi.h"
 #include "lvgl.h"
 #include "lv_port_disp.h"
+#include "lv_port_gpu.h"
 #include "lv_port_indev.h"
 #include "init_screens.h"
 #include "screens/compass_screen.h"
@@ -41,6 +42,9 @@
  *****************************************************************************************
  */
 #define MAGNETIC_DATA_EVT       (1 << 3)
+#ifdef PERFORMANCE_METRICS
+#define TOAST_EVT               (1 << 4)
+#endif
 
 /*
  *       Static
@@ -49,6 +53,11 @@
  */
 static INITIALISED_PRIVILEGED_DATA OS_TASK gui_task_h = NULL;
 static int16_t mag_data;
+#ifdef PERFORMANCE_METRICS
+static bool toast_overlay;
+
+extern void watch_face_toast(bool overlay);
+#endif
 
 /*
  *       Static code
@@ -77,6 +86,13 @@ static OS_TASK_FUNCTION(GUIThread, pvParameters)
 
                 sleep_time = lv_task_handler();
 
+#if LV_PORT_DISP_GPU_EN
+                /* GUI will be idle long enough for the system to enter sleep, release the GPU */
+                if (sleep_time >= LV_PORT_GPU_RELEASE_IDLE_MS) {
+                        lv_port_gpu_release();
+                }
+#endif
+
                 if (LV_NO_TIMER_READY == sleep_time) {
                         sleep_time = OS_TASK_NOTIFY_NO_WAIT;
                 }
@@ -90,6 +106,11 @@ static OS_TASK_FUNCTION(GUIThread, pvParameters)
 
                         compass_rotate(mag_data_loc);
                 }
+#ifdef PERFORMANCE_METRICS
+                if ((notif & TOAST_EVT)) {
+                        watch_face_toast(toast_overlay);
+                }
+#endif
         }
 
 }
@@ -107,6 +128,15 @@ void compass_event(int16_t *data)
         OS_TASK_NOTIFY(gui_task_h, MAGNETIC_DATA_EVT, OS_NOTIFY_SET_BITS);
 }
 
+#ifdef PERFORMANCE_METRICS
+void toast_event(bool overlay)
+{
+        toast_overlay = overlay;
+
+        OS_TASK_NOTIFY(gui_task_h, TOAST_EVT, OS_NOTIFY_SET_BITS);
+}
+#endif
+
 /*
  *       MainTask
  *****************************************************************************************
@@ -34,6 +34,7 @@
 #include "metrics.h"
 
 extern volatile uint8_t current_tag;
+extern void toast_event(bool overlay);
 
 /*
  *       Defines
@@ -71,6 +72,17 @@ static OS_TASK_FUNCTION(ui_simulation_thread, argument)
                 OS_DELAY(OS_MS_2_TICKS(5000)); //5s
                 metrics_set_tag(METRICS_TAG_NO_LOGGING);
 
+                // toast sliding over the watch face, drawn by LVGL
+                metrics_set_tag(METRICS_TAG_TOAST);
+                toast_event(false);
+                OS_DELAY(OS_MS_2_TICKS(DELAY_BETWEEN_EACH_STEP));
+
+                // the same toast moved on the second LCDC layer
+                metrics_set_tag(METRICS_TAG_TOAST_OVERLAY);
+                toast_event(true);
+                OS_DELAY(OS_MS_2_TICKS(DELAY_BETWEEN_EACH_STEP));
+                metrics_set_tag(METRICS_TAG_NO_LOGGING);
+
                 // swiping from clock face to menu
                 touch_simulation(SLIDE_LEFT_TO_RIGHT);
                 OS_DELAY(OS_MS_2_TICKS(DELAY_BETWEEN_EACH_STEP));
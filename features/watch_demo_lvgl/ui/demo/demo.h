@@ -41,6 +41,12 @@
 
 #define TWO_LAYERS_HORIZONTAL_SLIDING   (1)
 
+/* The dial of the watch face is drawn from a snapshot, kept in the GDI GUI heap in QSPI RAM */
+#define GDI_HEAP_USE_QSPI_RAM           (1)
+#define GDI_GUI_HEAP_SIZE               (DEMO_RESX * DEMO_RESY * 2)
+#define LV_PORT_IMG_CACHE_SIZE          (0)
+#define LV_PORT_SNAPSHOT_SIZE           (GDI_GUI_HEAP_SIZE)
+
 #if !COMPASS_ROTATION_USES_CANVAS
 #define DEMO_GUI_HEAP_SIZE              (15 * 1024)
 #else
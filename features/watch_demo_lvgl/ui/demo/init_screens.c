@@ -34,6 +34,7 @@
 #include "screens/watch_face_screen.h"
 #include "screens/menu_list_screen.h"
 #include "module.h"
+#include "Resources.h"
 #ifdef PERFORMANCE_METRICS
 #include "metrics.h"
 #endif
@@ -47,6 +48,7 @@
  */
 static void lv_propagate_to_children(lv_obj_t *parent, lv_event_code_t code);
 static void scroll_event_cb(lv_event_t *e);
+static void resources_error_screen(void);
 
 /*
  *   GLOBAL FUNCTIONS
@@ -54,6 +56,12 @@ static void scroll_event_cb(lv_event_t *e);
  */
 void create_basic_screens()
 {
+        /* Set up the bitmaps from the resource pack, the screens cannot be built without them */
+        if (!resources_init()) {
+                resources_error_screen();
+                return;
+        }
+
         /* Initialize Modules*/
         module_init();
 
@@ -93,6 +101,21 @@ void create_basic_screens()
  *   STATIC FUNCTIONS
  *****************************************************************************************
  */
+static void resources_error_screen(void)
+{
+        lv_obj_t *label;
+
+        lv_obj_set_style_bg_color(lv_scr_act(), lv_color_black(), LV_PART_MAIN);
+
+        label = lv_label_create(lv_scr_act());
+        lv_label_set_text(label, "Resource pack missing or corrupted.\n"
+                                 "Flash WatchDemoColoredResources.bin\n"
+                                 "and reset the board.");
+        lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_RED), LV_PART_MAIN);
+        lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+        lv_obj_center(label);
+}
+
 static void lv_propagate_to_children(lv_obj_t *parent, lv_event_code_t code)
 {
         uint32_t i;
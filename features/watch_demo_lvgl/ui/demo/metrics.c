@@ -32,15 +32,28 @@
 
 #define METRICS_MAX               (1000)
 #define METRICS_TAG_MAX           (10)
+#define METRICS_SCREEN_MAX        (8)
 #define MAX_OS_TASK_NUM           (10)
 #define GUI_THREAD_NAME           ("GUI thread")
 
+/* Time from opening a screen until its first frame is rendered */
+typedef struct {
+        const char *name;
+        uint32_t count;
+        uint32_t cached_count;
+        uint32_t total_ms;
+        uint32_t max_ms;
+} SCREEN_METRICS;
+
 static struct {
         METRICS data[METRICS_MAX];
         uint16_t data_count;
         const char *tag_names[METRICS_TAG_MAX];
         uint32_t cpu_usage[METRICS_TAG_MAX];
+        SCREEN_METRICS screens[METRICS_SCREEN_MAX];
 } metrics;
+static SCREEN_METRICS *screen_pending;
+static OS_TICK_TIME screen_open_time;
 static TaskStatus_t task_status_array[MAX_OS_TASK_NUM];
 static uint32_t gui_runtime_start, gui_runtime_end;
 static uint32_t total_runtime_start, total_runtime_end;
@@ -72,12 +85,17 @@ void metrics_init(void)
         memset(metrics.tag_names, 0, METRICS_TAG_MAX * sizeof(char*));
         memset(metrics.data, 0, METRICS_MAX * sizeof(METRICS));
         memset(metrics.cpu_usage, 0, METRICS_TAG_MAX * sizeof(uint32_t));
+        memset(metrics.screens, 0, sizeof(metrics.screens));
+        screen_pending = NULL;
 
         metrics_register_tag(METRICS_TAG_TICK_ROTATION, "Watch face tick rotation");
         metrics_register_tag(METRICS_TAG_SLIDING_WATCH_FACE_TO_MENU, "Sliding from watch face to menu screen");
         metrics_register_tag(METRICS_TAG_BROWSE_MENU, "Browse in menu");
         metrics_register_tag(METRICS_TAG_TIMER_RUNNING, "Timer running");
         metrics_register_tag(METRICS_TAG_COMPASS_ROTATION, "Compass rotation");
+        metrics_register_tag(METRICS_TAG_TOAST, "Toast sliding over watch face");
+        metrics_register_tag(METRICS_TAG_TOAST_OVERLAY, "Toast sliding as LCDC overlay");
+        metrics_register_tag(METRICS_TAG_SCREEN_TRANSITION, "Screen transition");
 }
 
 void metrics_reinit(void)
@@ -131,6 +149,13 @@ void metrics_set_gpu_tag(uint8_t tag)
         gpu_current_tag = tag;
 }
 
+void metrics_gpu_submit(void)
+{
+        if (current_tag) {
+                metrics.data[metrics.data_count].gpu_submissions++;
+        }
+}
+
 void metrics_register_tag(uint8_t tag, const char *tag_name)
 {
         if (tag < METRICS_TAG_MAX) {
@@ -138,6 +163,44 @@ void metrics_register_tag(uint8_t tag, const char *tag_name)
         }
 }
 
+void metrics_screen_open(const char *name, bool cached)
+{
+        uint8_t i;
+
+        for (i = 0; i < METRICS_SCREEN_MAX; i++) {
+                if (metrics.screens[i].name == NULL || metrics.screens[i].name == name) {
+                        break;
+                }
+        }
+        if (i == METRICS_SCREEN_MAX) {
+                return;
+        }
+
+        metrics.screens[i].name = name;
+        if (cached) {
+                metrics.screens[i].cached_count++;
+        }
+        screen_pending = &metrics.screens[i];
+        screen_open_time = OS_GET_TICK_COUNT();
+}
+
+void metrics_screen_frame(void)
+{
+        uint32_t time_ms;
+
+        if (screen_pending == NULL) {
+                return;
+        }
+
+        time_ms = OS_TICKS_2_MS(OS_GET_TICK_COUNT() - screen_open_time);
+        screen_pending->count++;
+        screen_pending->total_ms += time_ms;
+        if (time_ms > screen_pending->max_ms) {
+                screen_pending->max_ms = time_ms;
+        }
+        screen_pending = NULL;
+}
+
 void metrics_print(void)
 {
         uint16_t i;
@@ -145,6 +208,8 @@ void metrics_print(void)
         int fps_total[4];
         int rendering_count = 0;
         int pixel_rate_total = 0;
+        int open_time_total = 0;
+        int submissions_total = 0;
 
         int gpu_total_values_per_tag[GPU_METRICS_MAX_TAG];
         int gpu_valid_values_per_tag[GPU_METRICS_MAX_TAG];
@@ -158,6 +223,8 @@ void metrics_print(void)
                         memset(fps_total, 0, 4 * sizeof(int));
                         rendering_count = 0;
                         pixel_rate_total = 0;
+                        open_time_total = 0;
+                        submissions_total = 0;
 
                         memset(gpu_total_values_per_tag, 0, sizeof(gpu_total_values_per_tag));
                         memset(gpu_valid_values_per_tag, 0, sizeof(gpu_valid_values_per_tag));
@@ -171,6 +238,8 @@ void metrics_print(void)
                 fps_total[1] += metrics.data[i].frame_rendering_time;
                 fps_total[2] += metrics.data[i].display_transfer_time;
                 fps_total[3]++; //counts the number of samples per metric tag
+                open_time_total += metrics.data[i].display_open_time;
+                submissions_total += metrics.data[i].gpu_submissions;
                 pixel_rate_total += (metrics.data[i].pixel_count * 1000) / metrics.data[i].display_transfer_time;
 
 
@@ -188,16 +257,42 @@ void metrics_print(void)
 
                         printf("Average GPU: Fill: %10d.%.2d ms,\r\n"
                                "             BlitBitmap: %4d.%.2d ms,\r\n"
-                               "             RotateImage: %3d.%.2d ms,\r\n",
+                               "             RotateImage: %3d.%.2d ms,\r\n"
+                               "             Submissions: %4d.%d per frame,\r\n"
+                               "             Text: %10d.%.2d ms (CPU raster: %d.%.2d ms),\r\n"
+                               "             Frame copy: %4d.%.2d ms (DMA: %d.%.2d ms),\r\n",
                                 (gpu_avg_values_per_tag[0]) / 1000, ((gpu_avg_values_per_tag[0]) / 10) % 100,
                                 (gpu_avg_values_per_tag[1]) / 1000, ((gpu_avg_values_per_tag[1]) / 10) % 100,
-                                (gpu_avg_values_per_tag[2]) / 1000, ((gpu_avg_values_per_tag[2]) / 10) % 100);
+                                (gpu_avg_values_per_tag[2]) / 1000, ((gpu_avg_values_per_tag[2]) / 10) % 100,
+                                (submissions_total * 10 / fps_total[3]) / 10,
+                                (submissions_total * 10 / fps_total[3]) % 10,
+                                (gpu_avg_values_per_tag[GPU_METRICS_TEXT_GPU - 1]) / 1000,
+                                ((gpu_avg_values_per_tag[GPU_METRICS_TEXT_GPU - 1]) / 10) % 100,
+                                (gpu_avg_values_per_tag[GPU_METRICS_TEXT_CPU - 1]) / 1000,
+                                ((gpu_avg_values_per_tag[GPU_METRICS_TEXT_CPU - 1]) / 10) % 100,
+                                (gpu_avg_values_per_tag[GPU_METRICS_COPY_CPU - 1]) / 1000,
+                                ((gpu_avg_values_per_tag[GPU_METRICS_COPY_CPU - 1]) / 10) % 100,
+                                (gpu_avg_values_per_tag[GPU_METRICS_COPY_DMA - 1]) / 1000,
+                                ((gpu_avg_values_per_tag[GPU_METRICS_COPY_DMA - 1]) / 10) % 100);
 
-                        printf("Average FPS: %3d.%d (frame: %3d.%.2d ms, transfer: %3d.%.2d ms), Pixel Rate = %3d.%.2d kP/sec\r\n\r\n",
+                        printf("Average FPS: %3d.%d (frame: %3d.%.2d ms, transfer: %3d.%.2d ms), Pixel Rate = %3d.%.2d kP/sec\r\n",
                                 (fps_total[0] / fps_total[3]) / 10, (fps_total[0] / fps_total[3]) % 10,
                                 (fps_total[1] / rendering_count) / 1000, ((fps_total[1] / rendering_count) / 10) % 100,
                                 (fps_total[2] / fps_total[3]) / 1000, ((fps_total[2] / fps_total[3]) / 10) % 100,
                                 (pixel_rate_total / fps_total[3]) / 1000, ((pixel_rate_total / fps_total[3]) / 10) % 100);
+                        printf("Average display open/close: %3d.%.2d ms per frame\r\n\r\n",
+                                (open_time_total / fps_total[3]) / 1000, ((open_time_total / fps_total[3]) / 10) % 100);
+                }
+        }
+
+        printf("Tap to first frame:\r\n");
+        for (i = 0; i < METRICS_SCREEN_MAX && metrics.screens[i].name; i++) {
+                SCREEN_METRICS *screen = &metrics.screens[i];
+
+                if (screen->count) {
+                        printf("%s: %4ld ms average, %4ld ms max, %ld of %ld opened from the screen cache\r\n",
+                                screen->name, screen->total_ms / screen->count, screen->max_ms,
+                                screen->cached_count, screen->count);
                 }
         }
 }
@@ -38,19 +38,28 @@
 #define METRICS_TAG_BROWSE_MENU                 (3)
 #define METRICS_TAG_TIMER_RUNNING               (4)
 #define METRICS_TAG_COMPASS_ROTATION            (5)
+#define METRICS_TAG_TOAST                       (6)
+#define METRICS_TAG_TOAST_OVERLAY               (7)
+#define METRICS_TAG_SCREEN_TRANSITION           (8)
 
 #define GPU_METRICS_FILL                (1)
 #define GPU_METRICS_BLITBITMAP          (2)
 #define GPU_METRICS_ROTATEIMAGE         (3)
-#define GPU_METRICS_MAX_TAG             (3)
+#define GPU_METRICS_TEXT_GPU            (4)     /* Letters blitted out of the glyph atlas */
+#define GPU_METRICS_TEXT_CPU            (5)     /* Rasterizing glyphs into the glyph atlas */
+#define GPU_METRICS_COPY_CPU            (6)     /* Copying areas into a kept frame, CPU side */
+#define GPU_METRICS_COPY_DMA            (7)     /* Copying areas into a kept frame, DMA busy time */
+#define GPU_METRICS_MAX_TAG             (7)
 
 typedef struct {
         uint8_t tag;
         int fps;
         int frame_rendering_time;
         int display_transfer_time;
+        int display_open_time;
         int pixel_count;
         int gpu_data[GPU_METRICS_MAX_TAG];
+        int gpu_submissions;    /* Render buffers submitted to the GPU during the frame */
 } METRICS;
 
 void metrics_init(void);
@@ -59,7 +68,10 @@ void metrics_set_tag(uint8_t tag);
 METRICS get_metrics_data();
 void metrics_gpu_add(int gpu_rendering_time);
 void metrics_set_gpu_tag(uint8_t tag);
+void metrics_gpu_submit(void);
 void metrics_register_tag(uint8_t tag, const char *tag_name);
 void metrics_print(void);
+void metrics_screen_open(const char *name, bool cached);
+void metrics_screen_frame(void);
 
 #endif /* METRICS_H_ */
@@ -38,21 +38,30 @@
 #include "lvgl.h"
 
 /*
- * Generated bitmaps used by all modules
+ * Bitmaps used by all modules, looked up in the resource pack by resources_init()
 */
-extern const lv_img_dsc_t clock_bg;
-extern const lv_img_dsc_t stamens;
-extern const lv_img_dsc_t tick_hour;
-extern const lv_img_dsc_t tick_minute;
-extern const lv_img_dsc_t tick_second;
-extern const lv_img_dsc_t timer;
-extern const lv_img_dsc_t running;
-extern const lv_img_dsc_t compass_menu_icon;
-extern const lv_img_dsc_t dummy;
-extern const lv_img_dsc_t reset_timer;
-extern const lv_img_dsc_t compass;
-extern const lv_img_dsc_t compass_earth;
-extern const lv_img_dsc_t compass_index;
+extern lv_img_dsc_t clock_bg;
+extern lv_img_dsc_t stamens;
+extern lv_img_dsc_t tick_hour;
+extern lv_img_dsc_t tick_minute;
+extern lv_img_dsc_t tick_second;
+extern lv_img_dsc_t timer;
+extern lv_img_dsc_t reset_timer;
+extern lv_img_dsc_t activity;
+extern lv_img_dsc_t track;
+extern lv_img_dsc_t compass_menu_icon;
+extern lv_img_dsc_t compass;
+extern lv_img_dsc_t compass_earth;
+extern lv_img_dsc_t compass_index;
+extern lv_img_dsc_t heart_rate;
+extern lv_img_dsc_t messages;
+extern lv_img_dsc_t sleep_monitor;
+extern lv_img_dsc_t weather;
 
-#endif  /* RESOURCES_H__ */
+/*
+ * Open the resource pack stored in flash and set up the bitmaps. Returns false
+ * if the pack is invalid or a bitmap is missing.
+*/
+bool resources_init(void);
 
+#endif  /* RESOURCES_H__ */
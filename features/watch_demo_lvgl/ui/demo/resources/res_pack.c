@@ -0,0 +1,132 @@
+/**
+ ****************************************************************************************
+ *
+ * @file res_pack.c
+ *
+ * @brief Resource pack lookup
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#include <stddef.h>
+#include "res_pack.h"
+
+#define FNV_OFFSET_BASIS                (0x811C9DC5)
+#define FNV_PRIME                       (0x01000193)
+#define CRC32_POLYNOMIAL                (0xEDB88320)
+
+static uint32_t res_pack_crc32(const uint8_t *data, uint32_t len)
+{
+        uint32_t crc = 0xFFFFFFFF;
+
+        while (len--) {
+                crc ^= *data++;
+                for (int i = 0; i < 8; i++) {
+                        crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & -(crc & 1));
+                }
+        }
+
+        return ~crc;
+}
+
+bool res_pack_open(res_pack_t *pack, const void *base)
+{
+        const res_pack_header_t *header = base;
+        uint32_t index_size;
+
+        pack->base = NULL;
+        pack->header = NULL;
+        pack->index = NULL;
+
+        if (header->magic != RES_PACK_MAGIC || header->version != RES_PACK_VERSION ||
+                header->entry_size != sizeof(res_pack_entry_t)) {
+                return false;
+        }
+
+        index_size = header->entry_count * sizeof(res_pack_entry_t);
+        if (header->index_offset + index_size > header->size) {
+                return false;
+        }
+
+        if (res_pack_crc32((const uint8_t *)base + header->index_offset, index_size) != header->index_crc) {
+                return false;
+        }
+
+        pack->base = base;
+        pack->header = header;
+        pack->index = (const res_pack_entry_t *)(pack->base + header->index_offset);
+
+        return true;
+}
+
+uint32_t res_pack_hash(const char *name)
+{
+        uint32_t hash = FNV_OFFSET_BASIS;
+
+        while (*name) {
+                hash ^= (uint8_t)*name++;
+                hash *= FNV_PRIME;
+        }
+
+        return hash;
+}
+
+const res_pack_entry_t *res_pack_find(const res_pack_t *pack, const char *name)
+{
+        uint32_t hash = res_pack_hash(name);
+        int lo = 0, hi;
+
+        if (pack->header == NULL) {
+                return NULL;
+        }
+
+        /* The pack builder rejects hash collisions, a matching hash is a matching name */
+        hi = pack->header->entry_count - 1;
+        while (lo <= hi) {
+                int mid = (lo + hi) / 2;
+                const res_pack_entry_t *entry = &pack->index[mid];
+
+                if (entry->name_hash == hash) {
+                        return entry;
+                }
+                if (entry->name_hash < hash) {
+                        lo = mid + 1;
+                } else {
+                        hi = mid - 1;
+                }
+        }
+
+        return NULL;
+}
+
+const void *res_pack_data(const res_pack_t *pack, const res_pack_entry_t *entry)
+{
+        return pack->base + entry->offset;
+}
+
+bool res_pack_verify(const res_pack_t *pack, const res_pack_entry_t *entry)
+{
+        if (entry->offset + entry->size > pack->header->size) {
+                return false;
+        }
+
+        return res_pack_crc32(res_pack_data(pack, entry), entry->size) == entry->crc;
+}
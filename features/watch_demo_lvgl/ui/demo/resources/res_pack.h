@@ -0,0 +1,115 @@
+/**
+ ****************************************************************************************
+ *
+ * @file res_pack.h
+ *
+ * @brief Resource pack format and lookup API
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#ifndef RES_PACK_H__
+#define RES_PACK_H__
+
+/*********************************************************************
+ *
+ *       Includes
+ *
+ **********************************************************************
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************
+ *
+ *       Defines
+ *
+ **********************************************************************
+ */
+#define RES_PACK_MAGIC                  (0x50524457)    /* "WDRP" */
+#define RES_PACK_VERSION                (1)
+
+/*********************************************************************
+ *
+ *       Types
+ *
+ **********************************************************************
+ */
+
+/*
+ * Pack header, placed at offset 0. All fields are little endian and all offsets
+ * are relative to the start of the pack.
+ */
+typedef struct {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t entry_count;
+        uint16_t entry_size;            /* sizeof(res_pack_entry_t) used by the pack builder */
+        uint16_t alignment;             /* Alignment of the data of every entry */
+        uint32_t index_offset;
+        uint32_t data_offset;
+        uint32_t size;                  /* Total size of the pack */
+        uint32_t index_crc;             /* CRC-32 of the index */
+        uint32_t reserved;
+} res_pack_header_t;
+
+/*
+ * Index entry. The index is sorted by name hash so that lookups are binary searches.
+ */
+typedef struct {
+        uint32_t name_hash;             /* FNV-1a hash of the resource name */
+        uint32_t offset;                /* Offset of the data, aligned to the pack alignment */
+        uint32_t size;                  /* Size of the data */
+        uint32_t crc;                   /* CRC-32 of the data */
+        uint32_t format;                /* Format specific descriptor e.g. lv_img_header_t for images */
+        uint16_t group;                 /* Screen the resource belongs to, entries of a group are contiguous */
+        uint16_t reserved;
+} res_pack_entry_t;
+
+typedef struct {
+        const uint8_t *base;
+        const res_pack_header_t *header;
+        const res_pack_entry_t *index;
+} res_pack_t;
+
+/*********************************************************************
+ *
+ *       Functions
+ *
+ **********************************************************************
+ */
+
+/* Validate the pack located at base and prepare it for lookups */
+bool res_pack_open(res_pack_t *pack, const void *base);
+
+/* Hash of a resource name as stored in the index */
+uint32_t res_pack_hash(const char *name);
+
+/* Find a resource by name, returns NULL if the pack does not contain it */
+const res_pack_entry_t *res_pack_find(const res_pack_t *pack, const char *name);
+
+/* Address of the data of a resource */
+const void *res_pack_data(const res_pack_t *pack, const res_pack_entry_t *entry);
+
+/* Check the data of a resource against its CRC */
+bool res_pack_verify(const res_pack_t *pack, const res_pack_entry_t *entry);
+
+#endif  /* RES_PACK_H__ */
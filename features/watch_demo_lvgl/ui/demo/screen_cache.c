@@ -0,0 +1,345 @@
+/**
+ ****************************************************************************************
+ *
+ * @file screen_cache.c
+ *
+ * @brief Screen cache source file
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+/*
+ *      INCLUDES
+ *****************************************************************************************
+ */
+#include <string.h>
+#include "screen_cache.h"
+#include "lv_port_disp.h"
+#ifdef PERFORMANCE_METRICS
+#include "metrics.h"
+
+extern volatile uint8_t current_tag;
+#endif
+
+/*
+ *      DEFINES
+ *****************************************************************************************
+ */
+/* Idle time after going back before the most often opened screen is built again */
+#define SCREEN_CACHE_PREPARE_DELAY_MS   (500)
+
+#if SCREEN_CACHE_ENTRY_NUM < 2
+#error "SCREEN_CACHE_ENTRY_NUM must be at least 2"
+#endif
+
+/*
+ *      TYPEDEFS
+ *****************************************************************************************
+ */
+typedef struct
+{
+        const screen_cache_item *item;          /* NULL if the entry is free */
+        lv_obj_t *screen;                       /* NULL if the screen is not built */
+        uint32_t size;                          /* LVGL heap taken by the screen when it was built */
+        uint32_t last_use;
+        uint16_t open_count;
+}
+screen_cache_entry;
+
+/*
+ *  STATIC PROTOTYPES
+ *****************************************************************************************
+ */
+static screen_cache_entry *screen_cache_get_entry(const screen_cache_item *item);
+static void screen_cache_build(screen_cache_entry *entry);
+static void screen_cache_delete(screen_cache_entry *entry);
+static void screen_cache_trim(void);
+static bool screen_cache_evict(void);
+static void screen_cache_load(lv_obj_t *screen, lv_port_disp_transition_type_t type, lv_dir_t dir);
+#if SCREEN_CACHE_TRANSITION_TIME
+static void screen_cache_load_cb(void *user_data);
+#ifdef PERFORMANCE_METRICS
+static void screen_cache_loaded_cb(void *user_data);
+#endif
+#endif
+#if SCREEN_CACHE_PREPARE
+static void screen_cache_prepare_cb(lv_timer_t *timer);
+#endif
+
+/*
+ *  STATIC VARIABLES
+ *****************************************************************************************
+ */
+static screen_cache_entry cache_entries[SCREEN_CACHE_ENTRY_NUM];
+static screen_cache_entry *active_entry;
+static lv_obj_t *prev_screen;
+static uint32_t cache_use_count;
+static uint32_t cache_size;
+#if SCREEN_CACHE_PREPARE
+static lv_timer_t *prepare_timer;
+#endif
+
+/*
+ *   GLOBAL FUNCTIONS
+ *****************************************************************************************
+ */
+void screen_cache_show(const screen_cache_item *item)
+{
+        screen_cache_entry *entry = screen_cache_get_entry(item);
+
+#ifdef PERFORMANCE_METRICS
+        metrics_screen_open(item->name, entry->screen != NULL);
+#endif
+#if SCREEN_CACHE_PREPARE
+        if (prepare_timer) {
+                lv_timer_pause(prepare_timer);
+        }
+#endif
+
+        if (entry->screen == NULL) {
+                screen_cache_build(entry);
+        }
+
+        prev_screen = lv_scr_act();
+        active_entry = entry;
+        entry->last_use = ++cache_use_count;
+        entry->open_count++;
+
+        if (item->enter) {
+                item->enter(entry->screen);
+        }
+        screen_cache_load(entry->screen, LV_PORT_DISP_TRANSITION_COVER, LV_DIR_LEFT);
+}
+
+void screen_cache_back(void)
+{
+        screen_cache_entry *entry = active_entry;
+
+        if (entry == NULL) {
+                return;
+        }
+
+        if (entry->item->leave) {
+                entry->item->leave(entry->screen);
+        }
+        screen_cache_load(prev_screen, LV_PORT_DISP_TRANSITION_UNCOVER, LV_DIR_RIGHT);
+        active_entry = NULL;
+
+        /* The screen just left stays cached if it fits */
+        screen_cache_trim();
+
+#if SCREEN_CACHE_PREPARE
+        if (prepare_timer == NULL) {
+                prepare_timer = lv_timer_create(screen_cache_prepare_cb, SCREEN_CACHE_PREPARE_DELAY_MS, NULL);
+        } else {
+                lv_timer_reset(prepare_timer);
+                lv_timer_resume(prepare_timer);
+        }
+#endif
+}
+
+void screen_cache_flush(void)
+{
+        while (screen_cache_evict());
+}
+
+/*
+ *   STATIC FUNCTIONS
+ *****************************************************************************************
+ */
+static screen_cache_entry *screen_cache_get_entry(const screen_cache_item *item)
+{
+        screen_cache_entry *lru = NULL;
+        uint8_t i;
+
+        for (i = 0; i < SCREEN_CACHE_ENTRY_NUM; i++) {
+                if (cache_entries[i].item == item) {
+                        return &cache_entries[i];
+                }
+        }
+
+        /* Take a free entry or forget the least recently used screen */
+        for (i = 0; i < SCREEN_CACHE_ENTRY_NUM; i++) {
+                screen_cache_entry *entry = &cache_entries[i];
+
+                if (entry->item == NULL) {
+                        lru = entry;
+                        break;
+                }
+                if (entry != active_entry && (lru == NULL || entry->last_use < lru->last_use)) {
+                        lru = entry;
+                }
+        }
+
+        if (lru->screen) {
+                screen_cache_delete(lru);
+        }
+        memset(lru, 0, sizeof(*lru));
+        lru->item = item;
+
+        return lru;
+}
+
+static void screen_cache_build(screen_cache_entry *entry)
+{
+        lv_mem_monitor_t mon;
+        uint32_t free_size;
+
+        /* Make room first, the size of the screen is only known once it is built */
+        screen_cache_trim();
+
+        lv_mem_monitor(&mon);
+        free_size = mon.free_size;
+
+        entry->screen = entry->item->create();
+
+        lv_mem_monitor(&mon);
+        entry->size = free_size > mon.free_size ? free_size - mon.free_size : 0;
+        cache_size += entry->size;
+}
+
+static void screen_cache_delete(screen_cache_entry *entry)
+{
+        lv_obj_del(entry->screen);
+        entry->screen = NULL;
+        cache_size -= entry->size;
+}
+
+static void screen_cache_trim(void)
+{
+        lv_mem_monitor_t mon;
+
+        while (cache_size > SCREEN_CACHE_SIZE) {
+                if (!screen_cache_evict()) {
+                        return;
+                }
+        }
+
+#if LV_MEM_CUSTOM == 0
+        /* Free memory for the screens which are being used */
+        lv_mem_monitor(&mon);
+        while (mon.free_size < SCREEN_CACHE_MIN_FREE) {
+                if (!screen_cache_evict()) {
+                        return;
+                }
+                lv_mem_monitor(&mon);
+        }
+#else
+        LV_UNUSED(mon);
+#endif
+}
+
+static void screen_cache_load(lv_obj_t *screen, lv_port_disp_transition_type_t type, lv_dir_t dir)
+{
+#if SCREEN_CACHE_TRANSITION_TIME
+        lv_port_disp_transition_dsc_t dsc;
+
+        /* Both screens are drawn once, the LCDC moves them. The screen left may be deleted right after */
+        lv_port_disp_transition_dsc_init(&dsc);
+        dsc.type = type;
+        dsc.dir = dir;
+        dsc.time = SCREEN_CACHE_TRANSITION_TIME;
+        dsc.new_frame_cb = screen_cache_load_cb;
+        dsc.user_data = screen;
+#ifdef PERFORMANCE_METRICS
+        if (current_tag == METRICS_TAG_NO_LOGGING) {
+                OS_ENTER_CRITICAL_SECTION();
+                metrics_set_tag(METRICS_TAG_SCREEN_TRANSITION);
+                OS_LEAVE_CRITICAL_SECTION();
+                dsc.ready_cb = screen_cache_loaded_cb;
+        }
+#endif
+        lv_port_disp_transition_start(&dsc);
+#else
+        lv_scr_load(screen);
+#endif
+}
+
+#if SCREEN_CACHE_TRANSITION_TIME
+static void screen_cache_load_cb(void *user_data)
+{
+        lv_scr_load(user_data);
+}
+
+#ifdef PERFORMANCE_METRICS
+static void screen_cache_loaded_cb(void *user_data)
+{
+        OS_ENTER_CRITICAL_SECTION();
+        metrics_set_tag(METRICS_TAG_NO_LOGGING);
+        OS_LEAVE_CRITICAL_SECTION();
+}
+#endif
+#endif
+
+static bool screen_cache_evict(void)
+{
+        screen_cache_entry *lru = NULL;
+
+        for (uint8_t i = 0; i < SCREEN_CACHE_ENTRY_NUM; i++) {
+                screen_cache_entry *entry = &cache_entries[i];
+
+                if (entry->screen && entry != active_entry && (lru == NULL || entry->last_use < lru->last_use)) {
+                        lru = entry;
+                }
+        }
+
+        if (lru == NULL) {
+                return false;
+        }
+
+        screen_cache_delete(lru);
+
+        return true;
+}
+
+#if SCREEN_CACHE_PREPARE
+static void screen_cache_prepare_cb(lv_timer_t *timer)
+{
+        screen_cache_entry *next = NULL;
+        lv_mem_monitor_t mon;
+
+        lv_timer_pause(timer);
+
+        for (uint8_t i = 0; i < SCREEN_CACHE_ENTRY_NUM; i++) {
+                screen_cache_entry *entry = &cache_entries[i];
+
+                if (entry->item && (next == NULL || entry->open_count > next->open_count)) {
+                        next = entry;
+                }
+        }
+
+        /* Only build it if no other cached screen has to be deleted for it */
+        if (next == NULL || next->screen || next == active_entry || cache_size + next->size > SCREEN_CACHE_SIZE) {
+                return;
+        }
+#if LV_MEM_CUSTOM == 0
+        lv_mem_monitor(&mon);
+        if (mon.free_size < SCREEN_CACHE_MIN_FREE + next->size) {
+                return;
+        }
+#else
+        LV_UNUSED(mon);
+#endif
+
+        screen_cache_build(next);
+        next->last_use = ++cache_use_count;
+}
+#endif /* SCREEN_CACHE_PREPARE */
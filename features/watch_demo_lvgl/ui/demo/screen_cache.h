@@ -0,0 +1,91 @@
+/**
+ ****************************************************************************************
+ *
+ * @file screen_cache.h
+ *
+ * @brief Screen cache header file
+ *
+ * Copyright (c) 2022 Dialog Semiconductor. All rights reserved.
+ *
+ * This software ("Software") is owned by Dialog Semiconductor. By using this Software
+ * you agree that Dialog Semiconductor retains all intellectual property and proprietary
+ * rights in and to this Software and any use, reproduction, disclosure or distribution
+ * of the Software without express written permission or a license agreement from Dialog
+ * Semiconductor is strictly prohibited. This Software is solely for use on or in
+ * conjunction with Dialog Semiconductor products.
+ *
+ * EXCEPT AS OTHERWISE PROVIDED IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR AS
+ * REQUIRED BY LAW, THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. EXCEPT AS OTHERWISE PROVIDED
+ * IN A LICENSE AGREEMENT BETWEEN THE PARTIES OR BY LAW, IN NO EVENT SHALL DIALOG
+ * SEMICONDUCTOR BE LIABLE FOR ANY DIRECT, SPECIAL, INDIRECT, INCIDENTAL, OR
+ * CONSEQUENTIAL DAMAGES, OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ * ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THE SOFTWARE.
+ *
+ ****************************************************************************************
+ */
+#ifndef SCREEN_CACHE_H_
+#define SCREEN_CACHE_H_
+
+#include "lvgl.h"
+
+/*
+ *      DEFINES
+ *****************************************************************************************
+ */
+/* Bytes of the LVGL heap which screens left by the user may keep, so that they are not built again
+ * the next time they are opened. If 0, screens are deleted when they are left */
+#ifndef SCREEN_CACHE_SIZE
+#define SCREEN_CACHE_SIZE               (6 * 1024)
+#endif
+
+/* Cached screens are deleted, least recently used first, while less LVGL heap than this is free */
+#ifndef SCREEN_CACHE_MIN_FREE
+#define SCREEN_CACHE_MIN_FREE           (2 * 1024)
+#endif
+
+/* Maximum number of screens known to the cache */
+#ifndef SCREEN_CACHE_ENTRY_NUM
+#define SCREEN_CACHE_ENTRY_NUM          (4)
+#endif
+
+/* Build the most often opened screen again while the GUI is idle, if it was deleted */
+#ifndef SCREEN_CACHE_PREPARE
+#define SCREEN_CACHE_PREPARE            (1)
+#endif
+
+/* Duration in msec of the LCDC transition when a screen is shown (cover) or left (uncover).
+ * If 0, screens are loaded without transition */
+#ifndef SCREEN_CACHE_TRANSITION_TIME
+#define SCREEN_CACHE_TRANSITION_TIME    (250)
+#endif
+
+/*
+ *      TYPEDEFS
+ *****************************************************************************************
+ */
+typedef struct
+{
+        const char *name;
+        lv_obj_t *(*create)(void);              /* Build the screen without loading it */
+        void (*enter)(lv_obj_t *screen);        /* Optional, called every time the screen is loaded */
+        void (*leave)(lv_obj_t *screen);        /* Optional, called every time the screen is left */
+}
+screen_cache_item;
+
+/*
+ * GLOBAL PROTOTYPES
+ *****************************************************************************************
+ */
+/* Load the screen of item, built again only if it is not cached */
+void screen_cache_show(const screen_cache_item *item);
+
+/* Go back from the screen shown last to the screen active before it */
+void screen_cache_back(void);
+
+/* Delete every cached screen except the active one */
+void screen_cache_flush(void);
+
+#endif /* SCREEN_CACHE_H_ */
@@ -32,6 +32,7 @@
  */
 #include <stdio.h>
 #include "Resources.h"
+#include "screen_cache.h"
 
 /*
  *      DEFINES
@@ -43,20 +44,24 @@
  *  STATIC PROTOTYPES
  *****************************************************************************************
  */
-static void show_activity_screen();
+static lv_obj_t *create_activity_screen(void);
+static void enter_activity_screen(lv_obj_t *screen);
 static void gesture_event_cb(lv_event_t *e);
 
 /*
  *  STATIC VARIABLES
  *****************************************************************************************
  */
-static lv_obj_t *prev_active;
+static const screen_cache_item activity_screen = {
+        .name = "Activity",
+        .create = create_activity_screen,
+        .enter = enter_activity_screen,
+};
 
 /*
  *      MACROS
  *****************************************************************************************
  */
-LV_IMG_DECLARE(track);
 
 /*
  *   GLOBAL FUNCTIONS
@@ -67,7 +72,7 @@ void show_activity_cb(lv_event_t *e)
         lv_event_code_t code = lv_event_get_code(e);
 
         if (code == LV_EVENT_CLICKED) {
-                show_activity_screen();
+                screen_cache_show(&activity_screen);
         }
 }
 
@@ -75,20 +80,16 @@ void show_activity_cb(lv_event_t *e)
  *   STATIC FUNCTIONS
  *****************************************************************************************
  */
-static void show_activity_screen()
+static lv_obj_t *create_activity_screen(void)
 {
         lv_obj_t *activity_screen_obj, *track_obj;
         lv_obj_t *label_title, *activity_label, *duration_label, *distance_label, *pace_label,
                 *hrate_label, *cadence_label, *stride_label, *consumption_label;
 
-        /* save previously active screen */
-        prev_active = lv_scr_act();
-
         activity_screen_obj = lv_obj_create(NULL);
         lv_obj_set_style_bg_color(activity_screen_obj, lv_color_black(), LV_PART_MAIN);
         lv_obj_set_scrollbar_mode(activity_screen_obj, LV_SCROLLBAR_MODE_OFF);
-        lv_obj_add_event_cb(activity_screen_obj, gesture_event_cb, LV_EVENT_GESTURE,
-                activity_screen_obj);
+        lv_obj_add_event_cb(activity_screen_obj, gesture_event_cb, LV_EVENT_GESTURE, NULL);
         lv_obj_clear_flag(activity_screen_obj, LV_OBJ_FLAG_GESTURE_BUBBLE);
 
         label_title = lv_label_create(activity_screen_obj);
@@ -150,16 +151,22 @@ static void show_activity_screen()
         lv_label_set_text(consumption_label, "#ffffff Consumption\n#ffffff       260 kcal");
         lv_obj_set_pos(consumption_label, 135, 1130);
 
-        lv_scr_load(activity_screen_obj);
+        return activity_screen_obj;
+}
+
+static void enter_activity_screen(lv_obj_t *screen)
+{
+        /* A cached screen is shown from the top again */
+        lv_obj_scroll_to_y(screen, 0, LV_ANIM_OFF);
 }
 
 static void gesture_event_cb(lv_event_t *e)
 {
         lv_dir_t dir = lv_indev_get_gesture_dir(lv_indev_get_act());
-        lv_obj_t *screen_obj = lv_event_get_user_data(e);
+
+        LV_UNUSED(e);
 
         if (dir == LV_DIR_RIGHT) {
-                lv_scr_load(prev_active);
-                lv_obj_del(screen_obj);
+                screen_cache_back();
         }
 }
@@ -32,6 +32,7 @@
  */
 #include <stdio.h>
 #include "Resources.h"
+#include "screen_cache.h"
 
 extern void start_compass_data();
 extern void stop_compass_data();
@@ -40,25 +41,32 @@ extern void stop_compass_data();
  *  STATIC PROTOTYPES
  *****************************************************************************************
  */
-static void show_compass_screen();
+static lv_obj_t *create_compass_screen(void);
+static void enter_compass_screen(lv_obj_t *screen);
+static void leave_compass_screen(lv_obj_t *screen);
 #if COMPASS_ROTATION_USES_CANVAS
 static void compass_delete_event_cb(lv_event_t *e);
 #endif
+static void delete_event_cb(lv_event_t *e);
 static void gesture_event_cb(lv_event_t *e);
 
 /*
  *  STATIC VARIABLES
  *****************************************************************************************
  */
-static lv_obj_t *compass_obj, *compass_txt, *prev_active;
+static lv_obj_t *compass_obj, *compass_txt;
+
+static const screen_cache_item compass_screen = {
+        .name = "Compass",
+        .create = create_compass_screen,
+        .enter = enter_compass_screen,
+        .leave = leave_compass_screen,
+};
 
 /*
  *      MACROS
  *****************************************************************************************
  */
-LV_IMG_DECLARE(compass);
-LV_IMG_DECLARE(compass_earth);
-LV_IMG_DECLARE(compass_index);
 
 /*
  *   GLOBAL FUNCTIONS
@@ -69,7 +77,7 @@ void show_compass_cb(lv_event_t *e)
         lv_event_code_t code = lv_event_get_code(e);
 
         if (code == LV_EVENT_CLICKED) {
-                show_compass_screen();
+                screen_cache_show(&compass_screen);
         }
 }
 
@@ -110,17 +118,14 @@ void compass_rotate(int16_t angle)
  *   STATIC FUNCTIONS
  *****************************************************************************************
  */
-static void show_compass_screen()
+static lv_obj_t *create_compass_screen(void)
 {
         lv_obj_t *compass_screen_obj, *compass_earth_obj, *compass_index_obj;
 
-        /* Save previously active screen */
-        prev_active = lv_scr_act();
-
         compass_screen_obj = lv_obj_create(NULL);
         lv_obj_set_style_bg_color(compass_screen_obj, lv_color_black(), LV_PART_MAIN);
-        lv_obj_add_event_cb(compass_screen_obj, gesture_event_cb, LV_EVENT_GESTURE,
-                compass_screen_obj);
+        lv_obj_add_event_cb(compass_screen_obj, gesture_event_cb, LV_EVENT_GESTURE, NULL);
+        lv_obj_add_event_cb(compass_screen_obj, delete_event_cb, LV_EVENT_DELETE, NULL);
         lv_obj_clear_flag(compass_screen_obj, LV_OBJ_FLAG_GESTURE_BUBBLE);
 
         /* Create the required objects for the compass */
@@ -153,11 +158,23 @@ static void show_compass_screen()
         lv_img_set_src(compass_index_obj, &compass_index);
         lv_obj_set_pos(compass_index_obj, (DEMO_RESX - compass_index.header.w) / 2, 0);
 
-        lv_scr_load(compass_screen_obj);
+        return compass_screen_obj;
+}
+
+static void enter_compass_screen(lv_obj_t *screen)
+{
+        LV_UNUSED(screen);
 
         start_compass_data();
 }
 
+static void leave_compass_screen(lv_obj_t *screen)
+{
+        LV_UNUSED(screen);
+
+        stop_compass_data();
+}
+
 #if COMPASS_ROTATION_USES_CANVAS
 static void compass_delete_event_cb(lv_event_t *e)
 {
@@ -168,14 +185,22 @@ static void compass_delete_event_cb(lv_event_t *e)
 
 #endif
 
+static void delete_event_cb(lv_event_t *e)
+{
+        LV_UNUSED(e);
+
+        /* compass_rotate() may still be called */
+        compass_obj = NULL;
+        compass_txt = NULL;
+}
+
 static void gesture_event_cb(lv_event_t *e)
 {
         lv_dir_t dir = lv_indev_get_gesture_dir(lv_indev_get_act());
-        lv_obj_t *screen_obj = lv_event_get_user_data(e);
+
+        LV_UNUSED(e);
 
         if (dir == LV_DIR_RIGHT) {
-                stop_compass_data();
-                lv_scr_load(prev_active);
-                lv_obj_del(screen_obj);
+                screen_cache_back();
         }
 }
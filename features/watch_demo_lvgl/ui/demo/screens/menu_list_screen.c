@@ -36,6 +36,7 @@
 #include "timer_screen.h"
 #include "activity_screen.h"
 #include "compass_screen.h"
+#include "lv_port_disp.h"
 
 void menu_list_screen(lv_obj_t *parent_obj, lv_style_t *style_screen, lv_coord_t x, lv_coord_t y);
 
@@ -69,13 +70,6 @@ typedef struct
  *      MACROS
  *****************************************************************************************
  */
-LV_IMG_DECLARE(timer);
-LV_IMG_DECLARE(activity);
-LV_IMG_DECLARE(compass_menu_icon);
-LV_IMG_DECLARE(heart_rate);
-LV_IMG_DECLARE(messages);
-LV_IMG_DECLARE(sleep_monitor);
-LV_IMG_DECLARE(weather);
 
 /*
  *  STATIC PROTOTYPES
@@ -85,6 +79,9 @@ static void create_cell(lv_obj_t *obj, lv_obj_t *img_obj, const lv_img_dsc_t img
         char *text, lv_coord_t x, lv_coord_t y);
 static void create_item_text(lv_obj_t *title_obj, const lv_img_dsc_t item_img, lv_coord_t x,
         lv_coord_t y, char *text);
+#if LV_PORT_DISP_VSCROLL_EN
+static void scroll_event_cb(lv_event_t *e);
+#endif
 
 /*
  *  STATIC VARIABLES
@@ -146,6 +143,11 @@ void menu_list_screen(lv_obj_t *parent_obj, lv_style_t *style_screen, lv_coord_t
         lv_obj_set_style_pad_row(menu_list_screen_obj, 0, LV_PART_MAIN);
         lv_obj_set_grid_dsc_array(menu_list_screen_obj, col_dsc, row_dsc);
 
+#if LV_PORT_DISP_VSCROLL_EN
+        /* While browsing only the items scrolled into view are drawn */
+        lv_obj_add_event_cb(menu_list_screen_obj, scroll_event_cb, LV_EVENT_ALL, NULL);
+#endif
+
         item_x = DEMO_RESX / 5;
         item_y = DEMO_RESY / (3 * ITEMS_PER_SCREEN);
 
@@ -195,3 +197,23 @@ static void create_item_text(lv_obj_t *title_obj, const lv_img_dsc_t item_img, l
         lv_obj_set_pos(title_obj, 2 * x,
                 y - (item_img.header.h / 2) + (item_img.header.h - 32) / 2);
 }
+
+#if LV_PORT_DISP_VSCROLL_EN
+static void scroll_event_cb(lv_event_t *e)
+{
+        lv_event_code_t code = lv_event_get_code(e);
+        lv_obj_t *obj = lv_event_get_current_target(e);
+
+        if (lv_event_get_target(e) != obj) {
+                return;
+        }
+
+        if (code == LV_EVENT_SCROLL_BEGIN) {
+                lv_port_disp_vscroll_attach(obj);
+        }
+        else if (code == LV_EVENT_SCROLL_END && !lv_anim_get(obj, NULL)) {
+                /* Not when the list is about to scroll back elastically */
+                lv_port_disp_vscroll_detach();
+        }
+}
+#endif
@@ -32,11 +32,14 @@
  */
 #include <stdio.h>
 #include "Resources.h"
+#include "screen_cache.h"
 /*
  *  STATIC PROTOTYPES
  *****************************************************************************************
  */
-static void show_timer_screen();
+static lv_obj_t *create_timer_screen(void);
+static void leave_timer_screen(lv_obj_t *screen);
+static void delete_event_cb(lv_event_t *e);
 static void gesture_event_cb(lv_event_t *e);
 static void update_timer_cb();
 static void update_timer(uint32_t elapsedTime);
@@ -47,16 +50,20 @@ static void reset_timer_cb(lv_event_t *e);
  *  STATIC VARIABLES
  *****************************************************************************************
  */
-static lv_obj_t *stopwatch_label, *prev_active;
+static lv_obj_t *stopwatch_label, *timer_area_obj;
 static lv_timer_t *counter_timer;
 static uint32_t start_time, total_elapsed_time;
 
+static const screen_cache_item timer_screen = {
+        .name = "Timer",
+        .create = create_timer_screen,
+        .leave = leave_timer_screen,
+};
+
 /*
  *      MACROS
  *****************************************************************************************
  */
-LV_IMG_DECLARE(timer);
-LV_IMG_DECLARE(reset_timer);
 
 /*
  *   GLOBAL FUNCTIONS
@@ -67,7 +74,7 @@ void show_timer_cb(lv_event_t *e)
         lv_event_code_t code = lv_event_get_code(e);
 
         if (code == LV_EVENT_CLICKED) {
-                show_timer_screen();
+                screen_cache_show(&timer_screen);
         }
 }
 
@@ -75,18 +82,16 @@ void show_timer_cb(lv_event_t *e)
  *   STATIC FUNCTIONS
  *****************************************************************************************
  */
-static void show_timer_screen()
+static lv_obj_t *create_timer_screen(void)
 {
-        lv_obj_t *timer_area_obj, *timer_screen_obj, *show_timer_obj, *timer_label, *reset_area_obj, *reset_obj;
+        lv_obj_t *timer_screen_obj, *show_timer_obj, *timer_label, *reset_area_obj, *reset_obj;
         lv_coord_t clickable_w = 100;
         lv_coord_t clickable_h = 100;
 
-        /* save previously active screen */
-        prev_active = lv_scr_act();
-
         timer_screen_obj = lv_obj_create(NULL);
         lv_obj_set_style_bg_color(timer_screen_obj, lv_color_black(), LV_PART_MAIN);
-        lv_obj_add_event_cb(timer_screen_obj, gesture_event_cb, LV_EVENT_GESTURE, timer_screen_obj);
+        lv_obj_add_event_cb(timer_screen_obj, gesture_event_cb, LV_EVENT_GESTURE, NULL);
+        lv_obj_add_event_cb(timer_screen_obj, delete_event_cb, LV_EVENT_DELETE, NULL);
         lv_obj_clear_flag(timer_screen_obj, LV_OBJ_FLAG_GESTURE_BUBBLE);
 
         timer_label = lv_label_create(timer_screen_obj);
@@ -125,21 +130,39 @@ static void show_timer_screen()
         lv_img_set_src(reset_obj, &reset_timer);
         lv_obj_align(reset_obj, LV_ALIGN_CENTER, 0, 0);
 
-        lv_scr_load(timer_screen_obj);
+        return timer_screen_obj;
+}
+
+static void leave_timer_screen(lv_obj_t *screen)
+{
+        LV_UNUSED(screen);
+
+        /* The stopwatch does not run while the screen is not shown */
+        if (!counter_timer->paused) {
+                lv_obj_clear_state(timer_area_obj, LV_STATE_CHECKED);
+                total_elapsed_time = total_elapsed_time + lv_tick_get() - start_time;
+                lv_timer_pause(counter_timer);
+        }
+}
+
+static void delete_event_cb(lv_event_t *e)
+{
+        LV_UNUSED(e);
+
+        lv_timer_del(counter_timer);
+        counter_timer = NULL;
+        stopwatch_label = NULL;
+        timer_area_obj = NULL;
 }
 
 static void gesture_event_cb(lv_event_t *e)
 {
         lv_dir_t dir = lv_indev_get_gesture_dir(lv_indev_get_act());
-        lv_obj_t *screen_obj = lv_event_get_user_data(e);
+
+        LV_UNUSED(e);
 
         if (dir == LV_DIR_RIGHT) {
-                if (counter_timer && !counter_timer->paused) {
-                        lv_timer_pause(counter_timer);
-                }
-                lv_scr_load(prev_active);
-                lv_obj_del(screen_obj);
-                lv_timer_del(counter_timer);
+                screen_cache_back();
         }
 }
 
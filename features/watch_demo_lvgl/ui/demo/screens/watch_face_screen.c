@@ -32,6 +32,8 @@
  */
 #include "Resources.h"
 #include "module.h"
+#include "lv_port_snapshot.h"
+#include "lv_port_disp.h"
 
 /*
  *      DEFINES
@@ -44,6 +46,14 @@
 #define ANGLE_PRECISION_FACTOR  10
 #define TIMER_DIVISOR           10
 
+#ifdef PERFORMANCE_METRICS
+#define TOAST_WIDTH             160
+#define TOAST_HEIGHT            48
+#define TOAST_Y                 40
+#define TOAST_TRAVEL            120
+#define TOAST_TIME_MS           700
+#endif
+
 /*
  *      TYPEDEFS
  *****************************************************************************************
@@ -86,6 +96,10 @@ static void lv_GetTime(RTC_TimeTypeDef *time);
 static void lv_UpdateClock();
 static void lv_DrawClock();
 static void rotate_image(void *img_obj, int32_t angle, const lv_img_dsc_t *img_dsc);
+#ifdef PERFORMANCE_METRICS
+static void toast_move_cb(void *obj, int32_t v);
+static void toast_ready_cb(lv_anim_t *a);
+#endif
 
 /*
  *  STATIC VARIABLES
@@ -94,6 +108,14 @@ static void rotate_image(void *img_obj, int32_t angle, const lv_img_dsc_t *img_d
 static lv_obj_t *tick_hour_obj, *tick_minute_obj, *tick_second_obj;
 static int slice_count;
 static lv_timer_t *update_time_timer;
+#ifdef PERFORMANCE_METRICS
+static lv_obj_t *watch_face_obj;
+#if LV_PORT_DISP_OVERLAY_EN
+static lv_color32_t toast_buf[TOAST_WIDTH * TOAST_HEIGHT];
+static bool toast_overlay;
+static lv_point_t toast_pos;
+#endif
+#endif
 /*
  * RTC defines
  */
@@ -103,11 +125,6 @@ static RTC_TimeTypeDef current_time = { DEFAULT_TIME_HOUR, DEFAULT_TIME_MINUTES,
  *      MACROS
  *****************************************************************************************
  */
-LV_IMG_DECLARE(clock_bg);
-LV_IMG_DECLARE(stamens);
-LV_IMG_DECLARE(tick_hour);
-LV_IMG_DECLARE(tick_minute);
-LV_IMG_DECLARE(tick_second);
 
 /*
  *   GLOBAL FUNCTIONS
@@ -131,7 +148,7 @@ static void event_cb(lv_event_t *e)
 
 void watch_face_screen(lv_obj_t *parent_obj, lv_style_t *style_screen, lv_coord_t x, lv_coord_t y)
 {
-        lv_obj_t *watch_face_screen_obj, *clock_bg_obj, *stamens_obj;
+        lv_obj_t *watch_face_screen_obj, *static_layer_obj, *clock_bg_obj, *stamens_obj;
 
         watch_face_screen_obj = lv_obj_create(parent_obj);
         lv_obj_remove_style_all(watch_face_screen_obj);
@@ -141,8 +158,13 @@ void watch_face_screen(lv_obj_t *parent_obj, lv_style_t *style_screen, lv_coord_
         lv_obj_add_style(watch_face_screen_obj, style_screen, LV_PART_MAIN);
         lv_obj_add_event_cb(watch_face_screen_obj, event_cb, LV_EVENT_ALL, NULL);
 
+        /*The dial does not change, only the needles are drawn on top of its snapshot*/
+        static_layer_obj = lv_port_snapshot_layer_create(watch_face_screen_obj);
+        lv_obj_set_style_bg_color(static_layer_obj, lv_color_black(), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(static_layer_obj, LV_OPA_COVER, LV_PART_MAIN);
+
         /*Create the required objects for the watch*/
-        clock_bg_obj = lv_img_create(watch_face_screen_obj);
+        clock_bg_obj = lv_img_create(static_layer_obj);
         lv_img_set_src(clock_bg_obj, &clock_bg);
         lv_obj_align(clock_bg_obj, LV_ALIGN_CENTER, 0, 0);
 
@@ -164,8 +186,58 @@ void watch_face_screen(lv_obj_t *parent_obj, lv_style_t *style_screen, lv_coord_
         /*Create a timer to update the displayed time*/
         update_time_timer = lv_timer_create(lv_UpdateTime, (uint32_t)(1000 / TIMER_DIVISOR), NULL);
         lv_timer_set_repeat_count(update_time_timer, -1);
+
+#ifdef PERFORMANCE_METRICS
+        watch_face_obj = watch_face_screen_obj;
+#endif
 }
 
+#ifdef PERFORMANCE_METRICS
+/**
+ * @brief  Slide a toast over the watch face and back, drawn by LVGL or moved as an overlay
+ * @param  overlay: move the toast on the second LCDC layer
+ * @retval None
+ */
+void watch_face_toast(bool overlay)
+{
+        lv_obj_t *toast;
+        lv_anim_t a;
+
+        if (!watch_face_obj) {
+                return;
+        }
+
+        toast = lv_label_create(watch_face_obj);
+        lv_label_set_text(toast, "Toast");
+        lv_obj_set_size(toast, TOAST_WIDTH, TOAST_HEIGHT);
+        lv_obj_set_style_bg_color(toast, lv_palette_main(LV_PALETTE_GREY), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(toast, LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_set_style_radius(toast, TOAST_HEIGHT / 2, LV_PART_MAIN);
+        lv_obj_set_style_text_color(toast, lv_color_white(), LV_PART_MAIN);
+        lv_obj_set_style_text_align(toast, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+        lv_obj_set_style_pad_top(toast, (TOAST_HEIGHT - lv_font_get_line_height(LV_FONT_DEFAULT)) / 2, LV_PART_MAIN);
+        lv_obj_align(toast, LV_ALIGN_TOP_MID, 0, TOAST_Y);
+        lv_obj_update_layout(toast);
+
+#if LV_PORT_DISP_OVERLAY_EN
+        /* The watch face below an overlay is neither redrawn nor transferred while it moves */
+        toast_overlay = overlay && lv_port_disp_overlay_attach(toast, toast_buf, sizeof(toast_buf));
+        toast_pos.x = toast->coords.x1;
+        toast_pos.y = toast->coords.y1;
+#endif
+
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, toast);
+        lv_anim_set_values(&a, 0, TOAST_TRAVEL);
+        lv_anim_set_time(&a, TOAST_TIME_MS);
+        lv_anim_set_playback_time(&a, TOAST_TIME_MS);
+        lv_anim_set_path_cb(&a, lv_anim_path_ease_in_out);
+        lv_anim_set_exec_cb(&a, toast_move_cb);
+        lv_anim_set_ready_cb(&a, toast_ready_cb);
+        lv_anim_start(&a);
+}
+#endif
+
 /*
  *   STATIC FUNCTIONS
  *****************************************************************************************
@@ -281,6 +353,25 @@ static void lv_DrawClock()
         angle_sec_prev = angle_sec;
 }
 
+#ifdef PERFORMANCE_METRICS
+static void toast_move_cb(void *obj, int32_t v)
+{
+#if LV_PORT_DISP_OVERLAY_EN
+        if (toast_overlay) {
+                lv_port_disp_overlay_move(toast_pos.x, toast_pos.y + v);
+                return;
+        }
+#endif
+        lv_obj_set_y(obj, TOAST_Y + v);
+}
+
+static void toast_ready_cb(lv_anim_t *a)
+{
+        /* The overlay is detached when the toast is deleted */
+        lv_obj_del(a->var);
+}
+#endif
+
 static void rotate_image(void *img_obj, int32_t angle, const lv_img_dsc_t *img_dsc)
 {
         lv_obj_set_pos(img_obj, (clock_bg.header.w - img_dsc->header.w) / 2, (clock_bg.header.h / 2) - img_dsc->header.h);
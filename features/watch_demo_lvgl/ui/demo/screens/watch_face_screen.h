@@ -41,5 +41,8 @@
  */
 ModuleItem_Typedef watch_face;
 void watch_face_screen(lv_obj_t *parent_obj, lv_style_t *style_screen, lv_coord_t x, lv_coord_t y);
+#ifdef PERFORMANCE_METRICS
+void watch_face_toast(bool overlay);
+#endif
 
 #endif /* UI_DEMO_SCREENS_WATCH_FACE_SCREEN_H_ */
@@ -75,6 +75,9 @@
 #define GDI_FB_RESX             (DEMO_RESX)
 #define GDI_FB_RESY             (DEMO_RESY)
 
+/* Keep the LCDC open while frames follow each other within 50 ms */
+#define GDI_DISPLAY_SESSION_IDLE_MS     (50)
+
 /*
  * \note Printing log messages will adversely affect system's performance
  */
@@ -100,6 +100,19 @@
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD    15      /*[ms]*/
 
+/*Join the invalidated areas by cost: two areas are flushed as one if the rounded joined area costs
+ *less than the two areas plus the `flush_overhead` of the display driver. Overflowing areas are
+ *merged into the cheapest saved area instead of invalidating the whole screen*/
+#define DLG_LVGL_INV_AREA_COST_JOIN 1
+
+/*Allow objects to draw their children out of a snapshot (`LV_OBJ_FLAG_SNAPSHOT`). Invalidating a child
+ *of such an object sends `LV_EVENT_REFRESH` to it, so that it can drop the outdated snapshot*/
+#define DLG_LVGL_SNAPSHOT_LAYER     1
+
+/*Let the display driver take over the invalidation of scrolled objects (`scroll_cb`), e.g. to shift the
+ *drawn frame by hardware and invalidate only the newly exposed area*/
+#define DLG_LVGL_SCROLL_CB          1
+
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
 #define LV_TICK_CUSTOM              1